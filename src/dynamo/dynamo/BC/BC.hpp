@@ -96,6 +96,14 @@ namespace dynamo
     /*! \brief Load the Boundary condition from an XML file. */
     virtual void operator<<(const magnet::xml::Node&) = 0;
 
+    /*! \brief Write any dynamic state of the BoundaryCondition to a binary
+        checkpoint (see Simulation::writeCheckpoint()).
+     */
+    virtual void saveCheckpoint(std::ostream&) const {}
+
+    /*! \brief Restore the state written by saveCheckpoint(). */
+    virtual void loadCheckpoint(std::istream&) {}
+
     /*! \brief A helper for writing BoundaryCondition's to an XmlStream. */
     friend magnet::xml::XmlStream& operator<<(magnet::xml::XmlStream&, const BoundaryCondition&);
 
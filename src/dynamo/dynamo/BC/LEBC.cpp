@@ -17,6 +17,7 @@
 
 #include <dynamo/BC/LEBC.hpp>
 #include <dynamo/simulation.hpp>
+#include <dynamo/checkpoint.hpp>
 #include <magnet/xmlwriter.hpp>
 #include <magnet/xmlreader.hpp>
 #include <cmath>
@@ -110,4 +111,16 @@ namespace dynamo {
   Vector
   BCLeesEdwards::getPeculiarVelocity(const Particle& part) const
   { return part.getVelocity() - getStreamVelocity(part); }
+
+  void
+  BCLeesEdwards::saveCheckpoint(std::ostream& os) const
+  {
+    checkpoint::write(os, _dxd);
+  }
+
+  void
+  BCLeesEdwards::loadCheckpoint(std::istream& is)
+  {
+    checkpoint::read(is, _dxd);
+  }
 }
@@ -42,6 +42,10 @@ namespace dynamo {
 
     virtual void operator<<(const magnet::xml::Node&);
 
+    virtual void saveCheckpoint(std::ostream&) const;
+
+    virtual void loadCheckpoint(std::istream&);
+
     virtual void applyBC(Vector&) const; 
 
     virtual void applyBC(Vector&, Vector&) const;
@@ -0,0 +1,113 @@
+/*  dynamo:- Event driven molecular dynamics simulator 
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <magnet/exception.hpp>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <type_traits>
+
+namespace dynamo {
+  /*! \brief Helper functions for the binary checkpoint format.
+
+    A checkpoint (see Simulation::writeCheckpoint()) is a raw binary
+    dump of the state of the simulation in native byte order. It is
+    only intended to restart a run on the same machine/build, and not
+    for long term storage (use the XML configuration for that).
+
+    Each class writes its state using the functions below. Where a
+    class may or may not be present on restart (e.g., System events),
+    its state is written as a length-prefixed block so that it can be
+    skipped.
+   */
+  namespace checkpoint {
+    template<class T>
+    inline void write(std::ostream& os, const T& val)
+    {
+      static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be written directly");
+      os.write(reinterpret_cast<const char*>(&val), sizeof(T));
+    }
+
+    template<class T>
+    inline void read(std::istream& is, T& val)
+    {
+      static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be read directly");
+      if (!is.read(reinterpret_cast<char*>(&val), sizeof(T)))
+	M_throw() << "Unexpected end of checkpoint data";
+    }
+
+    template<class T>
+    inline void write(std::ostream& os, const std::vector<T>& vec)
+    {
+      write(os, uint64_t(vec.size()));
+      for (const T& val : vec)
+	write(os, val);
+    }
+
+    template<class T>
+    inline void read(std::istream& is, std::vector<T>& vec)
+    {
+      uint64_t size;
+      read(is, size);
+      vec.resize(size);
+      for (T& val : vec)
+	read(is, val);
+    }
+
+    inline void write(std::ostream& os, const std::string& str)
+    {
+      write(os, uint64_t(str.size()));
+      os.write(str.data(), str.size());
+    }
+
+    inline void read(std::istream& is, std::string& str)
+    {
+      uint64_t size;
+      read(is, size);
+      str.resize(size);
+      if (size && !is.read(&str[0], size))
+	M_throw() << "Unexpected end of checkpoint data";
+    }
+
+    /*! \brief Write the checkpoint data of an object as a named,
+        length-prefixed block.
+     */
+    template<class T>
+    inline void writeBlock(std::ostream& os, const std::string& name, const T& obj)
+    {
+      std::ostringstream block;
+      obj.saveCheckpoint(block);
+      write(os, name);
+      write(os, block.str());
+    }
+
+    /*! \brief Read a named block of checkpoint data.
+      
+      \return The name of the block, its data is placed in \p data.
+     */
+    inline std::string readBlock(std::istream& is, std::string& data)
+    {
+      std::string name;
+      read(is, name);
+      read(is, data);
+      return name;
+    }
+  }
+}
@@ -131,14 +131,17 @@ namespace dynamo {
        " Values:\n"
        "  1: \tStandard Engine\n"
        "  2: \tNVT Replica Exchange Engine\n"
-       "  3: \tCompression Engine")
+       "  3: \tCompression Engine\n"
+       "  4: \tDomain Decomposition Engine")
       ;
 
     basicOpts.add(systemopts).add(engineopts);
 
     Engine::getCommonOptions(detailedEngineOpts);
+    ESingleSimulation::getOptions(detailedEngineOpts);
     EReplicaExchangeSimulation::getOptions(detailedEngineOpts);
     ECompressingSimulation::getOptions(detailedEngineOpts);
+    EDomainSimulation::getOptions(detailedEngineOpts);
   
     allopts.add(basicOpts).add(detailedEngineOpts);
 
@@ -185,6 +188,9 @@ namespace dynamo {
       case (3):
 	_engine = shared_ptr<ECompressingSimulation>(new ECompressingSimulation(vm, _threads));
 	break;
+      case (4):
+	_engine = shared_ptr<EDomainSimulation>(new EDomainSimulation(vm, _threads));
+	break;
       default:
 	M_throw() << vm["engine"].as<size_t>()
 		  <<", Unknown Engine Number Selected"; 
@@ -0,0 +1,631 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <dynamo/coordinator/engine/domains.hpp>
+#include <dynamo/coordinator/coordinator.hpp>
+#include <dynamo/BC/PBC.hpp>
+#include <dynamo/NparticleEventData.hpp>
+#include <dynamo/dynamics/dynamics.hpp>
+#include <dynamo/globals/global.hpp>
+#include <dynamo/interactions/interaction.hpp>
+#include <dynamo/outputplugins/outputplugin.hpp>
+#include <dynamo/ranges/IDRangeAll.hpp>
+#include <dynamo/ranges/IDPairRangeAll.hpp>
+#include <dynamo/schedulers/neighbourlist.hpp>
+#include <dynamo/species/species.hpp>
+#include <dynamo/systems/tHalt.hpp>
+#include <magnet/thread/threadpool.hpp>
+#include <stdio.h>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <tuple>
+
+namespace dynamo {
+  namespace {
+    //The tolerance on the event times and velocities of a ghost
+    //particle, as the domains only differ by rounding errors
+    const double tolerance = 1e-8;
+
+    //The limits of the window length in the optimistic mode,
+    //relative to the crossing time of the checked layer
+    const double maxFactor = 8;
+    const double minFactor = 0.125;
+
+    //Silences the screen output while the domains are loaded and run,
+    //as their Simulations are reinitialised in every window
+    struct SilenceOutput
+    {
+      SilenceOutput(): _buffer(std::cout.rdbuf(nullptr)) {}
+      ~SilenceOutput() { std::cout.rdbuf(_buffer); }
+      std::streambuf* _buffer;
+    };
+  }
+
+  //! Records the events of a domain which are counted as events of
+  //! the Simulation, and the particle states after them.
+  class EDomainSimulation::DomainRecorder: public OutputPlugin
+  {
+  public:
+    struct Record
+    {
+      long double time;
+      Event event;
+      NEventData data;
+      size_t count;
+      //! The particles of the L1partChanges, then the pairs of the L2partChanges.
+      std::vector<Particle> states;
+    };
+
+    DomainRecorder(const Simulation* Sim):
+      OutputPlugin(Sim, "DomainRecorder"), _lastCount(0) {}
+
+    virtual void initialise()
+    {
+      records.clear();
+      _lastCount = Sim->eventCount;
+    }
+
+    virtual void eventUpdate(const Event& event, const NEventData& data)
+    {
+      if (Sim->eventCount == _lastCount) return;
+
+      records.push_back(Record{Sim->systemTime, event, data, Sim->eventCount - _lastCount, std::vector<Particle>()});
+      _lastCount = Sim->eventCount;
+
+      std::vector<Particle>& states = records.back().states;
+      for (const ParticleEventData& pdat : data.L1partChanges)
+	states.push_back(Sim->particles[pdat.getParticleID()]);
+
+      for (const PairEventData& pdat : data.L2partChanges)
+	{
+	  states.push_back(Sim->particles[pdat.particle1_.getParticleID()]);
+	  states.push_back(Sim->particles[pdat.particle2_.getParticleID()]);
+	}
+    }
+
+    //! The local ID of the other particle of a pair event, or max if the change is not part of a pair.
+    size_t getPartner(const Record& record, const size_t state) const
+    {
+      const size_t single = record.data.L1partChanges.size();
+      if (state < single) return std::numeric_limits<size_t>::max();
+      return record.states[single + ((state - single) ^ 1)].getID();
+    }
+
+    std::vector<Record> records;
+
+  private:
+    size_t _lastCount;
+  };
+
+  void
+  EDomainSimulation::getOptions(boost::program_options::options_description& opts)
+  {
+    boost::program_options::options_description dopts("Domain Decomposition Engine (--engine=4)");
+
+    dopts.add_options()
+      ("domains", boost::program_options::value<size_t>()->default_value(2),
+       "Number of domains (slabs along the x axis) the system is split into. Each domain is run "
+       "as a task on the thread pool (see --n-threads).")
+      ("domain-ghost", boost::program_options::value<double>()->default_value(2.0),
+       "Width of the checked ghost layer of each domain, in units of the longest interaction "
+       "distance. The full ghost layer is twice as wide.")
+      ("domain-sync", boost::program_options::value<std::string>()->default_value("optimistic"),
+       "How the windows are synchronised: \"optimistic\" grows the windows while they are "
+       "committed and retries a failed window at half the length, \"conservative\" keeps the "
+       "windows within the displacement bound and reruns a failed window serially.")
+      ;
+    opts.add(dopts);
+  }
+
+  EDomainSimulation::EDomainSimulation(const boost::program_options::variables_map& nVM,
+				       magnet::thread::ThreadPool& tp):
+    ESingleSimulation(nVM, tp),
+    _factor(1),
+    _parallelWindows(0),
+    _rollbacks(0),
+    _serialWindows(0)
+  {
+    const std::string sync = vm["domain-sync"].as<std::string>();
+    if ((sync != "optimistic") && (sync != "conservative"))
+      M_throw() << "Unknown domain synchronisation \"" << sync << "\", use \"optimistic\" or \"conservative\"";
+    _optimistic = (sync == "optimistic");
+  }
+
+  EDomainSimulation::~EDomainSimulation() {}
+
+  void
+  EDomainSimulation::postSimInit(Simulation& Sim)
+  {
+    ESingleSimulation::postSimInit(Sim);
+
+    const size_t count = vm["domains"].as<size_t>();
+    if (count < 2)
+      M_throw() << "The domain decomposition engine needs at least two domains";
+
+    const double length = Sim.primaryCellSize[0];
+    _width = length / count;
+    _checkedWidth = vm["domain-ghost"].as<double>() * Sim.getLongestInteraction();
+    _ghostWidth = 2 * _checkedWidth;
+
+    if (_checkedWidth <= Sim.getLongestInteraction())
+      M_throw() << "The checked ghost layer must be wider than the longest interaction distance";
+
+    //The checked layers on either side of a domain must not meet
+    if (_width + 2 * _checkedWidth > length)
+      M_throw() << "The box is too narrow for " << count << " domains with a checked ghost layer of "
+		<< _checkedWidth / Sim.units.unitLength() << ", use fewer domains";
+
+    _owner.resize(Sim.N());
+    _lastEventTime = Sim.systemTime;
+    _nextPrint = Sim.eventCount + Sim.eventPrintInterval;
+
+    SilenceOutput silence;
+    _domains.resize(count);
+    for (size_t ID(0); ID < count; ++ID)
+      {
+	_domains[ID].centre = -0.5 * length + (ID + 0.5) * _width;
+	loadDomain(_domains[ID], false);
+      }
+  }
+
+  void
+  EDomainSimulation::loadDomain(Domain& domain, const bool serial)
+  {
+    domain.sim.reset(new Simulation);
+    Simulation& Sim = *domain.sim;
+    Sim.setRandomSeed(std::random_device()());
+    if (vm.count("random-seed"))
+      Sim.setRandomSeed(vm["random-seed"].as<unsigned int>());
+
+    Sim.loadXMLfile(vm["config-file"].as<std::vector<std::string> >()[0]);
+    Sim.particles.clear();
+
+    if (!Sim.locals.empty() || !Sim.systems.empty() || !Sim.topology.empty() || Sim._properties.size())
+      M_throw() << "The domain decomposition engine does not support Locals, Systems, Topology or per-particle properties";
+
+    for (const shared_ptr<Species>& species : Sim.species)
+      if (!std::dynamic_pointer_cast<IDRangeAll>(species->getRange()))
+	M_throw() << "The domain decomposition engine only supports Species of all particles";
+
+    for (const shared_ptr<Interaction>& interaction : Sim.interactions)
+      if (!std::dynamic_pointer_cast<IDPairRangeAll>(interaction->getRange()))
+	M_throw() << "The domain decomposition engine only supports Interactions between all particles";
+
+    if (!std::dynamic_pointer_cast<SNeighbourList>(Sim.ptrScheduler))
+      M_throw() << "The domain decomposition engine requires the neighbour list Scheduler";
+
+    if (typeid(*Sim.BCs) != typeid(BCPeriodic))
+      M_throw() << "The domain decomposition engine requires periodic boundary conditions";
+
+    if (serial)
+      domain.centre = 0;
+    else if (_width + 2 * _ghostWidth < simulation.primaryCellSize[0])
+      {
+	//The domain is not periodic along the slabs, and the box leaves
+	//room for the ghost particles to move. Otherwise the ghost
+	//layer holds the whole system, which stays periodic.
+	Sim.BCs = shared_ptr<BoundaryCondition>(new BCPeriodicExceptX(&Sim));
+	Sim.primaryCellSize[0] = _width + 2 * _ghostWidth + 2 * _checkedWidth;
+      }
+
+    domain.recorder = shared_ptr<DomainRecorder>(new DomainRecorder(&Sim));
+    Sim.outputPlugins.push_back(domain.recorder);
+    domain.halt = shared_ptr<SystHalt>(new SystHalt(&Sim, std::numeric_limits<double>::infinity(), "DomainWindowEnd"));
+    Sim.systems.push_back(domain.halt);
+    Sim.endEventCount = std::numeric_limits<size_t>::max();
+  }
+
+  void
+  EDomainSimulation::runDomain(Domain& domain, const size_t ID, const long double end)
+  {
+    Simulation& Sim = *domain.sim;
+    const bool serial = (ID >= _domains.size());
+
+    //Reset the streaming of the previous window before the particles
+    //are replaced
+    if (Sim.status == INITIALISED)
+      Sim.dynamics->updateAllParticles();
+
+    Sim.particles.clear();
+    domain.globalID.clear();
+    domain.checked.clear();
+    domain.start.clear();
+    domain.localID.assign(simulation.N(), std::numeric_limits<size_t>::max());
+
+    for (const Particle& part : simulation.particles)
+      {
+	Vector pos = part.getPosition() - Vector{domain.centre, 0, 0};
+	simulation.BCs->applyBC(pos);
+
+	const bool owned = serial || (_owner[part.getID()] == ID);
+	if (!owned && (std::abs(pos[0]) >= 0.5 * _width + _ghostWidth))
+	  continue;
+
+	if (!owned && (std::abs(pos[0]) < 0.5 * _width + _checkedWidth))
+	  domain.checked.push_back(Sim.N());
+
+	domain.localID[part.getID()] = Sim.N();
+	domain.globalID.push_back(part.getID());
+	domain.start.push_back(pos);
+
+	Particle local(pos, part.getVelocity(), Sim.N());
+	if (!part.testState(Particle::DYNAMIC)) local.clearState(Particle::DYNAMIC);
+	if (part.testState(Particle::SLEEPING)) local.setState(Particle::SLEEPING);
+	Sim.particles.push_back(local);
+      }
+
+    Sim.systemTime = simulation.systemTime;
+    Sim.eventCount = 0;
+    Sim.endEventCount = std::numeric_limits<size_t>::max();
+    domain.halt->setdt((end - simulation.systemTime) / Sim.units.unitTime());
+
+    if (Sim.status == INITIALISED)
+      {
+	domain.recorder->initialise();
+	//Reinitialising the neighbour list also rebuilds the event list
+	for (size_t globalID(0); globalID < Sim.globals.size(); ++globalID)
+	  Sim.globals[globalID]->initialise(globalID);
+      }
+    else
+      Sim.initialise();
+
+    while (Sim.runSimulationStep(true)) {}
+    Sim.dynamics->updateAllParticles();
+
+    const std::vector<DomainRecorder::Record>& records = domain.recorder->records;
+    domain.history.assign(Sim.N(), std::vector<std::pair<size_t, size_t> >());
+    for (size_t record(0); record < records.size(); ++record)
+      for (size_t state(0); state < records[record].states.size(); ++state)
+	domain.history[records[record].states[state].getID()].push_back(std::make_pair(record, state));
+
+    domain.maxDisplacement = 0;
+    if (serial) return;
+
+    //The motion is streamed between the events, so an owned particle
+    //is furthest from its start at an event or the end of the window
+    for (size_t localID(0); localID < Sim.N(); ++localID)
+      if (_owner[domain.globalID[localID]] == ID)
+	{
+	  Vector displacement = Sim.particles[localID].getPosition() - domain.start[localID];
+	  Sim.BCs->applyBC(displacement);
+	  domain.maxDisplacement = std::max(domain.maxDisplacement, displacement.nrm());
+
+	  for (const auto& entry : domain.history[localID])
+	    {
+	      displacement = records[entry.first].states[entry.second].getPosition() - domain.start[localID];
+	      Sim.BCs->applyBC(displacement);
+	      domain.maxDisplacement = std::max(domain.maxDisplacement, displacement.nrm());
+	    }
+	}
+  }
+
+  bool
+  EDomainSimulation::sameHistory(const Domain& ghost, const size_t ghostID, const Domain& owner, const size_t ownerID) const
+  {
+    const auto& ghostHistory = ghost.history[ghostID];
+    const auto& ownerHistory = owner.history[ownerID];
+    if (ghostHistory.size() != ownerHistory.size())
+      return false;
+
+    for (size_t i(0); i < ghostHistory.size(); ++i)
+      {
+	const DomainRecorder::Record& ghostRecord = ghost.recorder->records[ghostHistory[i].first];
+	const DomainRecorder::Record& ownerRecord = owner.recorder->records[ownerHistory[i].first];
+
+	if (std::abs(double(ghostRecord.time - ownerRecord.time)) > tolerance * simulation.units.unitTime())
+	  return false;
+
+	const size_t ghostPartner = ghost.recorder->getPartner(ghostRecord, ghostHistory[i].second);
+	const size_t ownerPartner = owner.recorder->getPartner(ownerRecord, ownerHistory[i].second);
+	if ((ghostPartner == std::numeric_limits<size_t>::max()) != (ownerPartner == std::numeric_limits<size_t>::max()))
+	  return false;
+
+	if ((ghostPartner != std::numeric_limits<size_t>::max())
+	    && (ghost.globalID[ghostPartner] != owner.globalID[ownerPartner]))
+	  return false;
+
+	const Vector velocityDifference = ghostRecord.states[ghostHistory[i].second].getVelocity()
+	  - ownerRecord.states[ownerHistory[i].second].getVelocity();
+	if (velocityDifference.nrm() > tolerance * simulation.units.unitVelocity())
+	  return false;
+      }
+
+    return true;
+  }
+
+  bool
+  EDomainSimulation::verifyWindow() const
+  {
+    //A particle can only miss an event with a particle which starts
+    //within the longest interaction distance and the displacements
+    //of both particles of the domain, so these must all be checked
+    double maxDisplacement = 0;
+    for (const Domain& domain : _domains)
+      maxDisplacement = std::max(maxDisplacement, domain.maxDisplacement);
+
+    if (simulation.getLongestInteraction() + 2 * maxDisplacement > _checkedWidth)
+      return false;
+
+    for (const Domain& domain : _domains)
+      for (const size_t localID : domain.checked)
+	{
+	  const size_t globalID = domain.globalID[localID];
+	  const Domain& owner = _domains[_owner[globalID]];
+	  if (!sameHistory(domain, localID, owner, owner.localID[globalID]))
+	    return false;
+	}
+
+    return true;
+  }
+
+  void
+  EDomainSimulation::replayWindow(const std::vector<const Domain*>& domains, const long double end)
+  {
+    //Each event is replayed from the owner of its lowest particle ID
+    std::vector<std::tuple<long double, size_t, size_t> > events;
+    for (size_t ID(0); ID < domains.size(); ++ID)
+      {
+	const std::vector<DomainRecorder::Record>& records = domains[ID]->recorder->records;
+	for (size_t record(0); record < records.size(); ++record)
+	  {
+	    size_t lowestID = std::numeric_limits<size_t>::max();
+	    for (const Particle& state : records[record].states)
+	      lowestID = std::min(lowestID, domains[ID]->globalID[state.getID()]);
+
+	    if ((domains.size() == 1) || (_owner[lowestID] == ID))
+	      events.push_back(std::make_tuple(records[record].time, ID, record));
+	  }
+      }
+
+    std::sort(events.begin(), events.end());
+
+    for (const auto& entry : events)
+      {
+	if (simulation.eventCount >= simulation.endEventCount)
+	  return;
+
+	const Domain& domain = *domains[std::get<1>(entry)];
+	const DomainRecorder::Record& record = domain.recorder->records[std::get<2>(entry)];
+
+	const double dt = record.time - simulation.systemTime;
+	simulation.systemTime = record.time;
+	simulation.stream(dt);
+
+	//Bring the particles to the event, correcting the rounding
+	//of the position in the domain
+	for (const Particle& state : record.states)
+	  {
+	    Particle& part = simulation.particles[domain.globalID[state.getID()]];
+	    simulation.dynamics->updateParticle(part);
+	    Vector correction = state.getPosition() + Vector{domain.centre, 0, 0} - part.getPosition();
+	    simulation.BCs->applyBC(correction);
+	    part.getPosition() += correction;
+	  }
+
+	NEventData data;
+	for (const ParticleEventData& pdat : record.data.L1partChanges)
+	  {
+	    Particle& part = simulation.particles[domain.globalID[pdat.getParticleID()]];
+	    part.getVelocity() = pdat.getOldVel();
+	    ParticleEventData newdat(part, *simulation.species(part), pdat.getType());
+	    newdat.setDeltaU(pdat.getDeltaU());
+	    data += newdat;
+	  }
+
+	for (const PairEventData& pdat : record.data.L2partChanges)
+	  {
+	    Particle& p1 = simulation.particles[domain.globalID[pdat.particle1_.getParticleID()]];
+	    Particle& p2 = simulation.particles[domain.globalID[pdat.particle2_.getParticleID()]];
+	    p1.getVelocity() = pdat.particle1_.getOldVel();
+	    p2.getVelocity() = pdat.particle2_.getOldVel();
+	    PairEventData newdat(p1, p2, *simulation.species(p1), *simulation.species(p2), pdat.getType());
+	    newdat.particle1_.setDeltaU(pdat.particle1_.getDeltaU());
+	    newdat.particle2_.setDeltaU(pdat.particle2_.getDeltaU());
+	    newdat.impulse = pdat.impulse;
+	    newdat.rvdot = pdat.rvdot;
+	    data += newdat;
+	  }
+
+	for (const Particle& state : record.states)
+	  simulation.particles[domain.globalID[state.getID()]].getVelocity() = state.getVelocity();
+
+	Event event = record.event;
+	event._dt = record.time - _lastEventTime;
+	_lastEventTime = record.time;
+	if (event._particle1ID < domain.globalID.size())
+	  event._particle1ID = domain.globalID[event._particle1ID];
+	if (event._source == INTERACTION)
+	  event._particle2ID = domain.globalID[event._particle2ID];
+
+	simulation.eventCount += record.count;
+	simulation._sigParticleUpdate(data);
+	for (shared_ptr<OutputPlugin>& Ptr : simulation.outputPlugins)
+	  Ptr->eventUpdate(event, data);
+
+	if ((simulation.eventCount >= _nextPrint) && !simulation.outputPlugins.empty())
+	  {
+	    for (shared_ptr<OutputPlugin>& Ptr : simulation.outputPlugins)
+	      Ptr->periodicOutput();
+
+	    _nextPrint = simulation.eventCount + simulation.eventPrintInterval;
+	    std::cout << std::endl;
+	  }
+      }
+
+    simulation.stream(end - simulation.systemTime);
+    simulation.systemTime = end;
+  }
+
+  void
+  EDomainSimulation::runSystems()
+  {
+    for (const shared_ptr<System>& system : simulation.systems)
+      if (system->getdt() <= 0)
+	{
+	  Event event = system->getEvent();
+	  const NEventData data = system->runEvent();
+	  if (!data.L1partChanges.empty() || !data.L2partChanges.empty())
+	    {
+	      event._dt = simulation.systemTime - _lastEventTime;
+	      _lastEventTime = simulation.systemTime;
+	      simulation._sigParticleUpdate(data);
+	      for (shared_ptr<OutputPlugin>& Ptr : simulation.outputPlugins)
+		Ptr->eventUpdate(event, data);
+	    }
+	}
+  }
+
+  void
+  EDomainSimulation::runWindow()
+  {
+    //The windows end at the next System event
+    double systemdt = std::numeric_limits<double>::infinity();
+    for (const shared_ptr<System>& system : simulation.systems)
+      systemdt = std::min(systemdt, system->getdt());
+
+    if (systemdt <= 0)
+      {
+	runSystems();
+	return;
+      }
+
+    simulation.dynamics->updateAllParticles();
+
+    double maxSpeed = 0;
+    for (const Particle& part : simulation.particles)
+      maxSpeed = std::max(maxSpeed, part.getVelocity().nrm());
+
+    const double crossingTime = (_checkedWidth - simulation.getLongestInteraction()) / (2 * maxSpeed);
+    const long double end = simulation.systemTime + std::min(systemdt, _factor * crossingTime);
+    if (!std::isfinite(double(end)))
+      M_throw() << "The simulation has run out of events! Aborting!";
+
+    const double length = simulation.primaryCellSize[0];
+    for (const Particle& part : simulation.particles)
+      {
+	Vector pos = part.getPosition();
+	simulation.BCs->applyBC(pos);
+	const long ID = std::floor((pos[0] + 0.5 * length) / _width);
+	_owner[part.getID()] = std::min(size_t(std::max(ID, 0l)), _domains.size() - 1);
+      }
+
+    {
+      SilenceOutput silence;
+      for (size_t ID(0); ID < _domains.size(); ++ID)
+	threads.queueTask(std::bind(&EDomainSimulation::runDomain, this, std::ref(_domains[ID]), ID, end));
+      threads.wait();
+    }
+
+    if (verifyWindow())
+      {
+	++_parallelWindows;
+	std::vector<const Domain*> domains;
+	for (const Domain& domain : _domains)
+	  domains.push_back(&domain);
+	replayWindow(domains, end);
+	if (_optimistic)
+	  _factor = std::min(1.25 * _factor, maxFactor);
+	return;
+      }
+
+    //Nothing has been committed, so the window is rolled back by
+    //trying again
+    ++_rollbacks;
+    if (_optimistic && (_factor > minFactor))
+      {
+	_factor *= 0.5;
+	return;
+      }
+
+    {
+      SilenceOutput silence;
+      if (!_serial.sim)
+	loadDomain(_serial, true);
+      runDomain(_serial, std::numeric_limits<size_t>::max(), end);
+    }
+    ++_serialWindows;
+    replayWindow(std::vector<const Domain*>{&_serial}, end);
+    if (_optimistic)
+      _factor = 1;
+  }
+
+  void
+  EDomainSimulation::runSimulation()
+  {
+    try {
+      while (simulation.eventCount < simulation.endEventCount)
+	{
+	  runWindow();
+
+	  if (_SIGINT)
+	    {
+	      //Clear the writes to screen
+	      std::cout.flush();
+	      std::cerr << "\n<S>hutdown or <P>eek at data output:";
+
+	      char c;
+	      //Clear the input buffer
+	      std::cin.clear();
+	      setvbuf(stdin, NULL, _IONBF, 0);
+	      c=getchar();
+	      setvbuf(stdin, NULL, _IOLBF, BUFSIZ);
+	      switch (c)
+		{
+		case 's':
+		case 'S':
+		  simulation.simShutdown();
+		  break;
+		case 'p':
+		case 'P':
+		  simulation.outputData("peek.data.xml.bz2");
+		  break;
+		}
+
+	      _SIGINT = false;
+	      Coordinator::setup_signal_handler();
+	    }
+	  if (_SIGTERM)
+	    {
+	      _SIGTERM=false;
+	      simulation.simShutdown();
+	    }
+	}
+
+      std::cout << "\nDomain windows: " << _parallelWindows << " parallel, " << _serialWindows
+		<< " serial, " << _rollbacks << " rolled back" << std::endl;
+
+      //The event list of the Simulation is not kept up to date, so it
+      //is rebuilt on restart
+      if (vm.count("checkpoint-file"))
+	simulation.writeCheckpoint(vm["checkpoint-file"].as<std::string>(), false);
+    }
+    catch (std::exception& cep)
+      {
+	try {
+	  std::cerr << "\nEngine: Trying to output config to config.error.xml.bz2, and output to output.error.xml.bz2";
+	  simulation.writeXMLfile("config.error.xml.bz2", !vm.count("unwrapped"));
+          simulation.outputData("output.error.xml.bz2");
+	} catch (...)
+	  {
+	    std::cerr << "\nEngine: Could not write out config/output in error state!";
+	  }
+	throw;
+      }
+  }
+}
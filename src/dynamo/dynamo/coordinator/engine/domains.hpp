@@ -0,0 +1,177 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*! \file domains.hpp
+ * \brief Contains the definition of EDomainSimulation.
+ */
+#pragma once
+
+#include <dynamo/coordinator/engine/single.hpp>
+#include <memory>
+#include <vector>
+
+namespace dynamo {
+  class SystHalt;
+
+  /*! \brief An Engine which splits a single system into spatial
+   * domains, each simulated by its own Scheduler on a thread.
+   *
+   * The primary image is cut into equal slabs along the x axis, and
+   * the system is advanced in time windows. In each window, every
+   * domain runs a Simulation of the particles it owns together with
+   * a ghost layer of the surrounding particles. The events of the
+   * ghost particles near the domain (the inner half of the ghost
+   * layer) are compared against the events their owning domains
+   * found, and no particle may move further than this inner layer
+   * allows. If the window passes these checks, no event of an owned
+   * particle was missed, and the events are replayed in time order
+   * into the Simulation of this engine, which collects the output
+   * data. Otherwise the window is rolled back.
+   *
+   * Hard sphere collision chains have no finite lookahead, so no
+   * window can be guaranteed in advance. The windows are sized from
+   * the time the fastest particle takes to cross the inner ghost
+   * layer. In the optimistic mode the windows grow while they are
+   * committed, and a failed window is retried at half the length. In
+   * the conservative mode the windows keep this length and a failed
+   * window is rerun serially over the whole system.
+   *
+   * The particles are renumbered within each domain, so only
+   * periodic systems whose Species and Interactions apply to all
+   * particles, without Locals, Systems, Topology or per-particle
+   * properties in the configuration, are supported.
+   */
+  class EDomainSimulation: public ESingleSimulation
+  {
+  public:
+    /*! \brief The only constructor.
+     *
+     * \param vm The parsed command line options.
+     * \param tp The thread pool used to run the domains.
+     */
+    EDomainSimulation(const boost::program_options::variables_map& vm,
+		      magnet::thread::ThreadPool& tp);
+
+    /*! \brief Trivial virtual destructor */
+    virtual ~EDomainSimulation();
+
+    /*! \brief The options specific to the EDomainSimulation class.
+     *
+     * This is used by the Coordinator::parseOptions function.
+     *
+     * \param od The options description to add the
+     * EDomainSimulation options to.
+     */
+    static void getOptions(boost::program_options::options_description& od);
+
+    /*! \brief Runs windows until the Simulation ends.
+     *
+     * Interrupts are handled as in ESingleSimulation, at the end
+     * of the current window.
+     */
+    virtual void runSimulation();
+
+    //! The number of windows committed from the domains.
+    size_t getParallelWindows() const { return _parallelWindows; }
+
+    //! The number of windows rolled back.
+    size_t getRollbacks() const { return _rollbacks; }
+
+    //! The number of windows rerun serially.
+    size_t getSerialWindows() const { return _serialWindows; }
+
+  protected:
+    class DomainRecorder;
+
+    /*! \brief The Simulation of one domain (or of the whole system
+        for the serial windows) and its results for the current
+        window.
+     */
+    struct Domain
+    {
+      std::unique_ptr<Simulation> sim;
+      shared_ptr<DomainRecorder> recorder;
+      shared_ptr<SystHalt> halt;
+      //! The x coordinate of the centre of the domain.
+      double centre;
+      //! The global ID of each particle in the domain.
+      std::vector<size_t> globalID;
+      //! The local ID of each particle of the system in the domain.
+      std::vector<size_t> localID;
+      //! The local IDs of the ghost particles which are checked.
+      std::vector<size_t> checked;
+      //! The position of each particle at the start of the window.
+      std::vector<Vector> start;
+      /*! \brief The events of each particle, as the index of the
+          record and of the particle state within the record.
+       */
+      std::vector<std::vector<std::pair<size_t, size_t> > > history;
+      //! The furthest an owned particle moved in the window.
+      double maxDisplacement;
+    };
+
+    /*! \brief Loads the domain Simulations from the configuration
+        file.
+     */
+    virtual void postSimInit(Simulation&);
+
+    //! Loads the Simulation of a domain, checking it is supported.
+    void loadDomain(Domain& domain, bool serial);
+
+    /*! \brief Runs a window on the domain with the passed ID, or on
+        the whole system if the ID is out of range.
+     */
+    void runDomain(Domain& domain, size_t ID, long double end);
+
+    //! Runs one window, rolling it back if it fails.
+    void runWindow();
+
+    //! Tests that the domains computed the events of the window exactly.
+    bool verifyWindow() const;
+
+    //! Tests the histories of a ghost particle and its owner are equal.
+    bool sameHistory(const Domain& ghost, size_t ghostID, const Domain& owner, size_t ownerID) const;
+
+    /*! \brief Replays the events of the owned particles of the
+        domains in time order, until the end of the window or of the
+        Simulation.
+     */
+    void replayWindow(const std::vector<const Domain*>& domains, long double end);
+
+    //! Runs the System events of the Simulation which are due.
+    void runSystems();
+
+    std::vector<Domain> _domains;
+    Domain _serial;
+    //! The domain owning each particle in the current window.
+    std::vector<size_t> _owner;
+    //! The width of the domains.
+    double _width;
+    //! The width of the checked part of the ghost layer.
+    double _checkedWidth;
+    //! The width of the ghost layer.
+    double _ghostWidth;
+    //! The length of the window, relative to the crossing time of the checked layer.
+    double _factor;
+    bool _optimistic;
+    //! The time of the last event passed to the OutputPlugins.
+    long double _lastEventTime;
+    size_t _nextPrint;
+    size_t _parallelWindows;
+    size_t _rollbacks;
+    size_t _serialWindows;
+  };
+}
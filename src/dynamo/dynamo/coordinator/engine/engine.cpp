@@ -89,9 +89,9 @@ namespace dynamo {
   void 
   Engine::setupSim(Simulation& Sim, const std::string filename)
   {
-    Sim.ranGenerator.seed(std::random_device()());
+    Sim.setRandomSeed(std::random_device()());
     if (vm.count("random-seed"))
-      Sim.ranGenerator.seed(vm["random-seed"].as<unsigned int>());
+      Sim.setRandomSeed(vm["random-seed"].as<unsigned int>());
   
     ////////////////////////Simulation Initialisation!!!!!!!!!!!!!
     //Now load the config
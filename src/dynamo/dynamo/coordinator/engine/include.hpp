@@ -18,3 +18,4 @@
 #include <dynamo/coordinator/engine/replexer.hpp>
 #include <dynamo/coordinator/engine/single.hpp>
 #include <dynamo/coordinator/engine/compressor.hpp>
+#include <dynamo/coordinator/engine/domains.hpp>
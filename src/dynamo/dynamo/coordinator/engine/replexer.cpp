@@ -49,6 +49,10 @@ namespace dynamo {
        "  2: \tRandom pair per swap\n"
        "  3: \t5 * Nsim random pairs per swap\n"
        "  4: \tRandom selection of the above methods")
+      ("replex-share-data", 
+       "Share the immutable configuration data (e.g., interaction "
+       "parameter tables, step tables and triangle meshes) of identical "
+       "replicas, so that it is only held in memory once.")
       ;
   
     opts.add(ropts);
@@ -85,6 +89,11 @@ namespace dynamo {
 	if (vm.count("snapshot-events"))
 	  Simulations[i].systems.push_back(shared_ptr<System>(new SysSnapshot(&(Simulations[i]), vm["snapshot-events"].as<size_t>(), "SnapshotEventTimer", "%COUNTe", !vm.count("unwrapped"))));
 
+	//The first simulation is already initialised, so its data can be
+	//shared with the later replicas.
+	if (i && vm.count("replex-share-data"))
+	  Simulations[i].shareImmutableData(Simulations[0]);
+
 	Simulations[i].initialise();
 
 	postSimInit(Simulations[i]);
@@ -22,6 +22,23 @@
 #include <stdio.h>
 
 namespace dynamo {
+  void
+  ESingleSimulation::getOptions(boost::program_options::options_description& opts)
+  {
+    boost::program_options::options_description sopts("Standard Engine (--engine=1)");
+
+    sopts.add_options()
+      ("checkpoint-file", boost::program_options::value<std::string>(),
+       "Write an exact-state binary checkpoint to this file at the end of the run. Restarting "
+       "from it (and the output configuration) replays the run exactly.")
+      ("checkpoint-no-fel", "Don't store the event list in the checkpoint (it is rebuilt on restart).")
+      ("restart", boost::program_options::value<std::string>(),
+       "Restore the exact state of the simulation from a checkpoint written alongside the "
+       "configuration file. The number of events (--events) is counted from the restart.")
+      ;
+    opts.add(sopts);
+  }
+
   ESingleSimulation::ESingleSimulation(const boost::program_options::variables_map& nVM, 
 				       magnet::thread::ThreadPool& tp):
     Engine(nVM, "config.out.xml", "output.xml", tp)
@@ -67,6 +84,11 @@ namespace dynamo {
 	      simulation.simShutdown();
 	    }
 	}
+
+      //This must be written before the configuration is output, as
+      //that updates all of the particles.
+      if (vm.count("checkpoint-file"))
+	simulation.writeCheckpoint(vm["checkpoint-file"].as<std::string>(), !vm.count("checkpoint-no-fel"));
     }
     catch (std::exception& cep)
       {
@@ -104,6 +126,9 @@ namespace dynamo {
     if (vm.count("snapshot-events"))
       simulation.systems.push_back(shared_ptr<System>(new SysSnapshot(&simulation, vm["snapshot-events"].as<size_t>(), "SnapshotEventTimer", "%COUNTe", !vm.count("unwrapped"))));
 
+    if (vm.count("restart"))
+      simulation.loadCheckpoint(vm["restart"].as<std::string>());
+
     simulation.initialise();
 
     postSimInit(simulation);
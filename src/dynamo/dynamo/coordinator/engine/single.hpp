@@ -37,6 +37,11 @@ namespace dynamo {
     ESingleSimulation(const boost::program_options::variables_map& vm, 
 		      magnet::thread::ThreadPool& tp);
 
+    /*! \brief Add the options of this engine (checkpointing) to the
+     * options_description.
+     */
+    static void getOptions(boost::program_options::options_description&);
+
     /*! \brief Trivial virtual destructor */
     virtual ~ESingleSimulation() {}
     
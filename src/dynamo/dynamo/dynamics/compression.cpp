@@ -225,13 +225,13 @@ namespace dynamo {
  
     double mass = Sim->species[tmpDat.getSpeciesID()]->getMass(part.getID());
 
-    std::normal_distribution<> normal_dist;
+    counterRNG rng = Sim->getParticleRNG(part.getID());
     std::uniform_real_distribution<> uniform_dist;
 
     if (slip != 1) {
       std::normal_distribution<> norm_dist;
       for (size_t iDim = 0; iDim < NDIM; iDim++)
-	part.getVelocity()[iDim] = (1-slip) * norm_dist(Sim->ranGenerator) * sqrtT / std::sqrt(mass) + slip * part.getVelocity()[iDim];
+	part.getVelocity()[iDim] = (1-slip) * norm_dist(rng) * sqrtT / std::sqrt(mass) + slip * part.getVelocity()[iDim];
     }
 
 
@@ -239,7 +239,7 @@ namespace dynamo {
 
     part.getVelocity()
       //This first line adds a component in the direction of the normal
-      += vNorm * (sqrtT * sqrt(-2.0*log(1.0 - uniform_dist(Sim->ranGenerator)) / mass)
+      += vNorm * (sqrtT * sqrt(-2.0*log(1.0 - uniform_dist(rng)) / mass)
 		  //This removes the original normal component
 		  - (vij | vNorm))
       ;
@@ -20,6 +20,7 @@
 #include <dynamo/simulation.hpp>
 #include <dynamo/NparticleEventData.hpp>
 #include <dynamo/units/units.hpp>
+#include <dynamo/checkpoint.hpp>
 #include <magnet/xmlwriter.hpp>
 #include <magnet/xmlreader.hpp>
 #include <cstring>
@@ -50,6 +51,24 @@ namespace dynamo {
   }
 
 
+  void
+  Dynamics::saveCheckpoint(std::ostream& os) const
+  {
+    checkpoint::write(os, partPecTime);
+    checkpoint::write(os, uint64_t(streamCount));
+    checkpoint::write(os, orientationData);
+  }
+
+  void
+  Dynamics::loadCheckpoint(std::istream& is)
+  {
+    uint64_t count;
+    checkpoint::read(is, partPecTime);
+    checkpoint::read(is, count);
+    streamCount = count;
+    checkpoint::read(is, orientationData);
+  }
+
   void 
   Dynamics::initialise()
   {
@@ -297,16 +316,16 @@ namespace dynamo {
   
     dout << "Initialising the line orientations" << std::endl;
 
-    std::normal_distribution<> norm_dist;
-    
     for (size_t i = 0; i < Sim->particles.size(); ++i)
       {
+	counterRNG rng = Sim->getParticleRNG(i);
+	std::normal_distribution<> norm_dist;
 	//Assign the new velocities
 	orientationData[i].orientation = Quaternion::identity();
       
 	Vector angVelCrossing;
 	for (size_t iDim = 0; iDim < NDIM; ++iDim)
-	  angVelCrossing[iDim] = norm_dist(Sim->ranGenerator);
+	  angVelCrossing[iDim] = norm_dist(rng);
 	
 	//Ensure the initial angular velocity is perpendicular to the
 	//director
@@ -317,7 +336,7 @@ namespace dynamo {
 	else
 	  {
 	    orientationData[i].angularVelocity = Quaternion::initialDirector() ^ angVelCrossing;
-	    orientationData[i].angularVelocity *= 0.5 * std::sqrt(kbT/I) * norm_dist(Sim->ranGenerator) / orientationData[i].angularVelocity.nrm();
+	    orientationData[i].angularVelocity *= 0.5 * std::sqrt(kbT/I) * norm_dist(rng) / orientationData[i].angularVelocity.nrm();
 	  }
       }
   }
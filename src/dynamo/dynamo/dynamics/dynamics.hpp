@@ -79,6 +79,15 @@ namespace dynamo {
      */
     virtual void replicaExchange(Dynamics& oDynamics) {}
 
+    /*! \brief Write the dynamic state of the Dynamics (the delayed
+        states and orientations) to a binary checkpoint (see
+        Simulation::writeCheckpoint()).
+     */
+    virtual void saveCheckpoint(std::ostream&) const;
+
+    /*! \brief Restore the state written by saveCheckpoint(). */
+    virtual void loadCheckpoint(std::istream&);
+
     /*! \brief Parses the XML data to see if it can load XML particle
       data or if it needs to decode the binary data. Then loads the
       particle data.
@@ -516,11 +525,13 @@ namespace dynamo {
       \param p1 Second particle to test
       \param maxprob The current maximum of the collision radius
       \param rij The vector seperating the two particles.
+      \param uniform A uniform random deviate in [0,1), used to
+      accept/reject the collision.
       \return Whether the collision occurs
      */  
     virtual bool DSMCSpheresTest(Particle& p1, Particle& p2,
 				 double& maxprob, const double& factor,
-				 Vector rij) const = 0;
+				 Vector rij, const double uniform) const = 0;
   
     /*! \brief Performs a hard sphere collision between the two
       particles according to the ESMC (Enskog DSMC)
@@ -25,6 +25,7 @@
 #include <dynamo/globals/ParabolaSentinel.hpp>
 #include <dynamo/units/units.hpp>
 #include <magnet/overlap/point_prism.hpp>
+#include <magnet/intersection/polynomial.hpp>
 #include <magnet/intersection/parabola_sphere.hpp>
 #include <magnet/intersection/parabola_plane.hpp>
 #include <magnet/intersection/parabola_triangle.hpp>
@@ -39,8 +40,12 @@ namespace dynamo {
     DynNewtonian(tmp),
     elasticV(0),
     g({0, -1, 0}),
+    _parabolaSentinel(true),
     _tc(-std::numeric_limits<float>::infinity())
   {
+    if (XML.hasAttribute("NoParabolaSentinel"))
+      _parabolaSentinel = false;
+
     if (XML.hasAttribute("ElasticV"))
       elasticV = XML.getAttribute("ElasticV").as<double>()
 	* Sim->units.unitVelocity();
@@ -62,6 +67,7 @@ namespace dynamo {
     DynNewtonian(tmp), 
     elasticV(eV),
     g(gravity),
+    _parabolaSentinel(true),
     _tc(tc)
   {}
 
@@ -227,6 +233,17 @@ namespace dynamo {
     return magnet::intersection::parabola_plane(rij, vij, g * part.testState(Particle::DYNAMIC), wallNorm, diameter);
   }
 
+  std::pair<double, double>
+  DynGravity::cellWallRoots(const double r, const double v, const double a, const double width)
+  {
+    //The distance inside the lower and upper walls are quadratics in
+    //time. The stable root finder returns the next time each distance
+    //becomes negative while decreasing, without branching on the
+    //direction of the velocity.
+    return std::make_pair(magnet::intersection::detail::nextEvent(magnet::intersection::detail::PolynomialFunction<2>(r, v, a)),
+			  magnet::intersection::detail::nextEvent(magnet::intersection::detail::PolynomialFunction<2>(width - r, -v, -a)));
+  }
+
   double
   DynGravity::getSquareCellCollision2(const Particle& part, 
 					     const Vector & origin, 
@@ -246,7 +263,12 @@ namespace dynamo {
     double retVal = std::numeric_limits<float>::infinity();
 
     for (size_t iDim = 0; iDim < NDIM; ++iDim)
-      if ((g[iDim] != 0) && part.testState(Particle::DYNAMIC))
+      if ((g[iDim] != 0) && part.testState(Particle::DYNAMIC) && !_parabolaSentinel)
+	{
+	  const std::pair<double, double> roots = cellWallRoots(rpos[iDim], vel[iDim], g[iDim], width[iDim]);
+	  retVal = std::min(retVal, std::min(roots.first, roots.second));
+	}
+      else if ((g[iDim] != 0) && part.testState(Particle::DYNAMIC))
 	{
 	  //First check the "upper" boundary that may have no roots
 	  double r = (g[iDim] < 0) ? rpos[iDim] - width[iDim] : rpos[iDim];
@@ -322,7 +344,22 @@ namespace dynamo {
 #endif
 
     for (size_t iDim = 0; iDim < NDIM; ++iDim)
-      if ((g[iDim] != 0) && part.testState(Particle::DYNAMIC))
+      if ((g[iDim] != 0) && part.testState(Particle::DYNAMIC) && !_parabolaSentinel)
+	{
+	  const std::pair<double, double> roots = cellWallRoots(rpos[iDim], vel[iDim], g[iDim], width[iDim]);
+	  if (roots.first < time)
+	    {
+	      time = roots.first;
+	      retVal = -(iDim + 1);
+	    }
+
+	  if (roots.second < time)
+	    {
+	      time = roots.second;
+	      retVal = iDim + 1;
+	    }
+	}
+      else if ((g[iDim] != 0) && part.testState(Particle::DYNAMIC))
 	{
 	  //First check the "upper" boundary that may have no roots
 	  double rdot = (g[iDim] < 0) ? rpos[iDim] - width[iDim]: rpos[iDim];
@@ -394,6 +431,9 @@ namespace dynamo {
     if (_tc > 0)
       XML << magnet::xml::attr("tc") << _tc / Sim->units.unitTime();
 
+    if (!_parabolaSentinel)
+      XML << magnet::xml::attr("NoParabolaSentinel") << "NoParabolaSentinel";
+
     XML << magnet::xml::tag("g") << g / Sim->units.unitAcceleration() << magnet::xml::endtag("g");
   }
 
@@ -454,8 +494,10 @@ namespace dynamo {
   {
     if (_tc > 0) _tcList.resize(Sim->N(), -std::numeric_limits<float>::infinity());
     DynNewtonian::initialise();
-    //This global is needed for neighbourlists to function correctly
-    Sim->globals.push_back(shared_ptr<Global>(new GParabolaSentinel(Sim, "NBListParabolaSentinel")));
+    //This global is needed for neighbourlists to function correctly,
+    //unless the cell transitions are solved robustly across the apex
+    if (_parabolaSentinel)
+      Sim->globals.push_back(shared_ptr<Global>(new GParabolaSentinel(Sim, "NBListParabolaSentinel")));
   }
 
   PairEventData 
@@ -22,6 +22,15 @@
 namespace dynamo {
   /*! \brief A Dynamics which implements standard Newtonian dynamics
     with an additional constant force vector.
+
+    By default a GParabolaSentinel is added to the simulation, which
+    schedules a virtual event at the apex of every parabola. If the
+    NoParabolaSentinel attribute is set, the sentinel is not added
+    and the cell transition times are instead calculated using the
+    stable polynomial root finders (see
+    magnet::intersection::detail::nextEvent) which do not depend on
+    the sign of the velocity and so remain correct across the apex.
+    The sphere and plane root finders are already of this form.
   */
   class DynGravity: public DynNewtonian
   {
@@ -52,9 +61,20 @@ namespace dynamo {
   protected:
     double elasticV;
     Vector g;
+    bool _parabolaSentinel;
     mutable std::vector<long double> _tcList;
     double _tc;
 
     virtual void outputXML(magnet::xml::XmlStream&) const;
+
+    /*! \brief The times until a particle crosses the lower and upper
+      walls of a cell in a single dimension.
+
+      \param r The position of the particle relative to the lower wall.
+      \param v The velocity of the particle.
+      \param a The acceleration of the particle.
+      \param width The width of the cell.
+     */
+    static std::pair<double, double> cellWallRoots(const double r, const double v, const double a, const double width);
   };
 }
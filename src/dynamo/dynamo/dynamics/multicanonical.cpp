@@ -25,19 +25,39 @@
 #include <dynamo/units/units.hpp>
 #include <magnet/xmlwriter.hpp>
 #include <magnet/xmlreader.hpp>
+#include <algorithm>
+#include <limits>
 
 namespace dynamo {
   DynNewtonianMC::DynNewtonianMC(dynamo::Simulation* tmp, const magnet::xml::Node& XML):
     DynNewtonian(tmp),
-    EnergyPotentialStep(1)
+    _WOffset(0),
+    EnergyPotentialStep(1),
+    _extrapolation(ZERO),
+    _WLEnabled(false),
+    _WLFactor(1),
+    _WLFinalFactor(1e-6),
+    _WLFlatness(0.8),
+    _WLCheckInterval(10000),
+    _WLUpdates(0)
   {
     if (XML.hasNode("PotentialDeformation"))
       {
+	const magnet::xml::Node deformation = XML.getNode("PotentialDeformation");
 	EnergyPotentialStep 
-	  = XML.getNode("PotentialDeformation").getAttribute("EnergyStep").as<double>()
+	  = deformation.getAttribute("EnergyStep").as<double>()
 	  / Sim->units.unitEnergy();
 
-	for (magnet::xml::Node node = XML.getNode("PotentialDeformation").findNode("W"); 
+	if (deformation.hasAttribute("Extrapolation"))
+	  {
+	    const std::string extrapolation = deformation.getAttribute("Extrapolation").as<std::string>();
+	    if (extrapolation == "Constant")
+	      _extrapolation = CONSTANT;
+	    else if (extrapolation != "Zero")
+	      M_throw() << "Unknown PotentialDeformation Extrapolation \"" << extrapolation << "\", must be Zero or Constant";
+	  }
+
+	for (magnet::xml::Node node = deformation.findNode("W"); 
 	     node.valid(); ++node)
 	  {
 	    double energy = node.getAttribute("Energy").as<double>() / Sim->units.unitEnergy();	    
@@ -46,32 +66,119 @@ namespace dynamo {
 	    //Here, the Wval needs to be multiplied by kT to turn it
 	    //into an Energy, but the Ensemble is not yet initialised,
 	    //we must do this conversion later, when we actually use the W val.
-	    _W[lrint(energy / EnergyPotentialStep)] = Wval;
+	    _W[getBin(lrint(energy / EnergyPotentialStep))] = Wval;
 	  }
       }
+
+    if (XML.hasNode("WangLandau"))
+      {
+	const magnet::xml::Node WLNode = XML.getNode("WangLandau");
+	_WLEnabled = true;
+
+	if (WLNode.hasAttribute("Factor"))
+	  _WLFactor = WLNode.getAttribute("Factor").as<double>();
+
+	if (WLNode.hasAttribute("FinalFactor"))
+	  _WLFinalFactor = WLNode.getAttribute("FinalFactor").as<double>();
+
+	if (WLNode.hasAttribute("Flatness"))
+	  _WLFlatness = WLNode.getAttribute("Flatness").as<double>();
+
+	if (WLNode.hasAttribute("CheckInterval"))
+	  _WLCheckInterval = WLNode.getAttribute("CheckInterval").as<size_t>();
+
+	if (!_WLCheckInterval)
+	  M_throw() << "The WangLandau CheckInterval must be greater than zero";
+      }
+  }
+
+  size_t
+  DynNewtonianMC::getBin(const long key) const
+  {
+    if (_W.empty())
+      _WOffset = key;
+
+    if (key < _WOffset)
+      {
+	//Extend the table to lower energies
+	const size_t extra = _WOffset - key;
+	_W.insert(_W.begin(), extra, 0.0);
+	_WLHistogram.insert(_WLHistogram.begin(), extra, 0);
+	_WLVisited.insert(_WLVisited.begin(), extra, false);
+	_WOffset = key;
+      }
+
+    const size_t bin = key - _WOffset;
+    if (bin >= _W.size())
+      {
+	_W.resize(bin + 1, 0.0);
+	_WLHistogram.resize(bin + 1, 0);
+	_WLVisited.resize(bin + 1, false);
+      }
+
+    return bin;
+  }
+
+  void
+  DynNewtonianMC::WangLandauUpdate(const double E) const
+  {
+    if (!_WLEnabled || (_WLFactor < _WLFinalFactor))
+      return;
+
+    const size_t bin = getBin(lrint(E / EnergyPotentialStep));
+    _W[bin] += _WLFactor;
+    ++_WLHistogram[bin];
+    _WLVisited[bin] = true;
+
+    if (++_WLUpdates % _WLCheckInterval)
+      return;
+
+    //Test if the histogram of the visited energies is flat
+    size_t minCount(std::numeric_limits<size_t>::max()), total(0), bins(0);
+    for (size_t i(0); i < _W.size(); ++i)
+      if (_WLVisited[i])
+	{
+	  minCount = std::min(minCount, _WLHistogram[i]);
+	  total += _WLHistogram[i];
+	  ++bins;
+	}
+
+    if (minCount >= _WLFlatness * total / bins)
+      {
+	_WLFactor *= 0.5;
+	std::fill(_WLHistogram.begin(), _WLHistogram.end(), 0);
+	dout << "Wang-Landau histogram is flat over " << bins << " energy bins, reducing the modification factor to " << _WLFactor << std::endl;
+      }
   }
 
   void 
   DynNewtonianMC::outputXML(magnet::xml::XmlStream& XML) const
   {
-    std::unordered_map<int, double> wout = _W;
-
     XML << magnet::xml::attr("Type")
 	<< "NewtonianMC"
 	<< magnet::xml::tag("PotentialDeformation")
 	<< magnet::xml::attr("EnergyStep")
 	<< EnergyPotentialStep * Sim->units.unitEnergy();
 
-    typedef std::pair<const int, double> locpair;
+    if (_extrapolation == CONSTANT)
+      XML << magnet::xml::attr("Extrapolation") << "Constant";
 
-    for (const locpair& val : wout)
+    for (size_t i(0); i < _W.size(); ++i)
       XML << magnet::xml::tag("W")
 	  << magnet::xml::attr("Energy")
-	  << val.first * EnergyPotentialStep * Sim->units.unitEnergy()
-	  << magnet::xml::attr("Value") << val.second
+	  << (static_cast<long>(i) + _WOffset) * EnergyPotentialStep * Sim->units.unitEnergy()
+	  << magnet::xml::attr("Value") << _W[i]
 	  << magnet::xml::endtag("W");
     
     XML << magnet::xml::endtag("PotentialDeformation");
+
+    if (_WLEnabled)
+      XML << magnet::xml::tag("WangLandau")
+	  << magnet::xml::attr("Factor") << _WLFactor
+	  << magnet::xml::attr("FinalFactor") << _WLFinalFactor
+	  << magnet::xml::attr("Flatness") << _WLFlatness
+	  << magnet::xml::attr("CheckInterval") << _WLCheckInterval
+	  << magnet::xml::endtag("WangLandau");
   }
 
 
@@ -126,7 +233,8 @@ namespace dynamo {
 
     //Test if the deformed energy change allows a capture event to occur
     double sqrtArg = retVal.rvdot * retVal.rvdot + 2.0 * R2 * MCDeltaKE / mu;
-    if ((MCDeltaKE < 0) && (sqrtArg < 0))
+    const bool bounce = (MCDeltaKE < 0) && (sqrtArg < 0);
+    if (bounce)
       {
 	event._type = BOUNCE;
 	retVal.setType(BOUNCE);
@@ -153,6 +261,8 @@ namespace dynamo {
     //This function must edit particles so it overrides the const!
     particle1.getVelocity() -= retVal.impulse / p1Mass;
     particle2.getVelocity() += retVal.impulse / p2Mass;
+
+    WangLandauUpdate(bounce ? CurrentE : CurrentE - deltaKE);
   
     return retVal;
   }
@@ -168,5 +278,15 @@ namespace dynamo {
 
     std::swap(EnergyPotentialStep, ol.EnergyPotentialStep);
     std::swap(_W, ol._W);
+    std::swap(_WOffset, ol._WOffset);
+    std::swap(_extrapolation, ol._extrapolation);
+    std::swap(_WLEnabled, ol._WLEnabled);
+    std::swap(_WLFactor, ol._WLFactor);
+    std::swap(_WLFinalFactor, ol._WLFinalFactor);
+    std::swap(_WLFlatness, ol._WLFlatness);
+    std::swap(_WLCheckInterval, ol._WLCheckInterval);
+    std::swap(_WLUpdates, ol._WLUpdates);
+    std::swap(_WLHistogram, ol._WLHistogram);
+    std::swap(_WLVisited, ol._WLVisited);
   }
 }
@@ -17,7 +17,8 @@
 
 #pragma once
 #include <dynamo/dynamics/newtonian.hpp>
-#include <unordered_map>
+#include <vector>
+#include <cmath>
 
 namespace dynamo {
   /*! \brief A Dynamics which implements Newtonian dynamics, but with
@@ -55,6 +56,20 @@ namespace dynamo {
    
     \f[ W^{(i+1)}(E) = W^{(i)}(E) + \ln P^{(i)}_{mc}(E) \f]
    
+    The \f$W(E)\f$ function is stored in a dense array of energy
+    bins. Outside of the stored bins, \f$W(E)\f$ is either zero
+    (Extrapolation="Zero", the default) or the value of the nearest
+    stored bin (Extrapolation="Constant").
+
+    Instead of iterating the above equation with separate runs,
+    \f$W(E)\f$ may also be refined during the run using a
+    Wang-Landau style update (enabled by a WangLandau node). At every
+    well event the \f$W(E)\f$ of the resulting energy is increased
+    by the modification factor, f. A histogram of the visited
+    energies is collected, and once it is flat (every bin visited
+    during the updates has at least "Flatness" times the mean count,
+    checked every "CheckInterval" updates) f is halved and the
+    histogram reset. The updates stop once f is below "FinalFactor".
    */
   class DynNewtonianMC: public DynNewtonian
   {
@@ -65,20 +80,25 @@ namespace dynamo {
     virtual NEventData multibdyWellEvent(const IDRange&, const IDRange&, const double&, const double&, EEventType&) const;
     virtual void initialise();
 
-    /*! \brief Returns the \f$W(E)\f$ function.
+    /*! \brief Returns the stored bins of the \f$W(E)\f$ function.
      
-      The lookup is performed by taking the system energy, E, and
+      The bins are indexed by taking the system energy, E, and
       calculating the key like so:
      
       \f[\textrm{key}= \textrm{int}\left[E / \Delta E\right]\f]
      
       where \f$ \Delta E\f$ is the energy step returned from
-      getEnergyStep().
+      getEnergyStep(). The entry i of the table is the bin with key
+      i + getTableOffset().
+     */
+    inline const std::vector<double>& getTable() const { return _W; }
+
+    /*! \brief Returns the key of the first entry of getTable().
      */
-    inline const std::unordered_map<int, double>& getMap() const { return _W; }
+    inline long getTableOffset() const { return _WOffset; }
 
     /*! \brief Returns \f$ \Delta E\f$.
-       \sa getMap()
+       \sa getTable()
      */
     inline const double& getEnergyStep() const { return EnergyPotentialStep; }
 
@@ -86,18 +106,45 @@ namespace dynamo {
      */
     inline double W(double E) const 
     { 
-      std::unordered_map<int, double>::const_iterator 
-	iPtr = _W.find(lrint(E / EnergyPotentialStep));
-      if (iPtr != _W.end())
-	return iPtr->second;
-      return 0;
+      const long index = lrint(E / EnergyPotentialStep) - _WOffset;
+      if ((index >= 0) && (index < static_cast<long>(_W.size())))
+	return _W[index];
+
+      if (_W.empty() || (_extrapolation == ZERO))
+	return 0;
+
+      return (index < 0) ? _W.front() : _W.back();
     }
 
     virtual void replicaExchange(Dynamics& oDynamics);
 
   protected:
     virtual void outputXML(magnet::xml::XmlStream& ) const;
-    std::unordered_map<int, double> _W; 
+
+    //! \brief Returns the index of the bin of a key, extending the table if required.
+    size_t getBin(long key) const;
+
+    //! \brief Performs a Wang-Landau update at the energy E.
+    void WangLandauUpdate(double E) const;
+
+    enum Extrapolation { ZERO, CONSTANT };
+
+    //! The W(E) of each bin (mutable as it grows during Wang-Landau updates).
+    mutable std::vector<double> _W; 
+    //! The key of the first bin of _W.
+    mutable long _WOffset;
     double EnergyPotentialStep;
+    Extrapolation _extrapolation;
+
+    bool _WLEnabled;
+    mutable double _WLFactor;
+    double _WLFinalFactor;
+    double _WLFlatness;
+    size_t _WLCheckInterval;
+    mutable size_t _WLUpdates;
+    //! The histogram of visits to each bin of _W during this stage of the updates.
+    mutable std::vector<size_t> _WLHistogram;
+    //! If each bin of _W has been visited at any stage of the updates.
+    mutable std::vector<bool> _WLVisited;
   };
 }
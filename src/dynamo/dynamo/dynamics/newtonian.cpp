@@ -119,10 +119,11 @@ namespace dynamo {
     double mass = Sim->species[tmpDat.getSpeciesID()]->getMass(part.getID());
     double factor = sqrtT / std::sqrt(mass);
 
+    counterRNG rng = Sim->getParticleRNG(part.getID());
     std::normal_distribution<> norm_dist;
     //Assign the new velocities
     for (size_t iDim = 0; iDim < dimensions; iDim++)
-      part.getVelocity()[iDim] = norm_dist(Sim->ranGenerator) * factor;
+      part.getVelocity()[iDim] = norm_dist(rng) * factor;
 
     return tmpDat;
   }
@@ -245,17 +246,18 @@ namespace dynamo {
     ParticleEventData tmpDat(part, *Sim->species(part), WALL);
  
     double mass = Sim->species[tmpDat.getSpeciesID()]->getMass(part.getID());
+    counterRNG rng = Sim->getParticleRNG(part.getID());
 
     if (slip != 1) {
       std::normal_distribution<> norm_dist;
       for (size_t iDim = 0; iDim < NDIM; iDim++)
-	part.getVelocity()[iDim] = (1-slip) * norm_dist(Sim->ranGenerator) * sqrtT / std::sqrt(mass) + slip * part.getVelocity()[iDim];
+	part.getVelocity()[iDim] = (1-slip) * norm_dist(rng) * sqrtT / std::sqrt(mass) + slip * part.getVelocity()[iDim];
     }
   
     std::uniform_real_distribution<> uniform_dist;
     part.getVelocity() 
       //This first line adds a component in the direction of the normal
-      += vNorm * (sqrtT * sqrt(-2.0*log(1.0-uniform_dist(Sim->ranGenerator)) / mass)
+      += vNorm * (sqrtT * sqrt(-2.0*log(1.0-uniform_dist(rng)) / mass)
 		  //This removes the original normal component
 		  -(part.getVelocity() | vNorm));
 
@@ -325,7 +327,7 @@ namespace dynamo {
   }
 
   bool 
-  DynNewtonian::DSMCSpheresTest(Particle& p1, Particle& p2, double& maxprob, const double& factor, Vector rij) const
+  DynNewtonian::DSMCSpheresTest(Particle& p1, Particle& p2, double& maxprob, const double& factor, Vector rij, const double uniform) const
   {
     updateParticlePair(Sim->particles[p1.getID()], Sim->particles[p2.getID()]);
 
@@ -343,8 +345,7 @@ namespace dynamo {
     if (prob > maxprob)
       maxprob = prob;
 
-    std::uniform_real_distribution<> uniform_dist;
-    return prob > uniform_dist(Sim->ranGenerator) * maxprob;
+    return prob > uniform * maxprob;
   }
 
   PairEventData
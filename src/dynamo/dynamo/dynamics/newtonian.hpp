@@ -48,7 +48,7 @@ namespace dynamo {
     virtual ParticleEventData runOscilatingPlate(Particle& part, const Vector& rw0, const Vector& nhat, double& delta, const double& omega0, const double& sigma, const double& mass, const double& e, double& t, bool strongPlate) const;
     virtual double getPBCSentinelTime(const Particle&, const double&) const;
     virtual PairEventData SmoothSpheresColl(Event&, const double&, const double&, const EEventType& eType) const;
-    virtual bool DSMCSpheresTest(Particle&, Particle&, double&, const double&, Vector) const;
+    virtual bool DSMCSpheresTest(Particle&, Particle&, double&, const double&, Vector, const double) const;
     virtual PairEventData DSMCSpheresRun(Particle&, Particle&, const double&, Vector) const;
     virtual PairEventData SphereWellEvent(Event&, const double&, const double&, size_t) const;
     virtual double getPlaneEvent(const Particle&, const Vector &, const Vector &, double) const;
@@ -24,9 +24,12 @@
 #include <dynamo/BC/LEBC.hpp>
 #include <dynamo/ranges/IDRangeList.hpp>
 #include <dynamo/dynamics/compression.hpp>
+#include <dynamo/interactions/hardsphere.hpp>
+#include <dynamo/checkpoint.hpp>
 #include <magnet/xmlwriter.hpp>
 #include <magnet/xmlreader.hpp>
 #include <cstdio>
+#include <cmath>
 #include <set>
 #include <algorithm>
 
@@ -35,7 +38,15 @@ namespace dynamo {
     GNeighbourList(nSim, "CellNeighbourList"),
     _cellDimension({1,1,1}),
     _inConfig(true),
-    overlink(1)
+    overlink(1),
+    _gridGeneration(0),
+    _burialDiameter(0),
+    _cellWidth(0),
+    _autoTune(false),
+    _tuneWindow(0),
+    _tuneCellEvents(0),
+    _tuneScans(0),
+    _tuneScanned(0)
   {
     globName = name;
     dout << "Cells Loaded" << std::endl;
@@ -45,7 +56,15 @@ namespace dynamo {
     GNeighbourList(ptrSim, "CellNeighbourList"),
     _cellDimension({1,1,1}),
     _inConfig(true),
-    overlink(1)
+    overlink(1),
+    _gridGeneration(0),
+    _burialDiameter(0),
+    _cellWidth(0),
+    _autoTune(false),
+    _tuneWindow(0),
+    _tuneCellEvents(0),
+    _tuneScans(0),
+    _tuneScanned(0)
   {
     operator<<(XML);
 
@@ -60,6 +79,12 @@ namespace dynamo {
     
     if (XML.hasAttribute("NeighbourhoodRange"))
       _maxInteractionRange = XML.getAttribute("NeighbourhoodRange").as<double>() * Sim->units.unitLength();
+
+    if (XML.hasAttribute("CellWidth"))
+      _cellWidth = XML.getAttribute("CellWidth").as<double>() * Sim->units.unitLength();
+
+    if (XML.hasAttribute("AutoTune"))
+      _autoTune = true;
     
     globName = XML.getAttribute("Name");
     
@@ -77,7 +102,7 @@ namespace dynamo {
     //Sim->dynamics->updateParticle(part); is not required as we
     //compensate for the delay using
     //Sim->dynamics->getParticleDelay(part)
-    return Event(part, Sim->dynamics->getSquareCellCollision2(part, calcPosition(_cellData.getCellID(part.getID()), part), _cellDimension) - Sim->dynamics->getParticleDelay(part), GLOBAL, CELL, ID);
+    return Event(part, Sim->dynamics->getSquareCellCollision2(part, calcPosition(_cellData.getCellID(part.getID()), part), _cellDimension) - Sim->dynamics->getParticleDelay(part), GLOBAL, CELL, ID, std::numeric_limits<size_t>::max(), _gridGeneration);
   }
 
   void
@@ -105,24 +130,128 @@ namespace dynamo {
     newCellCoord[cellDirection] += _ordering.getDimensions()[cellDirection] + ((cellDirectionInt > 0) ? 1 : -1);
     newCellCoord[cellDirection] %= _ordering.getDimensions()[cellDirection];
 
-    _cellData.moveTo(oldCellIndex, _ordering.toIndex(newCellCoord), part.getID());
+    moveParticle(oldCellIndex, _ordering.toIndex(newCellCoord), part.getID());
 
     //Particle has just arrived into a new cell, check the new
-    //neighbours for particles
+    //neighbours for particles. The new face of the neighbourhood is
+    //overlink cells ahead of the new cell.
     auto newCenterNBCellCoord = newCellCoord;
-    newCenterNBCellCoord[cellDirection] += _ordering.getDimensions()[cellDirection] + ((cellDirectionInt > 0) ? 1 : -1);
+    newCenterNBCellCoord[cellDirection] += _ordering.getDimensions()[cellDirection] + ((cellDirectionInt > 0) ? overlink : -overlink);
     newCenterNBCellCoord[cellDirection] %= _ordering.getDimensions()[cellDirection];
     std::array<size_t, 3> steps{{overlink, overlink, overlink}};
     steps[cellDirection] = 0;
 
+    //The buried sleeping particles cannot be reached
     for (auto cellIndex : _ordering.getSurroundingIndices(newCenterNBCellCoord, steps))
-      for (const size_t& next : _cellData.getCellContents(cellIndex))
-	_sigNewNeighbour(part, next);
+      if (_exposedCount[cellIndex])
+	for (const size_t& next : _cellData.getCellContents(cellIndex))
+	  if (!_buried[next])
+	    _sigNewNeighbour(part, next);
   
     //Push the next virtual event, this is the reason the scheduler
     //doesn't need a second callback
     Sim->ptrScheduler->pushEvent(getEvent(part));
     _sigCellChange(part, oldCellIndex);
+
+    if (_autoTune)
+      {
+	//The window starts at the first cell event after the grid is
+	//built, so the scans of the full rebuild are not counted
+	if (!_tuneCellEvents)
+	  _tuneScans = _tuneScanned = 0;
+
+	++_tuneCellEvents;
+	if (_tuneScans >= _tuneWindow)
+	  autoTune();
+      }
+  }
+
+  void
+  GCells::countScan(const size_t scanned) const
+  {
+    if (!_autoTune) return;
+    _tuneScans.fetch_add(1, std::memory_order_relaxed);
+    _tuneScanned.fetch_add(scanned, std::memory_order_relaxed);
+  }
+
+  void
+  GCells::autoTune()
+  {
+    const size_t scans = _tuneScans;
+    const double cellEvents = _tuneCellEvents;
+    const double meanScanned = scans ? double(_tuneScanned) / scans : 0;
+    _tuneCellEvents = _tuneScans = _tuneScanned = 0;
+    if (!scans) return;
+
+    //The cost of a cell event, excluding the neighbours it tests, in
+    //units of a neighbour test
+    const double cellEventCost = 4;
+    const double cellRate = cellEvents / scans;
+    const double width = std::cbrt(_cellLatticeWidth[0] * _cellLatticeWidth[1] * _cellLatticeWidth[2]);
+    const double span = (2 * overlink + 1) * width;
+
+    //The width of the (overlapping) cells for a lattice width w
+    const double overlap = cellOverlap();
+    const auto cellDimension = [&](const double w) { return w + (w - _maxInteractionRange) * overlap; };
+
+    //The cost per neighbour scan, in neighbour tests, of a grid with
+    //overlink o and cell width w. The neighbours scanned scale with
+    //the volume of the neighbourhood and the cell events scale with
+    //the inverse of the cell dimension. A cell event tests the new
+    //face of the neighbourhood.
+    const auto cost = [&](const size_t o, const double w) {
+      const double scanned = meanScanned * std::pow((2 * o + 1) * w / span, 3);
+      return scanned + cellRate * (cellDimension(width) / cellDimension(w)) * (cellEventCost + scanned / (2 * o + 1));
+    };
+
+    const double currentCost = cost(overlink, width);
+    size_t bestOverlink = overlink;
+    double bestWidth = width;
+    double bestCost = currentCost;
+
+    const double systemWidth = std::min(Sim->primaryCellSize[0], std::min(Sim->primaryCellSize[1], Sim->primaryCellSize[2]));
+    const size_t maxOverlink = 4, samples = 32;
+    for (size_t o(1); o <= maxOverlink; ++o)
+      {
+	//The same limits as regrid() places on the cell count
+	const double minWidth = _maxInteractionRange / o;
+	const double maxWidth = systemWidth / std::max(size_t(4), 2 * o + 1);
+	if (maxWidth < minWidth) continue;
+
+	for (size_t i(0); i <= samples; ++i)
+	  {
+	    const double w = minWidth * std::pow(maxWidth / minWidth, double(i) / samples);
+	    //The cells must not overlap so much that they vanish or no
+	    //longer support the interaction range
+	    if ((cellDimension(w) <= 0) || ((1 + o) * w - cellDimension(w) < _maxInteractionRange))
+	      continue;
+
+	    const double c = cost(o, w);
+	    if (c < bestCost)
+	      {
+		bestCost = c;
+		bestOverlink = o;
+		bestWidth = w;
+	      }
+	  }
+      }
+
+    dout << "Auto-tuning on collision " << Sim->eventCount
+	 << "\nCell events per neighbour scan " << cellRate
+	 << "\nMean neighbours scanned " << meanScanned
+	 << "\nOverlink " << overlink << ", cell width " << width / Sim->units.unitLength()
+	 << ", cost " << currentCost
+	 << "\nBest overlink " << bestOverlink << ", cell width " << bestWidth / Sim->units.unitLength()
+	 << ", cost " << bestCost << std::endl;
+
+    if (bestCost > 0.8 * currentCost)
+      return;
+
+    dout << "Retuning the cells, the next evaluation is in " << 2 * _tuneWindow << " neighbour scans" << std::endl;
+    overlink = bestOverlink;
+    _cellWidth = bestWidth;
+    _tuneWindow *= 2;
+    reinitialise();
   }
 
   void 
@@ -138,6 +267,78 @@ namespace dynamo {
     GNeighbourList::reinitialise();
       
     dout << "Reinitialising on collision " << Sim->eventCount << std::endl;
+    regrid();
+    _sigReInitialise();
+  }
+
+  void
+  GCells::growMaxInteractionRange(double newRange)
+  {
+    //Before the first build there are no events to keep, and a
+    //shrinking neighbourhood loses pairs which might still interact
+    if (!_initialised || (newRange < _maxInteractionRange))
+      {
+	setMaxInteractionRange(newRange);
+	return;
+      }
+
+    dout << "Rebinning the particles on collision " << Sim->eventCount << std::endl;
+
+    //Only the old cell of each particle is stored, the old
+    //neighbourhoods are reconstructed from the old grid when needed
+    std::vector<size_t> oldCell(Sim->N(), 0);
+    for (const size_t pid : *range)
+      oldCell[pid] = _cellData.getCellID(pid);
+    const Ordering oldOrdering = _ordering;
+
+    _maxInteractionRange = newRange;
+    regrid();
+
+    //The cell events of the old grid are now rejected by
+    //isEventValid(), so each particle needs a new one. Only the pairs
+    //which have entered the neighbourhood need events, the events of
+    //the old neighbours remain valid.
+    ++_gridGeneration;
+    std::vector<size_t> neighbours;
+    for (const size_t pid : *range)
+      {
+	const Particle& part = Sim->particles[pid];
+	neighbours.clear();
+	getParticleNeighbours(part, neighbours);
+	const std::array<size_t, 3> coords = oldOrdering.toCoord(oldCell[pid]);
+	for (const size_t id2 : neighbours)
+	  if (!isOldNeighbour(oldOrdering, coords, oldCell[id2]))
+	    _sigNewNeighbour(part, id2);
+
+	Sim->ptrScheduler->pushEvent(getEvent(part));
+      }
+  }
+
+  bool
+  GCells::isOldNeighbour(const Ordering& oldOrdering, const std::array<size_t, 3>& coords, const size_t cellID2) const
+  {
+    //A cell is in the (periodic) neighbourhood template if it is
+    //within overlink cells in each dimension. The grid always holds
+    //at least one full template, so the template does not overlap
+    //itself.
+    const std::array<size_t, 3> coords2 = oldOrdering.toCoord(cellID2);
+    for (size_t iDim = 0; iDim < NDIM; ++iDim)
+      {
+	const size_t count = oldOrdering.getDimensions()[iDim];
+	const size_t separation = (coords2[iDim] + count - coords[iDim]) % count;
+	if ((separation > overlink) && (separation < count - overlink))
+	  return false;
+      }
+    return true;
+  }
+
+  void
+  GCells::regrid()
+  {
+    //The tuning statistics of the old grid do not apply to the new one
+    _tuneCellEvents = _tuneScans = _tuneScanned = 0;
+    if (!_tuneWindow)
+      _tuneWindow = 10 * Sim->N();
 
     //This is the minimium cell size, based on the two-particle Interaction range
     const double minDistance = _maxInteractionRange / overlink;
@@ -150,6 +351,12 @@ namespace dynamo {
     //Choose the largest cell size we can from the two choices so far
     double l = std::max(minDistance, unityOccupancy);
 
+    if (_cellWidth)
+      {
+	dout << "Requested cell diameter " << _cellWidth / Sim->units.unitLength() << std::endl;
+	l = std::max(minDistance, _cellWidth);
+      }
+
     std::array<size_t, 3> cellCount;
     const double embiggen = 1.0 + 10 * std::numeric_limits<double>::epsilon();
 
@@ -169,7 +376,6 @@ namespace dynamo {
     dout << "Target cell width use after taking into account system size = " << l << std::endl;
 
     addCells(cellCount);
-    _sigReInitialise();
   }
 
   void
@@ -183,15 +389,25 @@ namespace dynamo {
 	<< _maxInteractionRange / Sim->units.unitLength();
     
     if (overlink > 1)   XML << magnet::xml::attr("OverLink") << overlink;
+
+    if (_cellWidth) XML << magnet::xml::attr("CellWidth") << _cellWidth / Sim->units.unitLength();
+
+    if (_autoTune) XML << magnet::xml::attr("AutoTune") << "AutoTune";
     
     XML << range
 	<< magnet::xml::endtag("Global");
   }
 
+  double
+  GCells::cellOverlap() const
+  {
+    return (std::dynamic_pointer_cast<DynCompression>(Sim->dynamics)) ? 0.001 : 0.9;
+  }
+
   void GCells::addCells(std::array<size_t, 3> cellCount)
   {
     const double maxdiam = _maxInteractionRange;
-    const double overlap = (std::dynamic_pointer_cast<DynCompression>(Sim->dynamics)) ? 0.001 : 0.9;
+    const double overlap = cellOverlap();
     for (size_t iDim = 0; iDim < NDIM; iDim++)
       {
 	_cellLatticeWidth[iDim] = Sim->primaryCellSize[iDim] / cellCount[iDim];
@@ -240,6 +456,292 @@ namespace dynamo {
 	Particle& p = Sim->particles[pid];
 	_cellData.add(_ordering.toIndex(getCellCoords(p.getPosition())), pid);
       }
+
+    countAwake();
+    Sim->_sigParticleUpdate.connect<GCells, &GCells::particlesUpdated>(this);
+  }
+
+  void
+  GCells::countAwake()
+  {
+    _awakeCount.assign(_ordering.length(), 0);
+    _sleeping.assign(Sim->N(), false);
+    for (const size_t pid : *range)
+      {
+	_sleeping[pid] = Sim->particles[pid].testState(Particle::SLEEPING);
+	if (!_sleeping[pid])
+	  ++_awakeCount[_cellData.getCellID(pid)];
+      }
+
+    //The burial of each sleeping particle needs all of the sleeping
+    //states, so it is found in a second pass
+    _burialDiameter = getBurialDiameter();
+    _buried.assign(Sim->N(), false);
+    _exposedCount.assign(_ordering.length(), 0);
+    for (const size_t pid : *range)
+      {
+	_buried[pid] = _sleeping[pid] && testBuried(pid);
+	if (!_buried[pid])
+	  ++_exposedCount[_cellData.getCellID(pid)];
+      }
+  }
+
+  double
+  GCells::getBurialDiameter() const
+  {
+    //The diameters of the particles grow under compression
+    if (std::dynamic_pointer_cast<DynCompression>(Sim->dynamics))
+      return 0;
+
+    double diameter = 0;
+    for (const shared_ptr<Interaction>& interaction : Sim->interactions)
+      {
+	const IHardSphere* hs = dynamic_cast<const IHardSphere*>(interaction.get());
+	if (!hs || (hs->minIntDist() != hs->maxIntDist()) || (diameter && (diameter != hs->maxIntDist())))
+	  return 0;
+	diameter = hs->maxIntDist();
+      }
+    return diameter;
+  }
+
+  namespace {
+    /*! \brief A spherical cap of the unit sphere, holding the
+        directions n where n | axis > cosine.
+     */
+    struct Cap
+    {
+      Vector axis;
+      double cosine;
+    };
+
+    /*! \brief Test if the boundary circle of a cap is covered by the
+        other (open) caps.
+
+      Each other cap covers an arc of the circle, which are swept in
+      order around the circle looking for a gap.
+     */
+    bool circleCovered(const std::vector<Cap>& caps, const size_t i)
+    {
+      const Cap& cap = caps[i];
+      const double sine = std::sqrt(1 - cap.cosine * cap.cosine);
+
+      //An orthonormal basis of the plane of the circle
+      Vector e1 = (std::abs(cap.axis[0]) < 0.9) ? Vector{1, 0, 0} : Vector{0, 1, 0};
+      e1 -= cap.axis * (e1 | cap.axis);
+      e1 /= e1.nrm();
+      const Vector e2 = cap.axis ^ e1;
+
+      //The point at angle phi of the circle is inside cap j if
+      //a cos(phi) + b sin(phi) > k
+      std::vector<std::pair<double, double> > arcs;
+      arcs.reserve(2 * caps.size());
+      for (size_t j(0); j < caps.size(); ++j)
+	if (j != i)
+	  {
+	    const double a = sine * (e1 | caps[j].axis);
+	    const double b = sine * (e2 | caps[j].axis);
+	    const double k = caps[j].cosine - cap.cosine * (cap.axis | caps[j].axis);
+	    const double amplitude = std::sqrt(a * a + b * b);
+
+	    if (k < -amplitude) return true;
+	    if (k >= amplitude) continue;
+
+	    const double halfWidth = std::acos(k / amplitude);
+	    double start = std::fmod(std::atan2(b, a) - halfWidth, 2 * M_PI);
+	    if (start < 0) start += 2 * M_PI;
+	    //Arcs which wrap past zero are also added a turn earlier
+	    arcs.push_back(std::make_pair(start, start + 2 * halfWidth));
+	    arcs.push_back(std::make_pair(start - 2 * M_PI, start + 2 * halfWidth - 2 * M_PI));
+	  }
+
+      std::sort(arcs.begin(), arcs.end());
+      double reach = 0;
+      for (const std::pair<double, double>& arc : arcs)
+	{
+	  if (arc.first >= reach) return false;
+	  reach = std::max(reach, arc.second);
+	  if (reach >= 2 * M_PI) return true;
+	}
+      return false;
+    }
+  }
+
+  bool
+  GCells::testBuried(const size_t ID) const
+  {
+    if (!_burialDiameter) return false;
+
+    //An awake particle must touch the sphere of contact around the
+    //particle to reach it, but cannot enter the other sleeping
+    //particles. Each sleeping particle covers a cap of the sphere,
+    //which is shrunk slightly so that rounding errors in the contact
+    //distances cannot expose the particle.
+    const double margin = 1e-6;
+    const Particle& part = Sim->particles[ID];
+    std::vector<size_t> neighbours;
+    getParticleNeighbours(_ordering.toCoord(_cellData.getCellID(ID)), neighbours);
+
+    std::vector<Cap> caps;
+    for (const size_t id2 : neighbours)
+      if ((id2 != ID) && _sleeping[id2])
+	{
+	  Vector rij = Sim->particles[id2].getPosition() - part.getPosition();
+	  Sim->BCs->applyBC(rij);
+	  const double distance = rij.nrm();
+	  const double cosine = 0.5 * distance / _burialDiameter + margin;
+	  if (cosine < 1)
+	    caps.push_back(Cap{rij / distance, cosine});
+	}
+
+    //The caps are no wider than 60 degrees, and at least six of those
+    //are needed to cover a sphere. Otherwise the sphere is covered if
+    //the caps cover the boundary circle of every cap, as an uncovered
+    //region must be bounded by one of them.
+    if (caps.size() < 6) return false;
+    for (size_t i(0); i < caps.size(); ++i)
+      if (!circleCovered(caps, i))
+	return false;
+    return true;
+  }
+
+  void
+  GCells::updateBurial(const size_t ID)
+  {
+    const bool buried = _sleeping[ID] && testBuried(ID);
+    if (buried == _buried[ID]) return;
+
+    _buried[ID] = buried;
+    size_t& count = _exposedCount[_cellData.getCellID(ID)];
+    if (buried)
+      {
+	--count;
+	return;
+      }
+
+    ++count;
+    //The awake particles have no events with a buried particle, so
+    //they must be predicted now. Particles which have woken are
+    //updated by the scheduler.
+    if (_sleeping[ID])
+      Sim->ptrScheduler->fullUpdate(Sim->particles[ID]);
+  }
+
+  void
+  GCells::particlesUpdated(const NEventData& PDat)
+  {
+    for (const ParticleEventData& pdat : PDat.L1partChanges)
+      updateSleeping(Sim->particles[pdat.getParticleID()]);
+
+    for (const PairEventData& pdat : PDat.L2partChanges)
+      {
+	updateSleeping(Sim->particles[pdat.particle1_.getParticleID()]);
+	updateSleeping(Sim->particles[pdat.particle2_.getParticleID()]);
+      }
+  }
+
+  void
+  GCells::updateSleeping(const Particle& part)
+  {
+    const bool sleeping = part.testState(Particle::SLEEPING);
+    if ((sleeping == _sleeping[part.getID()]) || !isInteraction(part)) return;
+
+    _sleeping[part.getID()] = sleeping;
+    size_t& count = _awakeCount[_cellData.getCellID(part.getID())];
+    if (sleeping)
+      --count;
+    else
+      ++count;
+
+    if (!_burialDiameter) return;
+    updateBurial(part.getID());
+
+    //A particle falling asleep can only bury the exposed sleeping
+    //particles within its reach, and a woken particle can only expose
+    //the buried ones. The cell neighbourhood is symmetric, so these
+    //are all the particles it was tested against.
+    std::vector<size_t> neighbours;
+    getParticleNeighbours(_ordering.toCoord(_cellData.getCellID(part.getID())), neighbours);
+    for (const size_t id2 : neighbours)
+      if ((id2 != part.getID()) && _sleeping[id2] && (_buried[id2] != sleeping))
+	{
+	  Vector rij = Sim->particles[id2].getPosition() - part.getPosition();
+	  Sim->BCs->applyBC(rij);
+	  if (rij.nrm() < 2 * _burialDiameter)
+	    updateBurial(id2);
+	}
+  }
+
+  void
+  GCells::moveParticle(const size_t oldCell, const size_t newCell, const size_t ID)
+  {
+    _cellData.moveTo(oldCell, newCell, ID);
+    if (!_sleeping[ID])
+      {
+	--_awakeCount[oldCell];
+	++_awakeCount[newCell];
+      }
+    if (!_buried[ID])
+      {
+	--_exposedCount[oldCell];
+	++_exposedCount[newCell];
+      }
+  }
+
+  void
+  GCells::saveCheckpoint(std::ostream& os) const
+  {
+    //The order of the particles in each cell sets the order in which
+    //events are pushed into the FEL, so the cell contents are stored
+    //exactly.
+    checkpoint::write(os, uint64_t(_ordering.length()));
+    for (size_t cellIndex(0); cellIndex < _ordering.length(); ++cellIndex)
+      {
+	const auto contents = _cellData.getCellContents(cellIndex);
+	checkpoint::write(os, std::vector<size_t>(contents.begin(), contents.end()));
+      }
+    //The cell events in the FEL are tagged with the grid generation
+    checkpoint::write(os, uint64_t(_gridGeneration));
+    checkpoint::write(os, uint64_t(_tuneWindow));
+    checkpoint::write(os, uint64_t(_tuneCellEvents));
+    checkpoint::write(os, uint64_t(_tuneScans));
+    checkpoint::write(os, uint64_t(_tuneScanned));
+  }
+
+  void
+  GCells::loadCheckpoint(std::istream& is)
+  {
+    uint64_t cellCount;
+    checkpoint::read(is, cellCount);
+    if (cellCount != _ordering.length())
+      M_throw() << "The checkpoint has " << cellCount << " cells but the neighbour list \"" << globName 
+		<< "\" has " << _ordering.length() << ", has the configuration changed?";
+
+    _cellData.clear();
+    _cellData.resize(_ordering.length(), Sim->particles.size());
+    std::vector<size_t> contents;
+    for (size_t cellIndex(0); cellIndex < _ordering.length(); ++cellIndex)
+      {
+	checkpoint::read(is, contents);
+	for (const size_t pid : contents)
+	  _cellData.add(cellIndex, pid);
+      }
+
+    uint64_t generation;
+    checkpoint::read(is, generation);
+    _gridGeneration = generation;
+
+    uint64_t window, cellEvents, scans, scanned;
+    checkpoint::read(is, window);
+    checkpoint::read(is, cellEvents);
+    checkpoint::read(is, scans);
+    checkpoint::read(is, scanned);
+    _tuneWindow = window;
+    _tuneCellEvents = cellEvents;
+    _tuneScans = scans;
+    _tuneScanned = scanned;
+
+    //The particle states have already been restored
+    countAwake();
   }
 
   std::array<size_t, 3>
@@ -270,9 +772,42 @@ namespace dynamo {
       }
   }
   
+  void
+  GCells::getAwakeParticleNeighbours(const Particle& part, std::vector<size_t>& retlist) const
+  {
+    //No awake particle can reach a buried particle
+    if (_buried[part.getID()]) return;
+
+    const size_t start = retlist.size();
+    for (auto cellIndex : _ordering.getSurroundingIndices(_ordering.toCoord(_cellData.getCellID(part.getID())), std::array<size_t, 3>{{overlink, overlink, overlink}}))
+      if (_awakeCount[cellIndex])
+	{
+	  const auto& neighbours = _cellData.getCellContents(cellIndex);
+	  retlist.insert(retlist.end(), neighbours.begin(), neighbours.end());
+	}
+    countScan(retlist.size() - start);
+  }
+
+  void
+  GCells::getExposedParticleNeighbours(const Particle& part, std::vector<size_t>& retlist) const
+  {
+    if (!_burialDiameter)
+      return getParticleNeighbours(part, retlist);
+
+    const size_t start = retlist.size();
+    for (auto cellIndex : _ordering.getSurroundingIndices(_ordering.toCoord(_cellData.getCellID(part.getID())), std::array<size_t, 3>{{overlink, overlink, overlink}}))
+      if (_exposedCount[cellIndex])
+	for (const size_t id2 : _cellData.getCellContents(cellIndex))
+	  if (!_buried[id2])
+	    retlist.push_back(id2);
+    countScan(retlist.size() - start);
+  }
+
   void
   GCells::getParticleNeighbours(const Particle& part, std::vector<size_t>& retlist) const {
+    const size_t start = retlist.size();
     getParticleNeighbours(_ordering.toCoord(_cellData.getCellID(part.getID())), retlist);
+    countScan(retlist.size() - start);
   }
 
   void
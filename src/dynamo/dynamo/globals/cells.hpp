@@ -25,6 +25,7 @@
 #include <magnet/containers/multimaps.hpp>
 #include <magnet/containers/ordering.hpp>
 #include <unordered_map>
+#include <atomic>
 #include <vector>
 
 namespace dynamo {
@@ -107,6 +108,21 @@ namespace dynamo {
     efficient however, the vector is much more cache friendly and can
     boost performance by 50% in cases where the cell has multiple
     particles inside of it.
+
+    Cells which only hold Particle::SLEEPING particles are skipped
+    when the events of sleeping particles are predicted. Sleeping
+    particles buried inside their islands are also skipped when the
+    events of awake particles are predicted.
+
+    The cell width defaults to the larger of the unitary occupancy
+    width and the minimum width of the overlink, but can be set using
+    the CellWidth attribute. If the AutoTune attribute is set, the
+    rate of cell events and the mean number of neighbours scanned are
+    measured over windows of neighbour scans, and the grid is rebuilt
+    with the overlink and cell width which minimise a simple cost
+    model of the two (see autoTune()). A retune must be predicted to
+    save at least a fifth of the cost, and the window doubles after
+    every retune, so retunes are rare.
    */
   class GCells: public GNeighbourList
   {
@@ -124,11 +140,24 @@ namespace dynamo {
 
     virtual void reinitialise();
 
+    virtual void growMaxInteractionRange(double);
+
+    virtual bool isEventValid(const Event& event) const
+    { return event._additionalData2 == _gridGeneration; }
+
     void getParticleNeighbours(const Particle&, std::vector<size_t>&) const;
     void getParticleNeighbours(const Vector&, std::vector<size_t>&) const;
+
+    virtual void getAwakeParticleNeighbours(const Particle&, std::vector<size_t>&) const;
+
+    virtual void getExposedParticleNeighbours(const Particle&, std::vector<size_t>&) const;
     
     virtual void operator<<(const magnet::xml::Node&);
 
+    virtual void saveCheckpoint(std::ostream&) const;
+
+    virtual void loadCheckpoint(std::istream&);
+
     Vector getCellDimensions() const 
     { return _cellDimension; }
 
@@ -136,12 +165,24 @@ namespace dynamo {
 
     void setConfigOutput(bool val) { _inConfig = val; }
 
+    //! Enable or disable the automatic tuning of the grid.
+    void setAutoTune(bool val) { _autoTune = val; }
+
   protected:
     virtual void getParticleNeighbours(const std::array<size_t, 3>&, std::vector<size_t>&) const;
 
     typedef magnet::containers::RowMajorOrdering<3> Ordering;
     Ordering _ordering;
 
+    /*! \brief Test if a cell was in the neighbourhood of a cell of
+        an earlier grid.
+
+      \param oldOrdering The ordering of the earlier grid.
+      \param coords The coordinates of the central cell in the earlier grid.
+      \param cellID2 The index of the other cell in the earlier grid.
+     */
+    bool isOldNeighbour(const Ordering& oldOrdering, const std::array<size_t, 3>& coords, const size_t cellID2) const;
+
     Vector _cellDimension;
     Vector _cellLatticeWidth;
     Vector _cellOffset;
@@ -149,6 +190,74 @@ namespace dynamo {
     bool _inConfig;
     size_t overlink;
 
+    /*! \brief The number of times the particles have been rebinned
+        without rebuilding the FEL.
+
+      The cell events are tagged with this value, so the events
+      predicted for an earlier grid can be rejected.
+     */
+    size_t _gridGeneration;
+
+    /*! \brief The number of particles in each cell which are not
+        Particle::SLEEPING.
+
+      Cells without any awake particles are static, and are skipped
+      by getAwakeParticleNeighbours().
+     */
+    std::vector<size_t> _awakeCount;
+    //! The Particle::SLEEPING state of each particle in _awakeCount.
+    std::vector<bool> _sleeping;
+
+    /*! \brief Whether each Particle::SLEEPING particle is buried in
+        its island.
+
+      A sleeping particle is buried if every point at contact distance
+      from it lies inside another sleeping particle, so no awake
+      particle can reach it. Buried particles are left out by
+      getExposedParticleNeighbours(), and getAwakeParticleNeighbours()
+      returns no neighbours for them.
+     */
+    std::vector<bool> _buried;
+    //! The number of particles in each cell which are not buried.
+    std::vector<size_t> _exposedCount;
+    //! The contact distance of every pair, or zero if burial is not tested.
+    double _burialDiameter;
+
+    /*! \brief The contact distance used to test for burial.
+
+      Burial is only tested if all particles are hard spheres of a
+      single diameter which does not change with time, otherwise
+      zero is returned.
+     */
+    virtual double getBurialDiameter() const;
+    bool testBuried(size_t ID) const;
+    /*! \brief Retest the burial of a particle, and predict the events
+        of a sleeping particle which has become exposed.
+     */
+    void updateBurial(size_t ID);
+
+    //! The requested cell width (zero for the unitary occupancy width).
+    double _cellWidth;
+
+    bool _autoTune;
+    //! The number of neighbour scans between evaluations of the grid.
+    size_t _tuneWindow;
+    //! The number of cell events in the current window.
+    size_t _tuneCellEvents;
+    //! The neighbour enumerations (and neighbours returned) in the current window.
+    mutable std::atomic<size_t> _tuneScans, _tuneScanned;
+
+    /*! \brief Rebuild the grid if a better overlink and cell width
+        are predicted from the statistics of the current window.
+     */
+    void autoTune();
+    void countScan(size_t scanned) const;
+
+    void countAwake();
+    void particlesUpdated(const NEventData&);
+    void updateSleeping(const Particle&);
+    void moveParticle(size_t oldCell, size_t newCell, size_t ID);
+
 #ifdef DYNAMO_JUDY
     detail::CellParticleList<magnet::containers::Vector_Multimap<magnet::containers::VectorSet<size_t>>, 
 			     magnet::containers::JudyMap<size_t, size_t>> _cellData;
@@ -162,7 +271,10 @@ namespace dynamo {
 
     std::array<size_t, 3> getCellCoords(Vector) const;
 
+    void regrid();
     void addCells(std::array<size_t, 3> cellCount);
+    //! The fraction of the spare lattice width by which the cells overlap.
+    double cellOverlap() const;
     void buildCells();
 
     Vector calcPosition(const size_t cellIndex, const Particle& part) const { return calcPosition(_ordering.toCoord(cellIndex), part);}
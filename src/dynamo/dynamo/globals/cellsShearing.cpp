@@ -64,7 +64,7 @@ namespace dynamo {
 
     //We do not inherit GCells get Event as the calcPosition thing done
     //for infinite systems is breaking it for shearing for some reason.
-    return Event(part, Sim->dynamics->getSquareCellCollision2(part, calcPosition(_cellData.getCellID(part.getID())), _cellDimension) - Sim->dynamics->getParticleDelay(part), GLOBAL, CELL, ID);
+    return Event(part, Sim->dynamics->getSquareCellCollision2(part, calcPosition(_cellData.getCellID(part.getID())), _cellDimension) - Sim->dynamics->getParticleDelay(part), GLOBAL, CELL, ID, std::numeric_limits<size_t>::max(), _gridGeneration);
   }
 
   void 
@@ -109,7 +109,7 @@ namespace dynamo {
       
 	newCellCoord[0] = getCellCoords(tmpPos)[0];
 
-	_cellData.moveTo(oldCellIndex, _ordering.toIndex(newCellCoord), part.getID());
+	moveParticle(oldCellIndex, _ordering.toIndex(newCellCoord), part.getID());
       
 	//Check the entire neighbourhood, could check just the new
 	//neighbours and the extra LE neighbourhood strip but its a lot
@@ -123,7 +123,7 @@ namespace dynamo {
       {
 	//We're entering the boundary of the y direction
 	//Calculate the end cell, no boundary wrap check required
-	_cellData.moveTo(oldCellIndex, _ordering.toIndex(newCellCoord), part.getID());
+	moveParticle(oldCellIndex, _ordering.toIndex(newCellCoord), part.getID());
             
 	//Check the extra LE neighbourhood strip
 	std::vector<size_t> nbs;
@@ -136,10 +136,10 @@ namespace dynamo {
       }
     else
       {
-	_cellData.moveTo(oldCellIndex, _ordering.toIndex(newCellCoord), part.getID());
+	moveParticle(oldCellIndex, _ordering.toIndex(newCellCoord), part.getID());
 
 	auto newNBCellCoord = newCellCoord;
-	newNBCellCoord[cellDirection] += _ordering.getDimensions()[cellDirection] + ((cellDirectionInt > 0) ? 1 : -1);
+	newNBCellCoord[cellDirection] += _ordering.getDimensions()[cellDirection] + ((cellDirectionInt > 0) ? overlink : -overlink);
 	newNBCellCoord[cellDirection] %= _ordering.getDimensions()[cellDirection];
 
 	if ((cellDirection == 2) && ((oldCellCoord[1] == 0) || (oldCellCoord[1] == _ordering.getDimensions()[1] - 1)))
@@ -171,6 +171,14 @@ namespace dynamo {
     _sigCellChange(part, oldCellIndex);
   }
 
+  void
+  GCellsShearing::getAwakeParticleNeighbours(const Particle& part, std::vector<size_t>& retlist) const
+  {
+    //The sleeping cells are not skipped, as the Lees-Edwards
+    //neighbourhood is not a simple block of cells
+    GCells::getParticleNeighbours(part, retlist);
+  }
+
   void
   GCellsShearing::getParticleNeighbours(const std::array<size_t, 3>& cellCoords, std::vector<size_t>& retlist) const
   {
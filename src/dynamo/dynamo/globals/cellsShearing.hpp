@@ -35,7 +35,18 @@ namespace dynamo {
 
     virtual void runEvent(Particle&, const double);
 
+    virtual void getAwakeParticleNeighbours(const Particle&, std::vector<size_t>&) const;
+
+    //! The Lees-Edwards cells are not in the neighbourhood template,
+    //! so the neighbourlist is always rebuilt.
+    virtual void growMaxInteractionRange(double range)
+    { setMaxInteractionRange(range); }
+
   protected:
+    //! The buried particles are not skipped for the same reason as
+    //! the sleeping cells.
+    virtual double getBurialDiameter() const { return 0; }
+
     void getParticleNeighbours(const std::array<size_t, 3>&, std::vector<size_t>&) const;
     void getAdditionalLEParticleNeighbourhood(const Particle&, std::vector<size_t>&) const;
     void getAdditionalLEParticleNeighbourhood(std::array<size_t, 3>, std::vector<size_t>&) const;
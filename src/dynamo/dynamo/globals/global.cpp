@@ -55,6 +55,8 @@ namespace dynamo {
       }
     else if (!XML.getAttribute("Type").getValue().compare("SOCells"))
       return shared_ptr<Global>(new GSOCells(XML, Sim));
+    else if (!XML.getAttribute("Type").getValue().compare("VerletList"))
+      return shared_ptr<Global>(new GVerletList(XML, Sim));
     else if (!XML.getAttribute("Type").getValue().compare("Francesco"))
       return shared_ptr<Global>(new GFrancesco(XML, Sim));
     else if (!XML.getAttribute("Type").getValue().compare("Waker"))
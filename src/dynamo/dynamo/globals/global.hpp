@@ -63,6 +63,16 @@ namespace dynamo {
      */
     virtual void runEvent(Particle& p, const double dt) = 0;
 
+    /*! \brief Tests if an event returned by getEvent() is still
+      current.
+
+      Global events are not recalculated before they are run (see
+      Scheduler::executeNextEvent()), so a Global which outdates its
+      queued events without the FEL being rebuilt must reject them
+      here. Rejected events are discarded by the Scheduler.
+     */
+    virtual bool isEventValid(const Event&) const { return true; }
+
     /*! \brief Initializes the Global event.
      */
     virtual void initialise(size_t nID)  { ID=nID; }
@@ -81,6 +91,14 @@ namespace dynamo {
      */
     virtual void operator<<(const magnet::xml::Node&) = 0;
 
+    /*! \brief Write any dynamic state of the Global to a binary
+        checkpoint (see Simulation::writeCheckpoint()).
+     */
+    virtual void saveCheckpoint(std::ostream&) const {}
+
+    /*! \brief Restore the state written by saveCheckpoint(). */
+    virtual void loadCheckpoint(std::istream&) {}
+
     /*! \brief Sets the name by which this Global is referred to.
      */
     void setName(const std::string& tmp) { globName = tmp; }
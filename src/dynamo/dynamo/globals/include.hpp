@@ -20,6 +20,7 @@
 #include <dynamo/globals/PBCSentinel.hpp>
 #include <dynamo/globals/ParabolaSentinel.hpp>
 #include <dynamo/globals/socells.hpp>
+#include <dynamo/globals/verletlist.hpp>
 #include <dynamo/globals/waker.hpp>
 #include <dynamo/globals/volumetric_potential.hpp>
 #include <dynamo/globals/francesco.hpp>
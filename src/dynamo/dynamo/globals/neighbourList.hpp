@@ -47,6 +47,28 @@ namespace dynamo {
     virtual void getParticleNeighbours(const Particle&, std::vector<size_t>&) const = 0;
     virtual void getParticleNeighbours(const Vector&, std::vector<size_t>&) const = 0;
 
+    /*! \brief Collects the neighbours of a particle, but may leave out
+        any which are Particle::SLEEPING.
+
+      A sleeping particle can only have events with the awake
+      particles, so neighbourlists which can skip sleeping regions
+      quickly should override this. The returned list may still
+      contain sleeping particles.
+     */
+    virtual void getAwakeParticleNeighbours(const Particle& part, std::vector<size_t>& retlist) const
+    { getParticleNeighbours(part, retlist); }
+
+    /*! \brief Collects the neighbours of an awake particle, but may
+        leave out Particle::SLEEPING particles which it cannot reach.
+
+      A sleeping particle which is enclosed by the other sleeping
+      particles of its island can only be reached after one of them
+      has been woken. The returned list may still contain any
+      sleeping particle.
+     */
+    virtual void getExposedParticleNeighbours(const Particle& part, std::vector<size_t>& retlist) const
+    { getParticleNeighbours(part, retlist); }
+
     /*! \brief This returns the maximum interaction length this
       neighbourlist supports.
       
@@ -78,6 +100,20 @@ namespace dynamo {
       if (_initialised) reinitialise();
     }
 
+    /*! \brief Grow the range this neighbourlist is to support
+        without rebuilding the event list.
+
+      Neighbourlists which can rebin the particles in place only
+      announce the pairs which enter the neighbourhood (through
+      _sigNewNeighbour), as the events of the existing neighbours are
+      unaffected. This is only correct if the range grows and nothing
+      else about the system has changed (e.g., during a compression),
+      and the default implementation falls back to a full
+      setMaxInteractionRange().
+     */
+    virtual void growMaxInteractionRange(double range)
+    { setMaxInteractionRange(range); }
+
     /*! \brief Returns the requested minimum supported interaction
         range.
      */
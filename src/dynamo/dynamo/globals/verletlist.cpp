@@ -0,0 +1,293 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <dynamo/globals/verletlist.hpp>
+#include <dynamo/dynamics/dynamics.hpp>
+#include <dynamo/units/units.hpp>
+#include <dynamo/schedulers/scheduler.hpp>
+#include <dynamo/BC/LEBC.hpp>
+#include <dynamo/checkpoint.hpp>
+#include <magnet/xmlwriter.hpp>
+#include <magnet/xmlreader.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace dynamo {
+  GVerletList::GVerletList(const magnet::xml::Node& XML, dynamo::Simulation* ptrSim):
+    GNeighbourList(ptrSim, "VerletNeighbourList"),
+    _skin(0),
+    _currentSkin(0),
+    _gridWidth({1,1,1}),
+    _gridSteps{{1, 1, 1}}
+  {
+    operator<<(XML);
+
+    dout << "Verlet List Loaded" << std::endl;
+  }
+
+  void
+  GVerletList::operator<<(const magnet::xml::Node& XML)
+  {
+    if (XML.hasAttribute("NeighbourhoodRange"))
+      _maxInteractionRange = XML.getAttribute("NeighbourhoodRange").as<double>() * Sim->units.unitLength();
+
+    if (XML.hasAttribute("Skin"))
+      _skin = XML.getAttribute("Skin").as<double>() * Sim->units.unitLength();
+
+    globName = XML.getAttribute("Name");
+
+    range = shared_ptr<IDRange>(IDRange::getClass(XML.getNode("IDRange"), Sim));
+  }
+
+  void
+  GVerletList::outputXML(magnet::xml::XmlStream& XML) const
+  {
+    XML << magnet::xml::tag("Global")
+	<< magnet::xml::attr("Type") << "VerletList"
+	<< magnet::xml::attr("Name") << globName
+	<< magnet::xml::attr("NeighbourhoodRange")
+	<< _maxInteractionRange / Sim->units.unitLength();
+
+    if (_skin) XML << magnet::xml::attr("Skin") << _skin / Sim->units.unitLength();
+
+    XML << range
+	<< magnet::xml::endtag("Global");
+  }
+
+  Event
+  GVerletList::getEvent(const Particle& part) const
+  {
+#ifdef ISSS_DEBUG
+    if (!Sim->dynamics->isUpToDate(part))
+      M_throw() << "Particle is not up to date";
+#endif
+
+    //The half width of the skin cube
+    const double h = _currentSkin / (2 * std::sqrt(3.0));
+    return Event(part, Sim->dynamics->getSquareCellCollision2(part, _reference[part.getID()] - Vector{h, h, h}, Vector{2 * h, 2 * h, 2 * h}) - Sim->dynamics->getParticleDelay(part), GLOBAL, CELL, ID);
+  }
+
+  void
+  GVerletList::runEvent(Particle& part, const double)
+  {
+    //The scheduler and callbacks expect the particle to be up to date
+    Sim->dynamics->updateParticle(part);
+
+    //The callbacks may add events, so the virtual event must be
+    //removed first
+    Sim->ptrScheduler->popNextEvent();
+
+    rebuildList(part);
+
+    Sim->ptrScheduler->pushEvent(getEvent(part));
+  }
+
+  void
+  GVerletList::initialise(size_t nID)
+  {
+    Global::initialise(nID);
+
+    //The image of a reference position depends on the time it was
+    //set in a shearing system
+    if (std::dynamic_pointer_cast<BCLeesEdwards>(Sim->BCs))
+      M_throw() << "The VerletList neighbour list does not support Lees-Edwards boundary conditions";
+
+    reinitialise();
+  }
+
+  void
+  GVerletList::reinitialise()
+  {
+    GNeighbourList::reinitialise();
+
+    dout << "Reinitialising on collision " << Sim->eventCount << std::endl;
+
+    _currentSkin = _skin ? _skin : 0.3 * _maxInteractionRange;
+    const double listDistance = _maxInteractionRange + _currentSkin;
+
+    //The grid cells must be at least the list distance wide
+    const double embiggen = 1.0 + 10 * std::numeric_limits<double>::epsilon();
+    std::array<size_t, 3> cellCount;
+    for (size_t iDim = 0; iDim < NDIM; iDim++)
+      {
+	cellCount[iDim] = size_t(Sim->primaryCellSize[iDim] / (listDistance * embiggen));
+	if (cellCount[iDim] < 3)
+	  cellCount[iDim] = 1;
+	_gridSteps[iDim] = (cellCount[iDim] < 3) ? 0 : 1;
+	_gridWidth[iDim] = Sim->primaryCellSize[iDim] / cellCount[iDim];
+      }
+    _ordering = Ordering(cellCount);
+
+    //Required so the reference positions are current
+    Sim->dynamics->updateAllParticles();
+
+    _reference.assign(Sim->N(), Vector{0, 0, 0});
+    _gridData.clear();
+    _gridData.resize(_ordering.length(), Sim->N());
+    for (const size_t pid : *range)
+      {
+	_reference[pid] = Sim->particles[pid].getPosition();
+	_gridData.add(getGridCell(_reference[pid]), pid);
+      }
+
+    //The list criterion is symmetric, so each list can be built
+    //independently
+    _neighbours.assign(Sim->N(), std::vector<size_t>());
+    size_t listed(0);
+    for (const size_t pid : *range)
+      {
+	getListPartners(_reference[pid], pid, _neighbours[pid]);
+	listed += _neighbours[pid].size();
+      }
+
+    dout << "Skin distance " << _currentSkin / Sim->units.unitLength()
+	 << "\nList distance " << listDistance / Sim->units.unitLength()
+	 << "\nGrid cells " << cellCount[0] << "," << cellCount[1] << "," << cellCount[2]
+	 << "\nMean list length " << (range->size() ? double(listed) / range->size() : 0) << std::endl;
+
+    _sigReInitialise();
+  }
+
+  size_t
+  GVerletList::getGridCell(Vector pos) const
+  {
+    Sim->BCs->applyBC(pos);
+
+    std::array<size_t, 3> coords;
+    for (size_t iDim = 0; iDim < NDIM; iDim++)
+      {
+	long coord = std::floor(pos[iDim] / _gridWidth[iDim] + 0.5 * _ordering.getDimensions()[iDim]);
+	coord %= long(_ordering.getDimensions()[iDim]);
+	if (coord < 0) coord += _ordering.getDimensions()[iDim];
+	coords[iDim] = coord;
+      }
+
+    return _ordering.toIndex(coords);
+  }
+
+  void
+  GVerletList::getListPartners(const Vector& pos, const size_t ID, std::vector<size_t>& retlist) const
+  {
+    const double listDistance = _maxInteractionRange + _currentSkin;
+    for (auto cellIndex : _ordering.getSurroundingIndices(_ordering.toCoord(getGridCell(pos)), _gridSteps))
+      for (const size_t& id2 : _gridData.getCellContents(cellIndex))
+	{
+	  if (id2 == ID) continue;
+	  Vector rij = pos - _reference[id2];
+	  Sim->BCs->applyBC(rij);
+	  if (rij.nrm2() < listDistance * listDistance)
+	    retlist.push_back(id2);
+	}
+  }
+
+  void
+  GVerletList::rebuildList(const Particle& part)
+  {
+    const size_t ID = part.getID();
+
+    //Only the pairs of this particle change, so it is removed from
+    //the lists of its old partners
+    std::vector<size_t> oldNeighbours;
+    std::swap(oldNeighbours, _neighbours[ID]);
+    for (const size_t id2 : oldNeighbours)
+      {
+	std::vector<size_t>& list = _neighbours[id2];
+	list.erase(std::find(list.begin(), list.end(), ID));
+      }
+
+    _reference[ID] = part.getPosition();
+    const size_t oldCell = _gridData.getCellID(ID);
+    const size_t newCell = getGridCell(_reference[ID]);
+    if (oldCell != newCell)
+      _gridData.moveTo(oldCell, newCell, ID);
+
+    getListPartners(_reference[ID], ID, _neighbours[ID]);
+
+    //The events with the old partners are still in the FEL, so only
+    //the new partners need testing
+    std::sort(oldNeighbours.begin(), oldNeighbours.end());
+    for (const size_t id2 : _neighbours[ID])
+      {
+	_neighbours[id2].push_back(ID);
+	if (!std::binary_search(oldNeighbours.begin(), oldNeighbours.end(), id2))
+	  _sigNewNeighbour(part, id2);
+      }
+  }
+
+  void
+  GVerletList::getParticleNeighbours(const Particle& part, std::vector<size_t>& retlist) const
+  {
+    const std::vector<size_t>& list = _neighbours[part.getID()];
+    retlist.insert(retlist.end(), list.begin(), list.end());
+  }
+
+  void
+  GVerletList::getParticleNeighbours(const Vector& vec, std::vector<size_t>& retlist) const
+  {
+    //A particle within the interaction range of vec has its reference
+    //position within the surrounding grid cells
+    for (auto cellIndex : _ordering.getSurroundingIndices(_ordering.toCoord(getGridCell(vec)), _gridSteps))
+      {
+	const auto& neighbours = _gridData.getCellContents(cellIndex);
+	retlist.insert(retlist.end(), neighbours.begin(), neighbours.end());
+      }
+  }
+
+  void
+  GVerletList::saveCheckpoint(std::ostream& os) const
+  {
+    //The order of the grid and the lists sets the order in which
+    //events are pushed into the FEL, so they are stored exactly
+    checkpoint::write(os, _reference);
+    checkpoint::write(os, uint64_t(_ordering.length()));
+    for (size_t cellIndex(0); cellIndex < _ordering.length(); ++cellIndex)
+      {
+	const auto contents = _gridData.getCellContents(cellIndex);
+	checkpoint::write(os, std::vector<size_t>(contents.begin(), contents.end()));
+      }
+    for (const std::vector<size_t>& list : _neighbours)
+      checkpoint::write(os, list);
+  }
+
+  void
+  GVerletList::loadCheckpoint(std::istream& is)
+  {
+    checkpoint::read(is, _reference);
+    if (_reference.size() != Sim->N())
+      M_throw() << "The checkpoint has " << _reference.size() << " reference positions but the neighbour list \"" << globName
+		<< "\" has " << Sim->N() << " particles, has the configuration changed?";
+
+    uint64_t cellCount;
+    checkpoint::read(is, cellCount);
+    if (cellCount != _ordering.length())
+      M_throw() << "The checkpoint has " << cellCount << " cells but the neighbour list \"" << globName
+		<< "\" has " << _ordering.length() << ", has the configuration changed?";
+
+    _gridData.clear();
+    _gridData.resize(_ordering.length(), Sim->N());
+    std::vector<size_t> contents;
+    for (size_t cellIndex(0); cellIndex < _ordering.length(); ++cellIndex)
+      {
+	checkpoint::read(is, contents);
+	for (const size_t pid : contents)
+	  _gridData.add(cellIndex, pid);
+      }
+
+    for (std::vector<size_t>& list : _neighbours)
+      checkpoint::read(is, list);
+  }
+}
@@ -0,0 +1,117 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <dynamo/globals/cells.hpp>
+#include <vector>
+
+namespace dynamo {
+  /*! \brief An event driven Verlet (per-particle) neighbour list.
+
+    Each particle has a reference position, and is kept inside a cube
+    (the skin cube) centred on it. As a particle can only be
+    \f$\sqrt{3}h\f$ from its reference position, where \f$h\f$ is the
+    half width of the skin cube, two particles can only be within the
+    interaction range if their reference positions are within the
+    interaction range plus the skin distance \f$2\sqrt{3}h\f$. Each
+    particle stores the list of these partners, and these lists are
+    returned as the neighbourhood instead of the contents of a block
+    of cells.
+
+    When a particle leaves its skin cube, a CELL event resets its
+    reference position to its current position and rebuilds its list
+    using a grid of the reference positions (the other lists only
+    gain or lose this particle). Only the new partners are announced
+    through _sigNewNeighbour.
+
+    A cube is used instead of a sphere as the time a particle leaves
+    it is available for every Dynamics (see
+    Dynamics::getSquareCellCollision2()). The skin distance defaults
+    to 30% of the interaction range but can be set using the Skin
+    attribute. A larger skin gives longer lists but fewer rebuilds.
+   */
+  class GVerletList: public GNeighbourList
+  {
+  public:
+    GVerletList(const magnet::xml::Node&, dynamo::Simulation*);
+
+    virtual ~GVerletList() {}
+
+    virtual Event getEvent(const Particle &) const;
+
+    virtual void runEvent(Particle&, const double);
+
+    virtual void initialise(size_t);
+
+    virtual void reinitialise();
+
+    void getParticleNeighbours(const Particle&, std::vector<size_t>&) const;
+    void getParticleNeighbours(const Vector&, std::vector<size_t>&) const;
+
+    virtual void operator<<(const magnet::xml::Node&);
+
+    virtual void saveCheckpoint(std::ostream&) const;
+
+    virtual void loadCheckpoint(std::istream&);
+
+    /*! \brief The lists are only guaranteed to contain the pairs
+        within the requested interaction range.
+     */
+    virtual double getMaxSupportedInteractionLength() const
+    { return _maxInteractionRange; }
+
+  protected:
+    typedef magnet::containers::RowMajorOrdering<3> Ordering;
+
+    //! The requested skin distance (zero for the default).
+    double _skin;
+    //! The skin distance in use.
+    double _currentSkin;
+
+    //! The reference position of each particle.
+    std::vector<Vector> _reference;
+    //! The partners of each particle.
+    std::vector<std::vector<size_t> > _neighbours;
+
+    /*! \brief A grid of the reference positions, with cells at
+        least as wide as the list distance.
+
+	Dimensions with fewer than three cells only have one cell, so
+	the neighbouring cells are never visited twice.
+     */
+    Ordering _ordering;
+    Vector _gridWidth;
+    std::array<size_t, 3> _gridSteps;
+#ifdef DYNAMO_JUDY
+    detail::CellParticleList<magnet::containers::Vector_Multimap<magnet::containers::VectorSet<size_t>>,
+			     magnet::containers::JudyMap<size_t, size_t>> _gridData;
+#else
+    detail::CellParticleList<magnet::containers::Vector_Multimap<magnet::containers::VectorSet<size_t>>,
+			     std::unordered_map<size_t, size_t> > _gridData;
+#endif
+
+    virtual void outputXML(magnet::xml::XmlStream&) const;
+
+    size_t getGridCell(Vector) const;
+
+    //! Collect the particles whose reference position is within the list distance of pos.
+    void getListPartners(const Vector& pos, size_t ID, std::vector<size_t>& retlist) const;
+
+    //! Reset the reference position and list of a particle.
+    void rebuildList(const Particle&);
+  };
+}
@@ -93,7 +93,7 @@ namespace dynamo {
       {
 	EDat = ParticleEventData(part, *Sim->species(part), WALL);
 	part.getVelocity()[cellDirection] *= std::sqrt(arg) / std::abs(part.getVelocity()[cellDirection]);
-	_cellData.moveTo(oldCellIndex, newCellIndex, part.getID());
+	moveParticle(oldCellIndex, newCellIndex, part.getID());
       }
     else
       EDat = Sim->dynamics->runPlaneEvent(part, vNorm, 1.0, 0.0);
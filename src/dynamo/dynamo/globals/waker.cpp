@@ -134,12 +134,14 @@ namespace dynamo {
   
     ParticleEventData EDat(part, *Sim->species(part), iEvent._type);
     
+    counterRNG rng = Sim->getParticleRNG(part.getID());
     std::normal_distribution<> norm_dist;
-    Vector newVel{norm_dist(Sim->ranGenerator), norm_dist(Sim->ranGenerator), norm_dist(Sim->ranGenerator)};
+    Vector newVel{norm_dist(rng), norm_dist(rng), norm_dist(rng)};
     newVel *= _wakeVelocity / newVel.nrm();
       
     part.getVelocity() = newVel;
     part.setState(Particle::DYNAMIC);
+    part.clearState(Particle::SLEEPING);
       
     Sim->_sigParticleUpdate(EDat);
       
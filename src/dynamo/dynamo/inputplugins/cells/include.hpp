@@ -28,3 +28,4 @@
 #include <dynamo/inputplugins/cells/linearRod.hpp>
 #include <dynamo/inputplugins/cells/binary.hpp>
 #include <dynamo/inputplugins/cells/triangleIntersection.hpp>
+#include <dynamo/inputplugins/cells/rsa.hpp>
@@ -0,0 +1,221 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <dynamo/inputplugins/cells/cell.hpp>
+#include <magnet/math/philox.hpp>
+#include <magnet/thread/threadpool.hpp>
+#include <magnet/exception.hpp>
+#include <algorithm>
+#include <random>
+#include <cmath>
+
+namespace dynamo {
+  /*! \brief Random sequential addition (RSA) of non-overlapping
+      spheres in a periodic box.
+
+    Spheres are added one at a time at uniformly random positions,
+    and a candidate position is rejected if it overlaps any sphere
+    already placed. Overlaps are found using a uniform grid of cells
+    (at least as wide as the largest sphere), so each test only
+    examines the neighbouring cells and the packing is built in
+    O(N) time.
+
+    Candidates are generated and tested against the grid in batches,
+    in parallel. Each candidate is drawn from its own counter-based
+    random stream, and the candidates of a batch are then accepted
+    in order (checking the neighbouring cells for spheres accepted
+    earlier in the same batch). The resulting packing is therefore
+    identical to a serial RSA, regardless of the number of threads
+    used.
+   */
+  struct CURandomSequentialAddition: public UCell
+  {
+    /*! \param diameters The diameters of the spheres to place (in order).
+      \param dimensions The dimensions of the periodic box to fill.
+      \param seed The seed of the random streams.
+      \param threads The number of worker threads to use.
+      \param nextCell The unit cell to place at each sphere.
+     */
+    CURandomSequentialAddition(const std::vector<double>& diameters, Vector ndimensions,
+			       uint64_t seed, size_t threads, UCell* nextCell):
+      UCell(nextCell),
+      _diameters(diameters),
+      _dimensions(ndimensions),
+      _seed(seed),
+      _maxAttempts(1000 * diameters.size() + 1000000)
+    {
+      _pool.setThreadCount(threads);
+    }
+
+    virtual std::vector<Vector> placeObjects(const Vector & centre)
+    {
+      const size_t N = _diameters.size();
+      if (N == 0) return std::vector<Vector>();
+
+      const double maxDiameter = *std::max_element(_diameters.begin(), _diameters.end());
+      _cellCount = 1;
+      for (size_t iDim(0); iDim < NDIM; ++iDim)
+	{
+	  _cells[iDim] = std::max(size_t(1), size_t(_dimensions[iDim] / maxDiameter));
+	  _cellWidth[iDim] = _dimensions[iDim] / _cells[iDim];
+	  _cellCount *= _cells[iDim];
+	}
+
+      _cellHead.assign(_cellCount, -1);
+      _next.assign(N, -1);
+      _positions.clear();
+      _positions.reserve(N);
+
+      //Make each batch large enough to keep every thread busy, but
+      //not so large that many candidates are wasted at the end.
+      const size_t batchSize = 1024 * std::max(size_t(1), _pool.getThreadCount());
+      std::vector<Vector> candidates(batchSize);
+      std::vector<double> gaps(batchSize);
+      const size_t chunks = std::max(size_t(1), _pool.getThreadCount());
+
+      size_t attempt = 0;
+      while (_positions.size() < N)
+	{
+	  if (attempt > _maxAttempts)
+	    M_throw() << "Random sequential addition failed to place all spheres after "
+		      << attempt << " attempts (" << _positions.size() << " of " << N
+		      << " placed). The target density is probably above the RSA jamming limit.";
+
+	  for (size_t chunk(0); chunk < chunks; ++chunk)
+	    _pool.queueTask(std::bind(&CURandomSequentialAddition::testCandidates, this,
+				      std::ref(candidates), std::ref(gaps), attempt,
+				      chunk * batchSize / chunks, (chunk + 1) * batchSize / chunks));
+	  _pool.wait();
+
+	  const size_t batchStart = _positions.size();
+	  for (size_t i(0); (i < batchSize) && (_positions.size() < N); ++i)
+	    {
+	      const double radius = 0.5 * _diameters[_positions.size()];
+	      //Check against the spheres placed before this batch
+	      if (gaps[i] < radius) continue;
+
+	      //Check against the spheres accepted in this batch
+	      if (getGap(candidates[i], batchStart) < radius) continue;
+
+	      addSphere(candidates[i]);
+	    }
+	  attempt += batchSize;
+	}
+
+      std::vector<Vector> retval;
+      for (const Vector& position : _positions)
+	{
+	  const std::vector<Vector>& newsites = uc->placeObjects(position + centre);
+	  retval.insert(retval.end(), newsites.begin(), newsites.end());
+	}
+      return retval;
+    }
+
+  protected:
+    /*! \brief Generates and tests the candidates [start, end) of a
+        batch against the spheres already in the grid.
+
+	For each candidate, this calculates the distance to the
+	surface of the nearest sphere (within the neighbouring cells),
+	so that the candidate can be accepted or rejected for any
+	sphere diameter without rescanning the grid.
+     */
+    void testCandidates(std::vector<Vector>& candidates, std::vector<double>& gaps,
+			size_t attempt, size_t start, size_t end) const
+    {
+      for (size_t i(start); i < end; ++i)
+	{
+	  magnet::math::Philox4x32 rng(_seed, 0, attempt + i);
+	  std::uniform_real_distribution<> uniform_dist(-0.5, 0.5);
+	  Vector& pos = candidates[i];
+	  for (size_t iDim(0); iDim < NDIM; ++iDim)
+	    pos[iDim] = uniform_dist(rng) * _dimensions[iDim];
+
+	  gaps[i] = getGap(pos, 0);
+	}
+    }
+
+    /*! \brief The distance from pos to the surface of the nearest
+        sphere in the neighbouring cells, only considering the
+        spheres with an index of at least firstSphere.
+
+	Spheres are pushed onto the front of their cell's list, so
+	each list is in descending index order and the scan of a
+	cell stops at the first sphere placed before firstSphere.
+     */
+    double getGap(const Vector& pos, const size_t firstSphere) const
+    {
+      std::array<size_t, NDIM> coords = getCellCoords(pos);
+      double gap = HUGE_VAL;
+      std::array<size_t, NDIM> offset;
+      for (offset[0] = 0; offset[0] < std::min(_cells[0], size_t(3)); ++offset[0])
+	for (offset[1] = 0; offset[1] < std::min(_cells[1], size_t(3)); ++offset[1])
+	  for (offset[2] = 0; offset[2] < std::min(_cells[2], size_t(3)); ++offset[2])
+	    {
+	      size_t cellID = 0;
+	      for (size_t iDim(NDIM); iDim != 0; --iDim)
+		cellID = cellID * _cells[iDim - 1]
+		  + (coords[iDim - 1] + _cells[iDim - 1] + offset[iDim - 1] - 1) % _cells[iDim - 1];
+
+	      for (int j = _cellHead[cellID]; (j != -1) && (size_t(j) >= firstSphere); j = _next[j])
+		gap = std::min(gap, minimumImage(pos - _positions[j]).nrm() - 0.5 * _diameters[j]);
+	    }
+      return gap;
+    }
+
+    void addSphere(const Vector& pos)
+    {
+      std::array<size_t, NDIM> coords = getCellCoords(pos);
+      size_t cellID = 0;
+      for (size_t iDim(NDIM); iDim != 0; --iDim)
+	cellID = cellID * _cells[iDim - 1] + coords[iDim - 1];
+
+      _next[_positions.size()] = _cellHead[cellID];
+      _cellHead[cellID] = _positions.size();
+      _positions.push_back(pos);
+    }
+
+    std::array<size_t, NDIM> getCellCoords(const Vector& pos) const
+    {
+      std::array<size_t, NDIM> coords;
+      for (size_t iDim(0); iDim < NDIM; ++iDim)
+	coords[iDim] = std::min(_cells[iDim] - 1, size_t((pos[iDim] + 0.5 * _dimensions[iDim]) / _cellWidth[iDim]));
+      return coords;
+    }
+
+    Vector minimumImage(Vector rij) const
+    {
+      for (size_t iDim(0); iDim < NDIM; ++iDim)
+	rij[iDim] -= _dimensions[iDim] * std::round(rij[iDim] / _dimensions[iDim]);
+      return rij;
+    }
+
+    std::vector<double> _diameters;
+    Vector _dimensions;
+    uint64_t _seed;
+    size_t _maxAttempts;
+    magnet::thread::ThreadPool _pool;
+
+    std::array<size_t, NDIM> _cells;
+    Vector _cellWidth;
+    size_t _cellCount;
+    std::vector<int> _cellHead;
+    std::vector<int> _next;
+    std::vector<Vector> _positions;
+  };
+}
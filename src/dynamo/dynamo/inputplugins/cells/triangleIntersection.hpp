@@ -18,6 +18,8 @@
 #pragma once
 #include <dynamo/inputplugins/cells/cell.hpp>
 #include <array>
+#include <algorithm>
+#include <cmath>
 #include <string>
 #include <fstream>
 
@@ -77,11 +79,64 @@ namespace dynamo {
     
       std::cout << "\nCUTriangleIntersect :Checking spheres\n";
       std::cout.flush();
+
+      if (initval.empty()) return retval;
+
+      //Bin the triangles into a uniform grid covering the spheres, so
+      //each sphere is only tested against the nearby triangles. The
+      //cells are at least a diameter wide, and each triangle is
+      //added to every cell its (diameter expanded) bounding box
+      //touches.
+      Vector minpos = initval.front(), maxpos = initval.front();
+      for (const Vector& sphere : initval)
+	for (size_t iDim(0); iDim < NDIM; ++iDim)
+	  {
+	    minpos[iDim] = std::min(minpos[iDim], sphere[iDim]);
+	    maxpos[iDim] = std::max(maxpos[iDim], sphere[iDim]);
+	  }
+
+      double volume = 1;
+      for (size_t iDim(0); iDim < NDIM; ++iDim)
+	volume *= std::max(maxpos[iDim] - minpos[iDim], _diameter);
+      const double width = std::max(_diameter, std::cbrt(volume / initval.size()));
+
+      std::array<size_t, NDIM> cells;
+      for (size_t iDim(0); iDim < NDIM; ++iDim)
+	cells[iDim] = size_t((maxpos[iDim] - minpos[iDim]) / width) + 1;
+
+      auto cellCoord = [&](double pos, size_t iDim) -> size_t {
+	const double coord = std::floor((pos - minpos[iDim]) / width);
+	return size_t(std::min(std::max(coord, 0.0), double(cells[iDim] - 1)));
+      };
+
+      std::vector<std::vector<size_t> > grid(cells[0] * cells[1] * cells[2]);
+      for (size_t t(0); t < _triangles.size(); ++t)
+	{
+	  const triangle_type& triangle = _triangles[t];
+	  const Vector vertices[3] = {triangle[0], triangle[0] + triangle[1], triangle[0] + triangle[2]};
+	  std::array<size_t, NDIM> low, high;
+	  bool outside = false;
+	  for (size_t iDim(0); iDim < NDIM; ++iDim)
+	    {
+	      const double tmin = std::min({vertices[0][iDim], vertices[1][iDim], vertices[2][iDim]}) - _diameter;
+	      const double tmax = std::max({vertices[0][iDim], vertices[1][iDim], vertices[2][iDim]}) + _diameter;
+	      outside |= (tmax < minpos[iDim]) || (tmin > maxpos[iDim]);
+	      low[iDim] = cellCoord(tmin, iDim);
+	      high[iDim] = cellCoord(tmax, iDim);
+	    }
+	  if (outside) continue;
+
+	  for (size_t x(low[0]); x <= high[0]; ++x)
+	    for (size_t y(low[1]); y <= high[1]; ++y)
+	      for (size_t z(low[2]); z <= high[2]; ++z)
+		grid[x + cells[0] * (y + cells[1] * z)].push_back(t);
+	}
     
       for (const Vector& sphere : initval)
 	{
-	  for (const triangle_type& triangle : _triangles)
-	    if (triangleIntersects(sphere, triangle))
+	  const size_t cellID = cellCoord(sphere[0], 0) + cells[0] * (cellCoord(sphere[1], 1) + cells[1] * cellCoord(sphere[2], 2));
+	  for (const size_t t : grid[cellID])
+	    if (triangleIntersects(sphere, _triangles[t]))
 	      {
 		retval.push_back(sphere);
 		break;
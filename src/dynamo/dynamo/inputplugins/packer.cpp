@@ -47,6 +47,7 @@
 #include <boost/tokenizer.hpp>
 #include <cmath>
 #include <memory>
+#include <thread>
 
 namespace dynamo {
   typedef BoundedPQFEL<MinMaxPEL<3> > DefaultSorter;
@@ -135,7 +136,7 @@ namespace dynamo {
       "  -z [ --zcell ] arg          Number of unit-cells in the z dimension.\n"
       "  --rectangular-box           Set the simulation box to be rectangular so that the x,y,z cells also specify the simulation aspect ratio.\n"
       "  -d [ --density ] arg (=0.5) System density.\n"
-      "  --i1 arg (=FCC)             Lattice type (0=FCC, 1=BCC, 2=SC)\n";
+      "  --i1 arg (=FCC)             Lattice type (0=FCC, 1=BCC, 2=SC, 3=Random sequential addition)\n";
 
     switch (vm["pack-mode"].as<size_t>())
       {
@@ -2785,10 +2786,12 @@ namespace dynamo {
 		"      Note: Generated particle diameters are restricted to the range (0,1].\n"
 		"            Mass is distributed according to volume (constant density).\n"
 		"            A particle with diameter of 1 has a mass of 1.\n"
-		"       --i1 : Picks the packing routine to use [0] (0:FCC,1:BCC,2:SC)\n"
+		"       --i1 : Picks the packing routine to use [0] (0:FCC,1:BCC,2:SC,3:Random sequential addition)\n"
 		"       --f1 : Inelasticity [1.0]\n"
 		"       --f2 : Mean size [0.5]\n"
-		"       --f3 : Standard deviation [0.1]\n";
+		"       --f3 : Standard deviation [0.1]\n"
+		"      Note: With --i1 3 the particles are placed without overlaps using their\n"
+		"            generated diameters.\n";
 	      exit(1);
 	    }
 
@@ -2801,12 +2804,19 @@ namespace dynamo {
 	    variance = vm["f3"].as<double>();
 
 	  //FCC simple cubic pack of hard spheres with inelasticity and shearing
-	  //Pack the system, determine the number of particles
-	  std::unique_ptr<UCell> packptr(standardPackingHelper(new UParticle()));
-	  packptr->initialise();
-
-	  std::vector<Vector  >
-	    latticeSites(packptr->placeObjects(Vector{0,0,0}));
+	  //Pack the system, determine the number of particles. The
+	  //random sequential addition packing needs the particle
+	  //diameters, so it is deferred until they are generated.
+	  const bool rsa = vm.count("i1") && (vm["i1"].as<size_t>() == 3);
+	  std::vector<Vector> latticeSites;
+	  if (rsa)
+	    latticeSites.resize(getRSAParticleCount());
+	  else
+	    {
+	      std::unique_ptr<UCell> packptr(standardPackingHelper(new UParticle()));
+	      packptr->initialise();
+	      latticeSites = packptr->placeObjects(Vector{0,0,0});
+	    }
 
 	  if (vm.count("rectangular-box"))
 	    Sim->primaryCellSize = getNormalisedCellDimensions();
@@ -2884,6 +2894,16 @@ namespace dynamo {
 	    
 	      M->getProperty(i) = mass;
 	    }
+
+	  if (rsa)
+	    {
+	      std::vector<double> diameters(latticeSites.size());
+	      for (size_t i(0); i < latticeSites.size(); ++i)
+		diameters[i] = D->getProperty(i);
+	      std::unique_ptr<UCell> packptr(rsaPackingHelper(diameters, Sim->primaryCellSize, new UParticle()));
+	      packptr->initialise();
+	      latticeSites = packptr->placeObjects(Vector{0,0,0});
+	    }
 	
 	  Sim->interactions.push_back(shared_ptr<Interaction>(new IHardSphere(Sim, "D", elasticity, new IDPairRangeAll(), "Bulk")));
 
@@ -3179,6 +3199,18 @@ namespace dynamo {
 	    sysPack = new CUSC(getCells(), boxDimensions, tmpPtr);
 	    break;
 	  }
+	case 3:
+	  {
+	    //Monodisperse spheres, sized so the packing has the
+	    //requested density
+	    const size_t N = getRSAParticleCount();
+	    double simVol = 1.0;
+	    for (size_t iDim = 0; iDim < NDIM; ++iDim)
+	      simVol *= boxDimensions[iDim];
+	    const double diameter = std::cbrt(simVol * vm["density"].as<double>() / N);
+	    sysPack = rsaPackingHelper(std::vector<double>(N, diameter), boxDimensions, tmpPtr);
+	    break;
+	  }
 	default:
 	  M_throw() << "Not a valid packing type (--i1)";
 	}
@@ -3187,6 +3219,21 @@ namespace dynamo {
     return sysPack;;
   }
 
+  UCell*
+  IPPacker::rsaPackingHelper(const std::vector<double>& diameters, Vector boxDimensions, UCell* tmpPtr)
+  {
+    const uint64_t seed = std::uniform_int_distribution<uint64_t>()(Sim->ranGenerator);
+    return new CURandomSequentialAddition(diameters, boxDimensions, seed, std::thread::hardware_concurrency(), tmpPtr);
+  }
+
+  size_t
+  IPPacker::getRSAParticleCount()
+  {
+    //Place the same number of particles as an FCC packing would
+    std::array<long, 3> cells = getCells();
+    return 4 * cells[0] * cells[1] * cells[2];
+  }
+
   std::array<long, 3>
   IPPacker::getCells()
   {
@@ -3211,9 +3258,13 @@ namespace dynamo {
     //See http://mathworld.wolfram.com/SpherePointPicking.html
     std::normal_distribution<> normal_dist(0.0, (1.0 / sqrt(double(NDIM))));
 
+    //The velocity is always generated for the next particle to be
+    //added to the simulation, so the velocity is drawn from that
+    //particle's random stream.
+    counterRNG rng = Sim->getParticleRNG(Sim->particles.size());
     Vector  tmpVec;
     for (size_t iDim = 0; iDim < NDIM; iDim++)
-      tmpVec[iDim] = normal_dist(Sim->ranGenerator);
+      tmpVec[iDim] = normal_dist(rng);
 
     return tmpVec;
   }
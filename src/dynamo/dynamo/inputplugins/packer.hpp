@@ -42,6 +42,8 @@ namespace dynamo {
     Vector  getNormalisedCellDimensions();
     Vector  getRandVelVec();
     UCell* standardPackingHelper(UCell*, bool forceRectangular = false);
+    UCell* rsaPackingHelper(const std::vector<double>& diameters, Vector boxDimensions, UCell*);
+    size_t getRSAParticleCount();
 
     po::variables_map& vm;
   };
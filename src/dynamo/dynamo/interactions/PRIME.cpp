@@ -66,11 +66,71 @@ namespace dynamo {
   IPRIME::initialise(size_t nID)
   {
     Interaction::initialise(nID);
+
+    //The tables may already have been shared by another simulation
+    if (_beadData && (_beadData->size() == Sim->N()))
+      {
+	ICapture::initCaptureMap();
+	return;
+      }
+
+    //Flatten the bead data of the topology into an array for fast
+    //lookups
+    std::vector<TPRIME::BeadData> beadData(Sim->N(), TPRIME::BeadData(TPRIME::GROUP_COUNT, std::numeric_limits<size_t>::max()));
+    for (const auto& entry : _topology->getBeadMap().left)
+      {
+	if (entry.first >= Sim->N())
+	  M_throw() << "Particle " << entry.first << " in the PRIME topology \"" << _topology->getName() << "\" does not exist";
+	beadData[entry.first] = entry.second;
+      }
+
+    //Build the pair parameter table using representative pairs of
+    //each class. The residue numbers are arbitrary, only their
+    //separations matter.
+    //The parameter tables cover all bead types except G
+    const size_t types = TPRIME::GROUP_COUNT - 1;
+    std::vector<PairParameters> pairTable(PAIR_CLASS_COUNT * types * types, PairParameters{0, 0, 0, true});
+    for (size_t t1(0); t1 < types; ++t1)
+      for (size_t t2(0); t2 < types; ++t2)
+	for (size_t res1(10); res1 < 13; ++res1)
+	  for (size_t res2 : {size_t(9), size_t(10), size_t(11), size_t(12), size_t(13), size_t(20)})
+	    {
+	      const TPRIME::BeadData p1Data(TPRIME::PRIME_residue_type(t1), res1), p2Data(TPRIME::PRIME_residue_type(t2), res2);
+	      const PairClass pairClass = getPairClass(p1Data, p2Data);
+	      PairParameters& entry = pairTable[(pairClass * types + t1) * types + t2];
+	      if ((pairClass == INVALID) || !entry.calculate)
+		continue;
+
+	      //Backbone pairs which may take part in a H-bond depend on
+	      //the locations of the beads and the H-bond state
+	      if ((pairClass == SEPARATED) && (t1 <= TPRIME::CO) && (t2 <= TPRIME::CO) && !((t1 == TPRIME::CH) && (t2 == TPRIME::CH)))
+		continue;
+
+	      const auto params = calcInteractionParameters(p1Data, p2Data);
+	      entry = PairParameters{std::get<0>(params), std::get<1>(params), std::get<2>(params), false};
+	    }
+
+    _beadData.reset(new std::vector<TPRIME::BeadData>(std::move(beadData)));
+    _pairTable.reset(new std::vector<PairParameters>(std::move(pairTable)));
+
     ICapture::initCaptureMap();
 
     //Need to initialise the HBond map!
   }
 
+  void
+  IPRIME::shareImmutableData(const Interaction& interaction)
+  {
+    Interaction::shareImmutableData(interaction);
+
+    const IPRIME& other = static_cast<const IPRIME&>(interaction);
+    if (other._pairTable && (magnet::xml::toXMLString<Topology>(*_topology) == magnet::xml::toXMLString<Topology>(*other._topology)))
+      {
+	_beadData = other._beadData;
+	_pairTable = other._pairTable;
+      }
+  }
+
   size_t
   IPRIME::captureTest(const Particle& p1, const Particle& p2) const
   {
@@ -168,17 +228,62 @@ namespace dynamo {
     return maxdiam;
   }
 
+  IPRIME::PairClass
+  IPRIME::getPairClass(const TPRIME::BeadData& p1Data, const TPRIME::BeadData& p2Data)
+  {
+    const bool bb1 = p1Data.bead_type <= TPRIME::CO, bb2 = p2Data.bead_type <= TPRIME::CO;
+
+    if (bb1 && bb2)
+      {
+        const size_t loc1 = p1Data.bead_type + 3 * p1Data.residue;
+        const size_t loc2 = p2Data.bead_type + 3 * p2Data.residue;
+        const size_t distance = std::max(loc1, loc2) - std::min(loc1, loc2);
+	return PairClass(std::min(distance, size_t(SEPARATED)));
+      }
+    
+    if (bb1 == bb2) //SC-SC
+      return SEPARATED;
+
+    const TPRIME::BeadData& bb = bb1 ? p1Data : p2Data;
+    const TPRIME::BeadData& sc = bb1 ? p2Data : p1Data;
+    if (bb.residue == sc.residue)
+      return BONDED;
+    if (((sc.residue - 1 == bb.residue) && (bb.bead_type == TPRIME::CO))
+	|| ((sc.residue + 1 == bb.residue) && (bb.bead_type == TPRIME::NH)))
+      return THREE_BONDS;
+    return SEPARATED;
+  }
+
   std::tuple<double, double, double, size_t, size_t>
   IPRIME::getInteractionParameters(size_t pID1, size_t pID2) const
   {
-    TPRIME::BeadData p1Data = getBeadData(pID1);
-    TPRIME::BeadData p2Data = getBeadData(pID2);
-    
+    if (!_beadData)
+      return calcInteractionParameters(_topology->getBeadInfo(pID1), _topology->getBeadInfo(pID2));
+
+    const TPRIME::BeadData& p1Data = (*_beadData)[pID1];
+    const TPRIME::BeadData& p2Data = (*_beadData)[pID2];
+    const size_t types = TPRIME::GROUP_COUNT - 1;
+    const PairParameters& entry = (*_pairTable)[(getPairClass(p1Data, p2Data) * types + p1Data.bead_type) * types + p2Data.bead_type];
+
+    if (entry.calculate)
+      return calcInteractionParameters(p1Data, p2Data);
+
+#ifdef DYNAMO_DEBUG
+    if (calcInteractionParameters(_topology->getBeadInfo(pID1), _topology->getBeadInfo(pID2)) 
+	!= std::make_tuple(entry.outer_diameter, entry.inner_diameter, entry.bond_energy, std::numeric_limits<size_t>::max(), std::numeric_limits<size_t>::max()))
+      M_throw() << "The PRIME pair table does not match the calculated parameters for particles " << pID1 << " and " << pID2;
+#endif
+
+    const size_t no_HB_res = std::numeric_limits<size_t>::max();
+    return std::make_tuple(entry.outer_diameter, entry.inner_diameter, entry.bond_energy, no_HB_res, no_HB_res);
+  }
+
+  std::tuple<double, double, double, size_t, size_t>
+  IPRIME::calcInteractionParameters(TPRIME::BeadData p1Data, TPRIME::BeadData p2Data) const
+  {
     //Ensure that the first bead has the lowest bead_type (it simplifies the logic later)
-    if (p1Data.bead_type > p2Data.bead_type) {
-      std::swap(pID1, pID2);
+    if (p1Data.bead_type > p2Data.bead_type)
       std::swap(p1Data, p2Data);
-    }
 
     const size_t no_HB_res = std::numeric_limits<size_t>::max();
 
@@ -621,8 +726,9 @@ namespace dynamo {
     const TPRIME::BeadData p1Data = getBeadData(p1);
     const TPRIME::BeadData p2Data = getBeadData(p2);
 
-    //Calculate the interaction parameters (and name them sensibly)
-    const auto interaction_data = getInteractionParameters(p1.getID(), p2.getID());    
+    //Calculate the interaction parameters using the reference
+    //calculation (not the pair table), so that it is also validated
+    const auto interaction_data = calcInteractionParameters(_topology->getBeadInfo(p1.getID()), _topology->getBeadInfo(p2.getID()));    
     const double outer_diameter = std::get<0>(interaction_data),
       inner_diameter = std::get<1>(interaction_data),
       bond_energy = std::get<2>(interaction_data);
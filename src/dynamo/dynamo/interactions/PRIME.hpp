@@ -38,6 +38,11 @@ namespace dynamo {
 
     virtual void initialise(size_t);
 
+    /*! \brief Also shares the bead data and pair parameter tables if
+        the two topologies are identical.
+     */
+    virtual void shareImmutableData(const Interaction&);
+
     virtual size_t captureTest(const Particle&, const Particle&) const;
 
     virtual Event getEvent(const Particle&, const Particle&) const;
@@ -57,9 +62,14 @@ namespace dynamo {
 
   protected:
     /*! \brief Returns the type of the bead on the backbone.
+
+      Once initialised, this is read from the flat \ref _beadData
+      array instead of the topology's map.
      */
     TPRIME::BeadData getBeadData(const size_t particleID) const {
-      return _topology->getBeadInfo(particleID);
+      if (!_beadData)
+	return _topology->getBeadInfo(particleID);
+      return (*_beadData)[particleID];
     }
 
     void formHBond(const size_t NH_res, const size_t CO_res);
@@ -72,10 +82,55 @@ namespace dynamo {
      */
     std::tuple<double, double, double, size_t, size_t> getInteractionParameters(size_t pID1, size_t pID2) const;
 
+    /*! \brief Calculates the interaction parameters directly from
+        the bead data of the pair.
+
+      This is the reference calculation that \ref _pairTable is
+      built from, it is also used for the pairs whose parameters
+      depend on the H-bond state and to validate the configuration.
+     */
+    std::tuple<double, double, double, size_t, size_t> calcInteractionParameters(TPRIME::BeadData p1Data, TPRIME::BeadData p2Data) const;
+
     bool checkTimeDependentCriteria(const size_t NH_ID, const size_t CO_ID, const size_t distance_i) const;
 
     std::shared_ptr<TPRIME> _topology;
 
+    /*! \brief The bead data of each particle, indexed by particle
+        ID (built in initialise()). 
+
+      This and the \ref _pairTable are never modified once built, so
+      they may be shared by identical simulations (see
+      shareImmutableData()).
+    */
+    shared_ptr<const std::vector<TPRIME::BeadData> > _beadData;
+
+    /*! \brief The classes of bead pairs that have distinct
+        interaction parameters.
+
+      Backbone-backbone pairs are classified by the number of bonds
+      between them along the backbone. Side chain-backbone pairs are
+      either on the same residue (BONDED), on neighbouring residues
+      which are three bonds apart (THREE_BONDS), or further apart.
+     */
+    enum PairClass { INVALID, BONDED, PSEUDOBONDED, THREE_BONDS, FOUR_BONDS, SEPARATED, PAIR_CLASS_COUNT };
+
+    static PairClass getPairClass(const TPRIME::BeadData& p1Data, const TPRIME::BeadData& p2Data);
+
+    //! \brief The precomputed interaction parameters of a pair class.
+    struct PairParameters {
+      double outer_diameter;
+      double inner_diameter;
+      double bond_energy;
+      //! If true, the parameters depend on more than the pair class
+      //! and must be calculated using calcInteractionParameters().
+      bool calculate;
+    };
+
+    /*! \brief The interaction parameters of every pair class,
+        indexed by (class, bead type 1, bead type 2).
+     */
+    shared_ptr<const std::vector<PairParameters> > _pairTable;
+
     /*! \brief Containers which stores the pairs of NH and CO
         particles currently within a H-Bond.
 
@@ -19,6 +19,7 @@
 #include <dynamo/particle.hpp>
 #include <dynamo/schedulers/scheduler.hpp>
 #include <dynamo/simulation.hpp>
+#include <dynamo/checkpoint.hpp>
 #include <magnet/xmlwriter.hpp>
 #include <magnet/xmlreader.hpp>
 
@@ -32,16 +33,25 @@ namespace dynamo {
 	_mapUninitialised = false;
 	clear();
 
-	for (const auto& p1 : Sim->particles)
-	  {
-	    std::unique_ptr<IDRange> ids(Sim->ptrScheduler->getParticleNeighbours(p1));
-	    for (size_t ID2 : *ids)
-	      if (ID2 != p1.getID())
-		{
-		  if (Sim->getInteraction(p1, Sim->particles[ID2]).get() == static_cast<const Interaction*>(this))
-		    testAddToCaptureMap(p1, Sim->particles[ID2]);
-		}
-	  }
+	//The pairs are tested in parallel, then added to the map in the
+	//order of a serial sweep so the map is built identically
+	Scheduler& scheduler = *Sim->ptrScheduler;
+	std::vector<std::vector<std::pair<detail::PairKey, size_t> > > captured(scheduler.parallelBatches(Sim->N(), threadSafeGetEvent()));
+	scheduler.parallelFor(Sim->N(), [&](const size_t batch, const size_t begin, const size_t end) {
+	    for (size_t ID1(begin); ID1 < end; ++ID1)
+	      {
+		const Particle& p1 = Sim->particles[ID1];
+		std::unique_ptr<IDRange> ids(scheduler.getParticleNeighbours(p1));
+		for (size_t ID2 : *ids)
+		  if ((ID2 != ID1) && (Sim->getInteraction(p1, Sim->particles[ID2]).get() == static_cast<const Interaction*>(this)))
+		    if (const size_t capval = captureTest(p1, Sim->particles[ID2]))
+		      captured[batch].push_back(std::make_pair(detail::PairKey(ID1, ID2), capval));
+	      }
+	  }, threadSafeGetEvent());
+
+	for (const auto& batch : captured)
+	  for (const auto& entry : batch)
+	    Map::operator[](entry.first) = entry.second;
       }
   }
 
@@ -104,4 +114,31 @@ namespace dynamo {
     return retval;
   }
 
+
+  void
+  ICapture::saveCheckpoint(std::ostream& os) const
+  {
+    checkpoint::write(os, uint64_t(Map::size()));
+    for (const auto& entry : static_cast<const Map&>(*this))
+      {
+	checkpoint::write(os, uint64_t(entry.first));
+	checkpoint::write(os, uint64_t(entry.second));
+      }
+  }
+
+  void
+  ICapture::loadCheckpoint(std::istream& is)
+  {
+    Map::clear();
+    uint64_t count;
+    checkpoint::read(is, count);
+    for (size_t i(0); i < count; ++i)
+      {
+	uint64_t key, value;
+	checkpoint::read(is, key);
+	checkpoint::read(is, value);
+	Map::operator[](detail::PairKey(key)) = value;
+      }
+    _mapUninitialised = false;
+  }
 }
@@ -201,6 +201,10 @@ namespace dynamo {
 
     void initCaptureMap();
 
+    virtual void saveCheckpoint(std::ostream&) const;
+
+    virtual void loadCheckpoint(std::istream&);
+
     virtual size_t captureTest(const Particle&, const Particle&) const = 0;
 
   protected:  
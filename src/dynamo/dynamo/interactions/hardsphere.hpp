@@ -65,6 +65,9 @@ namespace dynamo {
 
     virtual double maxIntDist() const;
 
+    //! The smallest diameter of any pair of particles.
+    double minIntDist() const { return _diameter->getMinValue(); }
+
     virtual double getExcludedVolume(size_t) const;
 
     virtual void rescaleLengths(double) {}
@@ -20,6 +20,7 @@
 #include <dynamo/species/species.hpp>
 #include <dynamo/simulation.hpp>
 #include <magnet/xmlreader.hpp>
+#include <magnet/xmlwriter.hpp>
 #include <cstring>
 
 namespace dynamo {
@@ -35,6 +36,13 @@ namespace dynamo {
     intName = XML.getAttribute("Name");
   }
 
+  void
+  Interaction::shareImmutableData(const Interaction& other)
+  {
+    if (magnet::xml::toXMLString(range) == magnet::xml::toXMLString(other.range))
+      range = other.range;
+  }
+
   bool 
   Interaction::isInteraction(const Event& coll) const
   { 
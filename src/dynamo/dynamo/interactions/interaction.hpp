@@ -169,6 +169,35 @@ namespace dynamo {
 
     virtual void outputData(magnet::xml::XmlStream&) const {}
 
+    /*! \brief Write any dynamic state of the Interaction to a binary
+        checkpoint (see Simulation::writeCheckpoint()).
+     */
+    virtual void saveCheckpoint(std::ostream&) const {}
+
+    /*! \brief Restore the state written by saveCheckpoint(). */
+    virtual void loadCheckpoint(std::istream&) {}
+
+    /*! \brief Share the immutable data of an identically configured
+        Interaction of another Simulation (see
+        Simulation::shareImmutableData()).
+
+      Only data which is never modified after initialisation may be
+      shared, as the simulations may be run concurrently. By default,
+      the IDPairRange is shared if it is identical.
+     */
+    virtual void shareImmutableData(const Interaction& other);
+
+    /*! \brief Returns true if getEvent() may be called concurrently
+        from several threads (see Scheduler::addEvents()).
+
+      This requires that getEvent() does not modify any (mutable)
+      state of the Interaction. Interactions with lazily built caches
+      must override this. The same holds for the pair validateState()
+      and, for an ICapture, captureTest() which are also run
+      concurrently when the system is initialised.
+     */
+    virtual bool threadSafeGetEvent() const { return true; }
+
     enum GLYPH_TYPE
       {
 	SPHERE_GLYPH=0,
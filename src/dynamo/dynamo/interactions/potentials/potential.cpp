@@ -34,6 +34,39 @@ namespace dynamo {
 		<< ", Unknown type of Potential encountered";
   }
 
+  Potential::StepTable::StepTable(const Potential& potential, const size_t steps):
+    _steps(potential.steps()),
+    _direction(potential.direction()),
+    _complete(steps == potential.steps())
+  {
+    _r.reserve(steps);
+    _r2.reserve(steps);
+    _u.reserve(steps);
+    for (size_t i(0); i < steps; ++i)
+      {
+	const value_type step = potential[i];
+	_r.push_back(step.first);
+	_r2.push_back(step.first * step.first);
+	_u.push_back(step.second);
+      }
+  }
+
+  shared_ptr<const Potential::StepTable>
+  Potential::getStepTable(size_t minSteps) const
+  {
+    if (_table && (_table->complete() || (_table->size() >= minSteps)))
+      return _table;
+
+    //Tabulate every step of a finite potential, otherwise at least
+    //the steps that have already been calculated.
+    size_t tableSteps = steps();
+    if (tableSteps == std::numeric_limits<size_t>::max())
+      tableSteps = std::max(std::max(minSteps, cached_steps()), size_t(1));
+    
+    _table = shared_ptr<const StepTable>(new StepTable(*this, tableSteps));
+    return _table;
+  }
+
   magnet::xml::XmlStream& operator<<(magnet::xml::XmlStream& XML, 
 				     const Potential& g)
   {
@@ -20,6 +20,8 @@
 #include <cmath>
 #include <dynamo/base.hpp>
 #include <algorithm>
+#include <functional>
+#include <limits>
 
 namespace magnet { namespace xml { class Node; class XmlStream; } }
 
@@ -48,6 +50,84 @@ namespace dynamo {
   public:    
     typedef std::pair<double, double> value_type;
 
+    /*! \brief An immutable table of the steps of a Potential.
+
+      Unlike the step cache of the Potential, the table is never
+      modified once built, so lookups need no range checks and the
+      table can be shared by every Interaction using the Potential.
+      The squared discontinuity positions are also stored, allowing
+      the step of a pair to be found from its squared separation
+      (avoiding a sqrt) using a binary search.
+
+      Potentials with an unbounded number of steps (e.g., the
+      energy-stepped Lennard-Jones potential) are tabulated up to a
+      finite step, and a larger table must be requested from
+      Potential::getStepTable() if a step beyond the end of the table
+      is needed (see complete()).
+     */
+    class StepTable {
+    public:
+      //! \brief Tabulate the first \p steps steps of the Potential.
+      StepTable(const Potential& potential, size_t steps);
+
+      //! \brief The number of tabulated steps.
+      size_t size() const { return _r.size(); }
+
+      //! \brief True if the table contains all steps of the Potential.
+      bool complete() const { return _complete; }
+
+      /*! \brief Determine the step ID of a squared (unit-less)
+          separation.
+
+	If the table is not complete() and size() is returned, then
+	the step lies beyond the end of the table.
+       */
+      size_t calculateStepID(const double r2) const {
+	if (_direction)
+	  return std::lower_bound(_r2.begin(), _r2.end(), r2) - _r2.begin();
+	else
+	  return std::lower_bound(_r2.begin(), _r2.end(), r2, std::greater<double>()) - _r2.begin();
+      }
+
+      /*! \brief Return the min-max bounds of the step ID given (see
+          Potential::getStepBounds()).
+       */
+      std::pair<double, double> getStepBounds(const size_t ID) const {
+#ifdef DYNAMO_DEBUG
+	if ((ID > size()) || (!_complete && (ID == size()))) M_throw() << "Out of range access";
+#endif
+	if (_direction)
+	  return std::pair<double, double>((ID == 0) ? 0 : _r[ID - 1], (ID == _steps) ? std::numeric_limits<float>::infinity() : _r[ID]);
+	else
+	  return std::pair<double, double>((ID == _steps) ? 0 : _r[ID], (ID == 0) ? std::numeric_limits<float>::infinity() : _r[ID - 1]);
+      }
+
+      //! \brief The energy of a step ID.
+      double getEnergy(const size_t ID) const { return (ID == 0) ? 0 : _u[ID - 1]; }
+
+      /*! \brief The energy change on moving between two steps (see
+	Potential::getEnergyChange()).
+       */
+      double getEnergyChange(const size_t orig_step_ID, const size_t new_step_ID) const
+      { return getEnergy(new_step_ID) - getEnergy(orig_step_ID); }
+
+    private:
+      std::vector<double> _r;
+      std::vector<double> _r2;
+      std::vector<double> _u;
+      size_t _steps;
+      bool _direction;
+      bool _complete;
+    };
+
+    /*! \brief Returns the step table of this Potential.
+
+      The table is built on the first call and shared by all callers.
+      A new (larger) table is only built if the current table is
+      incomplete and has fewer than \p minSteps steps.
+     */
+    shared_ptr<const StepTable> getStepTable(size_t minSteps = 0) const;
+
     /*! \brief Accessor to give a value_type containing the
         discontinuity location and energy change.
 
@@ -102,11 +182,21 @@ namespace dynamo {
         corresponds to.
     */
     size_t calculateStepID(const double r) const {
-      size_t retval(0);
-      if (direction())
-	for (; (retval < steps()) && (r > operator[](retval).first); ++retval) {}
-      else
-	for (; (retval < steps()) && (r < operator[](retval).first); ++retval) {}
+      return calculateStepIDSq(r * r);
+    }
+
+    /*! \brief Determine which step in the potential the passed
+        squared radius corresponds to.
+    */
+    size_t calculateStepIDSq(const double r2) const {
+      if (!_table) getStepTable();
+      size_t retval = _table->calculateStepID(r2);
+      //Extend the table until the step is found
+      while (!_table->complete() && (retval == _table->size()))
+	{
+	  getStepTable(2 * _table->size());
+	  retval = _table->calculateStepID(r2);
+	}
       return retval;
     }
 
@@ -217,6 +307,7 @@ namespace dynamo {
 
     mutable std::vector<double> _r_cache;
     mutable std::vector<double> _u_cache;
+    mutable shared_ptr<const StepTable> _table;
   };
 
   /*! \brief A manually stepped potential.
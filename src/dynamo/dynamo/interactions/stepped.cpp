@@ -79,9 +79,42 @@ namespace dynamo {
   IStepped::initialise(size_t nID)
   {
     Interaction::initialise(nID);
+
+    //Share the potential (and its step table) with any earlier
+    //Interaction which uses an identical potential.
+    const std::string potentialXML = magnet::xml::toXMLString(_potential);
+    for (const shared_ptr<Interaction>& interaction : Sim->interactions)
+      {
+	if (interaction.get() == this) break;
+	const shared_ptr<IStepped> other = std::dynamic_pointer_cast<IStepped>(interaction);
+	if (!other || (other->_potential == _potential)) continue;
+	if (potentialXML == magnet::xml::toXMLString(other->_potential))
+	  {
+	    _potential = other->_potential;
+	    break;
+	  }
+      }
+
+    _steps = _potential->getStepTable();
     ICapture::initCaptureMap();
   }
 
+  void
+  IStepped::shareImmutableData(const Interaction& interaction)
+  {
+    Interaction::shareImmutableData(interaction);
+
+    //Potentials with an unbounded number of steps extend their step
+    //table as the simulation runs, so they cannot be shared.
+    const IStepped& other = static_cast<const IStepped&>(interaction);
+    if (other._steps && other._steps->complete()
+	&& (magnet::xml::toXMLString(_potential) == magnet::xml::toXMLString(other._potential)))
+      {
+	_potential = other._potential;
+	_steps = other._steps;
+      }
+  }
+
   size_t 
   IStepped::captureTest(const Particle& p1, const Particle& p2) const
   {
@@ -92,7 +125,7 @@ namespace dynamo {
     Vector rij = p1.getPosition() - p2.getPosition();
     Sim->BCs->applyBC(rij);
     
-    return _potential->calculateStepID(rij.nrm() / length_scale);
+    return _potential->calculateStepIDSq(rij.nrm2() / (length_scale * length_scale));
   }
 
   double 
@@ -110,7 +143,7 @@ namespace dynamo {
     size_t capstat = ICapture::operator[](ICapture::key_type(p1, p2));
     if (capstat == 0) return 0;
     const double energy_scale = _energyScale->getProperty(p1, p2);
-    return (*_potential)[capstat - 1].second * energy_scale;
+    return getSteps(capstat).getEnergy(capstat) * energy_scale;
   }
 
   Event
@@ -129,7 +162,7 @@ namespace dynamo {
 #endif 
 
     const size_t current_step_ID = ICapture::operator[](ICapture::key_type(p1, p2));
-    const std::pair<double, double> step_bounds = _potential->getStepBounds(current_step_ID);
+    const std::pair<double, double> step_bounds = getSteps(current_step_ID).getStepBounds(current_step_ID);
     const double length_scale = _lengthScale->getProperty(p1, p2);
 
     Event retval(p1, std::numeric_limits<float>::infinity(), INTERACTION, NONE, ID, p2);
@@ -159,7 +192,8 @@ namespace dynamo {
     const double energy_scale = _energyScale->getProperty(p1, p2);
 
     const size_t old_step_ID = ICapture::operator[](ICapture::key_type(p1, p2));
-    const std::pair<double, double> step_bounds = _potential->getStepBounds(old_step_ID);
+    const Potential::StepTable& steps = getSteps(old_step_ID + 1);
+    const std::pair<double, double> step_bounds = steps.getStepBounds(old_step_ID);
 
     size_t new_step_ID;
     size_t edge_ID;
@@ -184,7 +218,7 @@ namespace dynamo {
 	M_throw() << "Unknown event type";
       } 
 
-    PairEventData retVal = Sim->dynamics->SphereWellEvent(iEvent, _potential->getEnergyChange(new_step_ID, old_step_ID) * energy_scale, diameter * diameter, new_step_ID);
+    PairEventData retVal = Sim->dynamics->SphereWellEvent(iEvent, steps.getEnergyChange(new_step_ID, old_step_ID) * energy_scale, diameter * diameter, new_step_ID);
     EdgeData& data = _edgedata[std::pair<size_t, EEventType>(edge_ID, retVal.getType())];
     ++data.counter;
     data.rdotv_sum += retVal.rvdot;
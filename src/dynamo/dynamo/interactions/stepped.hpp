@@ -49,7 +49,18 @@ namespace dynamo {
 
     virtual void initialise(size_t);
 
+    /*! \brief Also shares the Potential and its step table, if they
+        are identical and the step table is complete (and so is never
+        rebuilt).
+     */
+    virtual void shareImmutableData(const Interaction&);
+
     virtual Event getEvent(const Particle&, const Particle&) const;
+
+    /*! \brief The step table is only safe to read concurrently once
+        it is complete, otherwise getSteps() may extend it.
+     */
+    virtual bool threadSafeGetEvent() const { return _steps && _steps->complete(); }
   
     virtual PairEventData runEvent(Particle&, Particle&, Event);
   
@@ -71,6 +82,18 @@ namespace dynamo {
     shared_ptr<Property> _energyScale;
 
     shared_ptr<Potential> _potential;
+
+    //! The step table of the potential, see getSteps().
+    mutable shared_ptr<const Potential::StepTable> _steps;
+
+    /*! \brief Returns a step table of the potential which includes
+        the step ID passed.
+     */
+    const Potential::StepTable& getSteps(const size_t ID) const {
+      if (!_steps || (!_steps->complete() && (ID >= _steps->size())))
+	_steps = _potential->getStepTable(2 * (ID + 1));
+      return *_steps;
+    }
     
     struct EdgeData {
       EdgeData(): counter(0), rdotv_sum(0) {}
@@ -37,6 +37,13 @@ namespace dynamo {
     range(nR)
   {}
 
+  void
+  Local::shareImmutableData(const Local& other)
+  {
+    if (magnet::xml::toXMLString(range) == magnet::xml::toXMLString(other.range))
+      range = other.range;
+  }
+
   bool 
   Local::isInteraction(const Particle &p1) const
   {
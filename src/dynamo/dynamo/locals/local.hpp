@@ -78,6 +78,22 @@ namespace dynamo {
 
     virtual void outputData(magnet::xml::XmlStream&) const {}
 
+    /*! \brief Write any dynamic state of the Local to a binary
+        checkpoint (see Simulation::writeCheckpoint()).
+     */
+    virtual void saveCheckpoint(std::ostream&) const {}
+
+    /*! \brief Restore the state written by saveCheckpoint(). */
+    virtual void loadCheckpoint(std::istream&) {}
+
+    /*! \brief Share the immutable data of an identically configured
+        Local of another Simulation (see
+        Simulation::shareImmutableData()).
+
+      By default, the IDRange is shared if it is identical.
+     */
+    virtual void shareImmutableData(const Local& other);
+
   protected:
     virtual void outputXML(magnet::xml::XmlStream&) const = 0;
 
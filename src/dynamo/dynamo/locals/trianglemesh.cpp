@@ -22,6 +22,7 @@
 #include <dynamo/units/units.hpp>
 #include <dynamo/schedulers/scheduler.hpp>
 #include <dynamo/outputplugins/outputplugin.hpp>
+#include <magnet/xmlwriter.hpp>
 
 
 namespace dynamo {
@@ -42,13 +43,13 @@ namespace dynamo {
 
     std::pair<double, size_t> tmin(std::numeric_limits<float>::infinity(), 0); //Default to no collision
 
-    for (size_t id(0); id < _elements.size(); ++id)
+    for (size_t id(0); id < _elements->size(); ++id)
       {
 	std::pair<double, size_t> t 
 	  = Sim->dynamics->getSphereTriangleEvent(part,
-						  _vertices[std::get<0>(_elements[id])],
-						  _vertices[std::get<1>(_elements[id])],
-						  _vertices[std::get<2>(_elements[id])],
+						  (*_vertices)[std::get<0>((*_elements)[id])],
+						  (*_vertices)[std::get<1>((*_elements)[id])],
+						  (*_vertices)[std::get<2>((*_elements)[id])],
 						  diam);
 	if (t < tmin) { tmin = t; triangleid = id; }
       }
@@ -64,11 +65,11 @@ namespace dynamo {
     const size_t triangleID = iEvent._additionalData1 / Dynamics::T_COUNT;
     const size_t trianglepart = iEvent._additionalData1 % Dynamics::T_COUNT;
 
-    const TriangleElements& elem = _elements[triangleID];
+    const TriangleElements& elem = (*_elements)[triangleID];
   
-    const Vector& A(_vertices[std::get<0>(elem)]);
-    const Vector& B(_vertices[std::get<1>(elem)]);
-    const Vector& C(_vertices[std::get<2>(elem)]);
+    const Vector& A((*_vertices)[std::get<0>(elem)]);
+    const Vector& B((*_vertices)[std::get<1>(elem)]);
+    const Vector& C((*_vertices)[std::get<2>(elem)]);
     
     //Run the collision and catch the data
     Vector normal;
@@ -150,6 +151,9 @@ namespace dynamo {
 
     localName = XML.getAttribute("Name");
 
+    std::vector<Vector> vertices;
+    std::vector<TriangleElements> elements;
+
     {//Load the vertex coordinates
       std::istringstream is(XML.getNode("Vertices").getValue());
       is.exceptions(std::ostringstream::badbit | std::ostringstream::failbit);
@@ -164,7 +168,7 @@ namespace dynamo {
 	  if (is.eof()) M_throw() << "The vertex coordinates is not a multiple of 3";
 
 	  is >> tmp[2];	  
-	  _vertices.push_back(tmp * Sim->units.unitLength());
+	  vertices.push_back(tmp * Sim->units.unitLength());
 	}
     }
 
@@ -184,22 +188,38 @@ namespace dynamo {
 
 	  is >> std::get<2>(tmp);
 
-	  if ((std::get<0>(tmp) >= _vertices.size()) 
-	      || (std::get<1>(tmp) >= _vertices.size()) 
-	      || (std::get<2>(tmp) >= _vertices.size()))
-	    M_throw() << "Triangle " << _elements.size() << " has an out of range vertex ID";
+	  if ((std::get<0>(tmp) >= vertices.size()) 
+	      || (std::get<1>(tmp) >= vertices.size()) 
+	      || (std::get<2>(tmp) >= vertices.size()))
+	    M_throw() << "Triangle " << elements.size() << " has an out of range vertex ID";
 
 	  Vector normal
-	    = (_vertices[std::get<1>(tmp)] - _vertices[std::get<0>(tmp)])
-	    ^ (_vertices[std::get<2>(tmp)] - _vertices[std::get<1>(tmp)]);
+	    = (vertices[std::get<1>(tmp)] - vertices[std::get<0>(tmp)])
+	    ^ (vertices[std::get<2>(tmp)] - vertices[std::get<1>(tmp)]);
 
 	  if (normal.nrm() == 0) 
-	    M_throw() << "Triangle " << _elements.size() << " has a zero normal!";
+	    M_throw() << "Triangle " << elements.size() << " has a zero normal!";
 
 
-	  _elements.push_back(tmp);
+	  elements.push_back(tmp);
 	}
     }
+
+    _vertices.reset(new std::vector<Vector>(std::move(vertices)));
+    _elements.reset(new std::vector<TriangleElements>(std::move(elements)));
+  }
+
+  void
+  LTriangleMesh::shareImmutableData(const Local& local)
+  {
+    Local::shareImmutableData(local);
+
+    const LTriangleMesh& other = static_cast<const LTriangleMesh&>(local);
+    if (magnet::xml::toXMLString<Local>(*this) == magnet::xml::toXMLString<Local>(other))
+      {
+	_vertices = other._vertices;
+	_elements = other._elements;
+      }
   }
 
   void 
@@ -212,14 +232,14 @@ namespace dynamo {
 	<< range;
 
     XML << magnet::xml::tag("Vertices") << magnet::xml::chardata();
-    for (Vector vert : _vertices)
+    for (Vector vert : *_vertices)
       XML << vert[0] / Sim->units.unitLength() << " " 
 	  << vert[1] / Sim->units.unitLength() << " "
 	  << vert[2] / Sim->units.unitLength() << "\n";
     XML << magnet::xml::endtag("Vertices");
 
     XML << magnet::xml::tag("Elements") << magnet::xml::chardata();
-    for (TriangleElements elements : _elements)
+    for (TriangleElements elements : *_elements)
       XML << std::get<0>(elements) << " " 
 	  << std::get<1>(elements) << " "
 	  << std::get<2>(elements) << "\n";
@@ -234,8 +254,8 @@ namespace dynamo {
     if (!_renderObj)
       {
 	std::vector<float> verts;
-	verts.reserve(3 * _vertices.size());
-	for (const Vector& v : _vertices)
+	verts.reserve(3 * _vertices->size());
+	for (const Vector& v : *_vertices)
 	  {
 	    verts.push_back(v[0]);
 	    verts.push_back(v[1]);
@@ -243,8 +263,8 @@ namespace dynamo {
 	  }
 
 	std::vector<GLuint> elems;
-	elems.reserve(3 * _elements.size());
-	for (const TriangleElements& e : _elements)
+	elems.reserve(3 * _elements->size());
+	for (const TriangleElements& e : *_elements)
 	  {
 	    elems.push_back(std::get<0>(e));
 	    elems.push_back(std::get<1>(e));
@@ -49,6 +49,9 @@ namespace dynamo {
 
     virtual bool validateState(const Particle& part, bool textoutput = true) const { return false; }
 
+    //! \brief Also shares the mesh if the two meshes are identical.
+    virtual void shareImmutableData(const Local&);
+
 #ifdef DYNAMO_visualizer
     virtual shared_ptr<coil::RenderObj> getCoilRenderObj() const;
     virtual void updateRenderData() const {}
@@ -61,10 +64,10 @@ namespace dynamo {
 
     virtual void outputXML(magnet::xml::XmlStream&) const;
 
-    std::vector<Vector> _vertices;
+    shared_ptr<const std::vector<Vector> > _vertices;
 
     typedef std::tuple<size_t, size_t, size_t> TriangleElements;
-    std::vector<TriangleElements> _elements;
+    shared_ptr<const std::vector<TriangleElements> > _elements;
 
     shared_ptr<Property> _e;
     shared_ptr<Property> _diameter;
@@ -24,14 +24,19 @@
 namespace dynamo {
   OPCollMatrix::OPCollMatrix(const dynamo::Simulation* tmp, const magnet::xml::Node&):
     OutputPlugin(tmp,"CollisionMatrix"),
-    totalCount(0)
+    totalCount(0),
+    counterSize(0)
   {
   }
 
   void 
   OPCollMatrix::initialise()
   {
-    lastEvent.resize(Sim->N(), lastEventData(Sim->systemTime, eventKey(classKey(0, NOSOURCE), NONE)));
+    eventIndex.initialise(Sim);
+    counterSize = 0;
+    counters.clear();
+    initialCounter.clear();
+    lastEvent.resize(Sim->N(), lastEventData(Sim->systemTime, EventIndex::NoID));
   }
 
   OPCollMatrix::~OPCollMatrix()
@@ -40,32 +45,48 @@ namespace dynamo {
   void 
   OPCollMatrix::eventUpdate(const Event& event, const NEventData& SDat)
   {
+    const classKey ck = getClassKey(event);
+
     for (const ParticleEventData& pData : SDat.L1partChanges)
-      newEvent(pData.getParticleID(), pData.getType(), getClassKey(event));  
+      newEvent(pData.getParticleID(), eventIndex.getID(ck, pData.getType()));
   
     for (const PairEventData& pData : SDat.L2partChanges)
       {
-	newEvent(pData.particle1_.getParticleID(), pData.getType(), getClassKey(event));
-	newEvent(pData.particle2_.getParticleID(), pData.getType(), getClassKey(event));
+	const size_t id = eventIndex.getID(ck, pData.getType());
+	newEvent(pData.particle1_.getParticleID(), id);
+	newEvent(pData.particle2_.getParticleID(), id);
       }
   }
 
   void 
-  OPCollMatrix::newEvent(const size_t& part, const EEventType& etype, const classKey& ck)
+  OPCollMatrix::newEvent(const size_t& part, const size_t& id)
   {
-    if (lastEvent[part].second.first.second != NOSOURCE)
+    //Grow the counters if a new type of event has been seen
+    if (eventIndex.size() > counterSize)
+      {
+	const size_t newSize = eventIndex.size();
+	std::vector<counterData> newCounters(newSize * newSize);
+	for (size_t i(0); i < counterSize; ++i)
+	  for (size_t j(0); j < counterSize; ++j)
+	    newCounters[i * newSize + j] = counters[i * counterSize + j];
+	counters.swap(newCounters);
+	initialCounter.resize(newSize, 0);
+	counterSize = newSize;
+      }
+
+    if (lastEvent[part].second != EventIndex::NoID)
       {
-	counterData& refCount = counters[counterKey(eventKey(ck,etype), lastEvent[part].second)];
+	counterData& refCount = counters[id * counterSize + lastEvent[part].second];
       
 	refCount.totalTime += Sim->systemTime - lastEvent[part].first;
 	++(refCount.count);
 	++(totalCount);
       }
     else
-      ++initialCounter[eventKey(ck,etype)];
+      ++initialCounter[id];
 
     lastEvent[part].first = Sim->systemTime;
-    lastEvent[part].second = eventKey(ck, etype);
+    lastEvent[part].second = id;
   }
 
   void
@@ -75,56 +96,61 @@ namespace dynamo {
     XML << magnet::xml::tag("CollCounters") 
 	<< magnet::xml::tag("TransitionMatrix");
   
-    std::map<eventKey, std::pair<size_t, double> > totmap;
-  
-    typedef std::pair<const counterKey, counterData> locPair;
-  
+    //The total count of each event ID
+    std::vector<size_t> totals(counterSize, 0);
   
     size_t initialsum(0);
+    for (const size_t n : initialCounter)
+      initialsum += n;
   
-    typedef std::pair<eventKey,size_t> npair;
-    for (const npair& n : initialCounter)
-      initialsum += n.second;
-  
-    for (const locPair& ele : counters)
-      {
-	XML << magnet::xml::tag("Count")
-	    << magnet::xml::attr("Event") << ele.first.first.second
-	    << magnet::xml::attr("Name") << getName(ele.first.first.first, Sim)
-	    << magnet::xml::attr("lastEvent") << ele.first.second.second
-	    << magnet::xml::attr("lastName") << getName(ele.first.second.first, Sim)
-	    << magnet::xml::attr("Percent") << 100.0 * ((double) ele.second.count) 
-	  / ((double) totalCount)
-	    << magnet::xml::attr("mft") << ele.second.totalTime
-	  / (Sim->units.unitTime() * ((double) ele.second.count))
-	    << magnet::xml::endtag("Count");
-      
-	//Add the total count
-	totmap[ele.first.first].first += ele.second.count;
+    const std::vector<size_t> ids = eventIndex.sortedIDs();
+    for (const size_t id : ids)
+      for (const size_t lastID : ids)
+	{
+	  if ((id >= counterSize) || (lastID >= counterSize))
+	    continue;
+
+	  const counterData& data = counters[id * counterSize + lastID];
+	  if (!data.count) continue;
+
+	  const EventIndex::Key& key = eventIndex.getKey(id);
+	  const EventIndex::Key& lastKey = eventIndex.getKey(lastID);
+	  XML << magnet::xml::tag("Count")
+	      << magnet::xml::attr("Event") << key.second
+	      << magnet::xml::attr("Name") << getName(key.first, Sim)
+	      << magnet::xml::attr("lastEvent") << lastKey.second
+	      << magnet::xml::attr("lastName") << getName(lastKey.first, Sim)
+	      << magnet::xml::attr("Percent") << 100.0 * ((double) data.count) 
+	    / ((double) totalCount)
+	      << magnet::xml::attr("mft") << data.totalTime
+	    / (Sim->units.unitTime() * ((double) data.count))
+	      << magnet::xml::endtag("Count");
       
-	//Add the rate
-	totmap[ele.first.first].second += ((double) ele.second.count) 
-	  / ele.second.totalTime;
-      }
+	  //Add the total count
+	  totals[id] += data.count;
+	}
   
     XML << magnet::xml::endtag("TransitionMatrix")
 	<< magnet::xml::tag("Totals");
   
-    typedef std::pair<eventKey, std::pair<size_t, double> > mappair;
-  
-    for (const mappair& mp1 : totmap)
-      XML << magnet::xml::tag("TotCount")
-	  << magnet::xml::attr("Name") << getName(mp1.first.first, Sim)
-	  << magnet::xml::attr("Event") << mp1.first.second
-	  << magnet::xml::attr("Percent") 
-	  << 100.0 * (((double) mp1.second.first)
-		      +((double) initialCounter[mp1.first]))
-      / (((double) totalCount) + ((double) initialsum))
-	  << magnet::xml::attr("Count") << mp1.second.first + initialCounter[mp1.first]
-	  << magnet::xml::attr("EventMeanFreeTime")
-	  << Sim->systemTime / ((mp1.second.first + initialCounter[mp1.first])
-			      * Sim->units.unitTime())
-	  << magnet::xml::endtag("TotCount");
+    for (const size_t id : ids)
+      {
+	if ((id >= counterSize) || !totals[id]) continue;
+
+	const EventIndex::Key& key = eventIndex.getKey(id);
+	XML << magnet::xml::tag("TotCount")
+	    << magnet::xml::attr("Name") << getName(key.first, Sim)
+	    << magnet::xml::attr("Event") << key.second
+	    << magnet::xml::attr("Percent") 
+	    << 100.0 * (((double) totals[id])
+			+((double) initialCounter[id]))
+	  / (((double) totalCount) + ((double) initialsum))
+	    << magnet::xml::attr("Count") << totals[id] + initialCounter[id]
+	    << magnet::xml::attr("EventMeanFreeTime")
+	    << Sim->systemTime / ((totals[id] + initialCounter[id])
+				* Sim->units.unitTime())
+	    << magnet::xml::endtag("TotCount");
+      }
   
     XML << magnet::xml::endtag("Totals")
 	<< magnet::xml::endtag("CollCounters");
@@ -19,7 +19,6 @@
 #include <dynamo/outputplugins/outputplugin.hpp>
 #include <dynamo/eventtypes.hpp>
 #include <dynamo/outputplugins/eventtypetracking.hpp>
-#include <map>
 #include <vector>
 
 namespace dynamo {
@@ -42,7 +41,7 @@ namespace dynamo {
     void output(magnet::xml::XmlStream &);
   
   protected:
-    void newEvent(const size_t&, const EEventType&, const classKey&);
+    void newEvent(const size_t&, const size_t&);
   
     struct counterData
     {
@@ -54,15 +53,23 @@ namespace dynamo {
   
     unsigned long totalCount;
 
-    typedef std::pair<classKey, EEventType> eventKey;
+    //! Assigns compact IDs to the (source, event type) of events.
+    EventIndex eventIndex;
 
-    typedef std::pair<eventKey, eventKey> counterKey;
-  
-    std::map<counterKey, counterData> counters;
+    //! The number of event IDs the counters are sized for.
+    size_t counterSize;
+
+    /*! The transition counters, stored as a dense square matrix
+        indexed by [ID of the event * counterSize + ID of the last
+        event].
+     */
+    std::vector<counterData> counters;
   
-    std::map<eventKey, size_t> initialCounter;
+    //! The count of the first event of each particle, indexed by event ID.
+    std::vector<size_t> initialCounter;
 
-    typedef std::pair<double, eventKey> lastEventData;
+    //! The time and event ID of the last event of a particle.
+    typedef std::pair<double, size_t> lastEventData;
 
     std::vector<lastEventData> lastEvent; 
   };
@@ -0,0 +1,137 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <dynamo/outputplugins/eventlog.hpp>
+#include <dynamo/units/units.hpp>
+#include <dynamo/NparticleEventData.hpp>
+#include <dynamo/simulation.hpp>
+#include <magnet/xmlwriter.hpp>
+#include <magnet/xmlreader.hpp>
+#include <algorithm>
+#include <cstring>
+
+namespace dynamo {
+  void
+  EventLogHeader::read(std::istream& is)
+  {
+    is.read(reinterpret_cast<char*>(this), sizeof(EventLogHeader));
+    if (!is || std::strncmp(fileMagic, magic(), sizeof(fileMagic)))
+      M_throw() << "Not a DynamO event log";
+
+    if (version != currentVersion)
+      M_throw() << "Unsupported event log version " << version << " (expected " << currentVersion << ")";
+
+    if (recordSize != sizeof(EventLogRecord))
+      M_throw() << "The event log record size (" << recordSize << ") does not match this build (" << sizeof(EventLogRecord) << ")";
+  }
+
+  OPEventLog::OPEventLog(const dynamo::Simulation* t1, const magnet::xml::Node& XML):
+    OutputPlugin(t1, "EventLog"),
+    _filename("eventlog.bin"),
+    _records(0)
+  {
+    if (XML.hasAttribute("File"))
+      _filename = XML.getAttribute("File").as<std::string>();
+  }
+
+  OPEventLog::~OPEventLog()
+  {
+    try { _writer.close(); }
+    catch (std::exception& e) { derr << e.what() << std::endl; }
+  }
+
+  void
+  OPEventLog::initialise()
+  {
+    _writer.open(_filename);
+    _records = 0;
+
+    EventLogHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::strncpy(header.fileMagic, EventLogHeader::magic(), sizeof(header.fileMagic));
+    header.version = EventLogHeader::currentVersion;
+    header.recordSize = sizeof(EventLogRecord);
+    header.startEventCount = Sim->eventCount;
+    header.startTime = Sim->systemTime / Sim->units.unitTime();
+    _writer.write(&header, sizeof(header));
+  }
+
+  void
+  OPEventLog::eventUpdate(const Event& eevent, const NEventData& SDat)
+  {
+    EventLogRecord record;
+    std::memset(&record, 0, sizeof(record));
+    record.eventCount = Sim->eventCount;
+    record.sourceID = eevent._sourceID;
+    record.p1 = record.p2 = EventLogRecord::NoParticle;
+    record.time = Sim->systemTime / Sim->units.unitTime();
+    record.dt = eevent._dt / Sim->units.unitTime();
+    record.source = eevent._source;
+    record.type = eevent._type;
+
+    const auto store = [](double* dest, const Vector& vec, const double unit) {
+      for (size_t i(0); i < 3; ++i)
+	dest[i] = vec[i] / unit;
+    };
+
+    if (SDat.L1partChanges.empty() && SDat.L2partChanges.empty())
+      {
+	_writer.write(&record, sizeof(record));
+	++_records;
+	return;
+      }
+
+    for (const ParticleEventData& pData : SDat.L1partChanges)
+      {
+	const Particle& part = Sim->particles[pData.getParticleID()];
+	const Vector delP = Sim->species[pData.getSpeciesID()]->getMass(part.getID()) * (part.getVelocity() - pData.getOldVel());
+	record.p1 = part.getID();
+	record.p2 = EventLogRecord::NoParticle;
+	record.particleType = pData.getType();
+	store(record.impulse, delP, Sim->units.unitMomentum());
+	store(record.vel1, part.getVelocity(), Sim->units.unitVelocity());
+	std::fill(record.vel2, record.vel2 + 3, 0.0);
+	_writer.write(&record, sizeof(record));
+	++_records;
+      }
+
+    for (const PairEventData& pData : SDat.L2partChanges)
+      {
+	const Particle& p1 = Sim->particles[pData.particle1_.getParticleID()];
+	const Particle& p2 = Sim->particles[pData.particle2_.getParticleID()];
+	record.p1 = p1.getID();
+	record.p2 = p2.getID();
+	record.particleType = pData.getType();
+	store(record.impulse, pData.impulse, Sim->units.unitMomentum());
+	store(record.vel1, p1.getVelocity(), Sim->units.unitVelocity());
+	store(record.vel2, p2.getVelocity(), Sim->units.unitVelocity());
+	_writer.write(&record, sizeof(record));
+	++_records;
+      }
+  }
+
+  void
+  OPEventLog::output(magnet::xml::XmlStream& XML)
+  {
+    _writer.flush();
+
+    XML << magnet::xml::tag("EventLog")
+	<< magnet::xml::attr("File") << _filename
+	<< magnet::xml::attr("Records") << _records
+	<< magnet::xml::endtag("EventLog");
+  }
+}
@@ -0,0 +1,131 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <dynamo/outputplugins/outputplugin.hpp>
+#include <magnet/stream/asyncwriter.hpp>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <string>
+
+namespace dynamo {
+  /*! \brief The header of a binary event log file (see OPEventLog).
+
+    All values are written in the native byte order of the machine.
+   */
+  struct EventLogHeader
+  {
+    //! \brief The magic string at the start of every event log.
+    static const char* magic() { return "DYNAMO_EVENTLOG"; }
+
+    //! \brief The current version of the file format.
+    static const uint32_t currentVersion = 1;
+
+    char fileMagic[16];
+    uint32_t version;
+    //! The size of each EventLogRecord (in bytes).
+    uint32_t recordSize;
+    //! The event count of the Simulation when logging began.
+    uint64_t startEventCount;
+    //! The system time of the Simulation when logging began.
+    double startTime;
+
+    //! \brief Reads and verifies the header of an event log.
+    void read(std::istream& is);
+  };
+
+  /*! \brief A fixed-size record of a binary event log (see
+      OPEventLog).
+
+    One record is written for each particle (or pair of particles)
+    changed by an event, and a single record with no particles is
+    written for events which change no particles. All values are in
+    the reduced units of the Simulation (as in the configuration
+    files).
+   */
+  struct EventLogRecord
+  {
+    //! \brief The particle ID used for unused particle entries.
+    static const uint64_t NoParticle = std::numeric_limits<uint64_t>::max();
+
+    //! The Simulation::eventCount of the event.
+    uint64_t eventCount;
+    //! The ID of the source of the event (e.g., the Interaction ID).
+    uint64_t sourceID;
+    //! The ID of the (first) particle changed by the event.
+    uint64_t p1;
+    //! The ID of the second particle of a pair change.
+    uint64_t p2;
+    //! The system time at the event.
+    double time;
+    //! The time since the previous event (as calculated by the event).
+    double dt;
+    //! The impulse (change in momentum) of particle \ref p1.
+    double impulse[3];
+    //! The velocity of particle \ref p1 after the event.
+    double vel1[3];
+    //! The velocity of particle \ref p2 after the event.
+    double vel2[3];
+    //! The EventSource of the event.
+    uint32_t source;
+    //! The EEventType of the event.
+    uint32_t type;
+    //! The EEventType of the particle change.
+    uint32_t particleType;
+    uint32_t padding;
+  };
+
+  /*! \brief Writes a compact binary log of every event.
+
+    This is a fast replacement for the OPTrajectory plugin. Each
+    event is stored as fixed-size EventLogRecord -s (containing the
+    event count, time, source, type, particle IDs, impulse and
+    post-event velocities). The records are collected in a buffer
+    which is written to the file on a background thread
+    (magnet::stream::AsyncFileWriter), so the cost to the simulation
+    is little more than a memory copy per event.
+
+    The log can be converted to the text format of OPTrajectory, or
+    filtered, and the particle trajectories replayed from the
+    starting configuration using the dynaeventlog program.
+
+    The file name is set with the "File" option (default
+    "eventlog.bin").
+   */
+  class OPEventLog: public OutputPlugin
+  {
+  public:
+    OPEventLog(const dynamo::Simulation*, const magnet::xml::Node&);
+
+    ~OPEventLog();
+
+    void eventUpdate(const Event&, const NEventData&);
+
+    virtual void replicaExchange(OutputPlugin&)
+    { M_throw() << "This output plugin hasn't been prepared for changes of system"; }
+
+    virtual void initialise();
+
+    virtual void output(magnet::xml::XmlStream&);
+
+  private:
+    magnet::stream::AsyncFileWriter _writer;
+    std::string _filename;
+    size_t _records;
+  };
+}
@@ -17,6 +17,7 @@
 #include <dynamo/outputplugins/eventtypetracking.hpp>
 #include <dynamo/simulation.hpp>
 #include <dynamo/include.hpp>
+#include <algorithm>
 
 namespace dynamo {
   namespace EventTypeTracking {
@@ -59,5 +60,52 @@ namespace dynamo {
     {
       return classKey(i._sourceID, i._source);
     }
+
+    const size_t EventIndex::NoID;
+
+    EventIndex::EventIndex():
+      _capacity(NOSOURCE + 1, 0),
+      _offsets(NOSOURCE + 2, 0)
+    {}
+
+    void EventIndex::initialise(const dynamo::Simulation* Sim)
+    {
+      _keys.clear();
+      std::fill(_capacity.begin(), _capacity.end(), 0);
+      _capacity[INTERACTION] = Sim->interactions.size();
+      _capacity[LOCAL] = Sim->locals.size();
+      _capacity[GLOBAL] = Sim->globals.size();
+      _capacity[SYSTEM] = Sim->systems.size();
+      rebuild();
+    }
+
+    void EventIndex::grow(EventSource source, size_t capacity)
+    {
+      if (size_t(source) > NOSOURCE)
+	M_throw() << "Event index found an unknown event class";
+
+      //Leave some space for further sources to be added
+      _capacity[source] = std::max(capacity, 2 * _capacity[source]);
+      rebuild();
+    }
+
+    void EventIndex::rebuild()
+    {
+      for (size_t s(0); s <= NOSOURCE; ++s)
+	_offsets[s + 1] = _offsets[s] + _capacity[s];
+
+      _ids.assign(_offsets.back() * FINAL_ENUM_TO_CATCH_THE_COMMA, NoID);
+      for (size_t id(0); id < _keys.size(); ++id)
+	_ids[(_offsets[_keys[id].first.second] + _keys[id].first.first) * FINAL_ENUM_TO_CATCH_THE_COMMA + _keys[id].second] = id;
+    }
+
+    std::vector<size_t> EventIndex::sortedIDs() const
+    {
+      std::vector<size_t> ids(_keys.size());
+      for (size_t id(0); id < ids.size(); ++id)
+	ids[id] = id;
+      std::sort(ids.begin(), ids.end(), [this](const size_t a, const size_t b) { return _keys[a] < _keys[b]; });
+      return ids;
+    }
   }
 }
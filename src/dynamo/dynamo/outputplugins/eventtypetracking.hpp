@@ -19,6 +19,8 @@
 #include <dynamo/eventtypes.hpp>
 #include <utility>
 #include <string>
+#include <vector>
+#include <limits>
 
 namespace dynamo
 {
@@ -35,5 +37,73 @@ namespace dynamo
     std::string getClass(const classKey&);
 
     classKey getClassKey(const Event&);
+
+    /*! \brief Maps the (source, event type) of events to a compact
+        integer ID.
+
+      This allows output plugins to store per-event-type data in flat
+      arrays, instead of walking a std::map for every event. The
+      lookup is a single array access into a table with an entry for
+      every source and event type. The IDs are assigned in the order
+      the event types are first seen, so the number of IDs is the
+      number of distinct event types which actually occur.
+
+      The table is sized for the sources of the Simulation when
+      initialise() is called, but grows if a source with a larger ID
+      is seen later (e.g., a System added after the output plugins
+      are initialised).
+     */
+    class EventIndex
+    {
+    public:
+      typedef std::pair<classKey, EEventType> Key;
+
+      //! \brief The value used for "no ID".
+      static const size_t NoID = std::numeric_limits<size_t>::max();
+
+      EventIndex();
+
+      //! \brief Clears all IDs and sizes the table for the sources of the Simulation.
+      void initialise(const dynamo::Simulation*);
+
+      //! \brief Returns the ID of an event type, assigning a new ID if it has not been seen before.
+      size_t getID(const classKey& key, const EEventType type)
+      {
+	if (key.first >= _capacity[key.second])
+	  grow(key.second, key.first + 1);
+
+	size_t& id = _ids[(_offsets[key.second] + key.first) * FINAL_ENUM_TO_CATCH_THE_COMMA + type];
+	if (id == NoID)
+	  {
+	    id = _keys.size();
+	    _keys.push_back(Key(key, type));
+	  }
+	return id;
+      }
+
+      size_t getID(const Event& event) { return getID(getClassKey(event), event._type); }
+
+      //! \brief Returns the source and event type of an ID.
+      const Key& getKey(const size_t id) const { return _keys[id]; }
+
+      //! \brief The number of IDs assigned.
+      size_t size() const { return _keys.size(); }
+
+      /*! \brief Returns all assigned IDs, sorted by their Key.
+
+	This gives the same ordering as a std::map<Key,...> and is used
+	to keep the output of the plugins stable.
+       */
+      std::vector<size_t> sortedIDs() const;
+
+    private:
+      void grow(EventSource, size_t);
+      void rebuild();
+
+      std::vector<size_t> _capacity;
+      std::vector<size_t> _offsets;
+      std::vector<size_t> _ids;
+      std::vector<Key> _keys;
+    };
   }
 }
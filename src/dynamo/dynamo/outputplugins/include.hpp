@@ -20,8 +20,10 @@
 #include <dynamo/outputplugins/eventtypetracking.hpp>
 #include <dynamo/outputplugins/msdOrientational.hpp>
 #include <dynamo/outputplugins/trajectory.hpp>
+#include <dynamo/outputplugins/eventlog.hpp>
 #include <dynamo/outputplugins/contactmap.hpp>
 #include <dynamo/outputplugins/misc.hpp>
 #include <dynamo/outputplugins/eventEffects.hpp>
 #include <dynamo/outputplugins/intEnergyHist.hpp>
 #include <dynamo/outputplugins/msd.hpp>
+#include <dynamo/outputplugins/profiler.hpp>
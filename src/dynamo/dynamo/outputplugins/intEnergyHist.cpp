@@ -127,12 +127,12 @@ namespace dynamo {
 	    << magnet::xml::attr("EnergyStep")
 	    << dynamics.getEnergyStep() * Sim->units.unitEnergy();
 	
-	typedef std::pair<const int, double> locpair;
-	for (const locpair& p1 : dynamics.getMap())
+	const std::vector<double>& table = dynamics.getTable();
+	for (size_t i(0); i < table.size(); ++i)
 	  XML << magnet::xml::tag("W")
 	      << magnet::xml::attr("Energy")
-	      << p1.first * dynamics.getEnergyStep() * Sim->units.unitEnergy()
-	      << magnet::xml::attr("Value") << p1.second
+	      << (static_cast<long>(i) + dynamics.getTableOffset()) * dynamics.getEnergyStep() * Sim->units.unitEnergy()
+	      << magnet::xml::attr("Value") << table[i]
 	      << magnet::xml::endtag("W");
 	
 	XML << magnet::xml::endtag("PotentialDeformation");
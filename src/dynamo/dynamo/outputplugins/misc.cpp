@@ -44,6 +44,7 @@ namespace dynamo {
     OPMisc& op = static_cast<OPMisc&>(misc2);
     
     std::swap(_counters, op._counters);
+    std::swap(_counterIndex, op._counterIndex);
     std::swap(_starttime, op._starttime);
     std::swap(_dualEvents, op._dualEvents);
     std::swap(_singleEvents, op._singleEvents);
@@ -175,6 +176,8 @@ namespace dynamo {
   {
     _KE.init(Sim->dynamics->getSystemKineticEnergy());
     _internalE.init(Sim->calcInternalEnergy());
+    _counters.clear();
+    _counterIndex.initialise(Sim);
 
     dout << "Particle Count " << Sim->N()
 	 << "\nSim Unit Length " << Sim->units.unitLength()
@@ -206,9 +209,10 @@ namespace dynamo {
     for (const auto& p1 : Sim->particles)
       {
 	std::unique_ptr<IDRange> ids(Sim->ptrScheduler->getParticleNeighbours(p1));
-	for (size_t ID2 : *ids)
-	  if (ID2 != p1.getID())
-	    _internalEnergy[p1.getID()] += 0.5 * Sim->getInteraction(p1, Sim->particles[ID2])->getInternalEnergy(p1, Sim->particles[ID2]);
+	ids->forEach([&](const size_t ID2) {
+	    if (ID2 != p1.getID())
+	      _internalEnergy[p1.getID()] += 0.5 * Sim->getInteraction(p1, Sim->particles[ID2])->getInternalEnergy(p1, Sim->particles[ID2]);
+	  });
       }
 
     for (const Particle& part : Sim->particles)
@@ -272,7 +276,10 @@ namespace dynamo {
   OPMisc::eventUpdate(const Event& eevent, const NEventData& NDat)
   {
     stream(eevent._dt);
-    CounterData& counterdata = _counters[CounterKey(getClassKey(eevent), eevent._type)];
+    const size_t counterID = _counterIndex.getID(eevent);
+    if (counterID >= _counters.size())
+      _counters.resize(counterID + 1);
+    CounterData& counterdata = _counters[counterID];
     counterdata.count += NDat.L1partChanges.size() + NDat.L2partChanges.size();
 
     Vector thermalDel({0,0,0});
@@ -407,6 +414,13 @@ namespace dynamo {
       /(Sim->units.unitTime() * ((2.0 * static_cast<double>(_dualEvents)) + static_cast<double>(_singleEvents)));
   }
 
+  double
+  OPMisc::getVirtualFraction() const
+  {
+    const double total = static_cast<double>(_singleEvents) + static_cast<double>(_dualEvents) + static_cast<double>(_virtualEvents);
+    return total ? _virtualEvents / total : 0;
+  }
+
   double 
   OPMisc::getDuration() const {
     return std::chrono::duration<double>(std::chrono::system_clock::now() - _starttime).count();
@@ -435,6 +449,7 @@ namespace dynamo {
 	 << "\nSimulation end time  " << Sim->systemTime / Sim->units.unitTime()
 	 << "\nAvg. events/s " << getEventsPerSecond()
 	 << "\nSim time per second " << getSimTimePerSecond()
+	 << "\nVirtual event fraction " << getVirtualFraction()
 	 << std::endl;
 
     const double V = Sim->getSimVolume();
@@ -535,28 +550,32 @@ namespace dynamo {
 	<< attr("OneParticleEvents") << _singleEvents
 	<< attr("TwoParticleEvents") << _dualEvents
 	<< attr("VirtualEvents") << _virtualEvents
+	<< attr("VirtualFraction") << getVirtualFraction()
 	<< attr("Time") << Sim->systemTime / Sim->units.unitTime()
 	<< endtag("Duration")
 
 	<< tag("EventCounters");
   
-    typedef std::pair<CounterKey, CounterData> mappair;
-    for (const mappair& mp1 : _counters)
-      XML << tag("Entry")
-	  << attr("Type") << getClass(mp1.first.first)
-	  << attr("Name") << getName(mp1.first.first, Sim)
-	  << attr("Event") << mp1.first.second
-	  << attr("Count") << mp1.second.count
-	  << tag("NetImpulse") 
-	  << mp1.second.netimpulse / Sim->units.unitMomentum()
-	  << endtag("NetImpulse")
-	  << tag("NetKEChange")
-	  << attr("Value") << mp1.second.netKEchange / Sim->units.unitEnergy()
-	  << endtag("NetKEChange")
-	  << tag("NetUChange")
-	  << attr("Value") << mp1.second.netUchange / Sim->units.unitEnergy()
-	  << endtag("NetUChange")
-	  << endtag("Entry");
+    for (const size_t id : _counterIndex.sortedIDs())
+      {
+	const EventIndex::Key& key = _counterIndex.getKey(id);
+	const CounterData& data = _counters[id];
+	XML << tag("Entry")
+	    << attr("Type") << getClass(key.first)
+	    << attr("Name") << getName(key.first, Sim)
+	    << attr("Event") << key.second
+	    << attr("Count") << data.count
+	    << tag("NetImpulse") 
+	    << data.netimpulse / Sim->units.unitMomentum()
+	    << endtag("NetImpulse")
+	    << tag("NetKEChange")
+	    << attr("Value") << data.netKEchange / Sim->units.unitEnergy()
+	    << endtag("NetKEChange")
+	    << tag("NetUChange")
+	    << attr("Value") << data.netUchange / Sim->units.unitEnergy()
+	    << endtag("NetUChange")
+	    << endtag("Entry");
+      }
     
     XML << endtag("EventCounters")
 
@@ -22,7 +22,7 @@
 #include <magnet/math/timeaveragedproperty.hpp>
 #include <magnet/math/correlators.hpp>
 #include <chrono>
-#include <map>
+#include <vector>
 
 namespace dynamo {
   using namespace EventTypeTracking;
@@ -48,6 +48,8 @@ namespace dynamo {
     double getDuration() const;
     double getEventsPerSecond() const;
     double getSimTimePerSecond() const;
+    //! The fraction of the processed events which were virtual.
+    double getVirtualFraction() const;
 
     void temperatureRescale(const double&);
 
@@ -69,8 +71,6 @@ namespace dynamo {
   protected:
     void stream(double dt);
 
-    typedef std::pair<classKey, EEventType> CounterKey;
-
     struct CounterData
     {
       CounterData(): count(0), netimpulse({0,0,0}), netKEchange(0), netUchange(0) {}
@@ -80,7 +80,9 @@ namespace dynamo {
       double netUchange;
     };
 
-    std::map<CounterKey, CounterData> _counters;
+    //! The event counters, indexed by the IDs of _counterIndex.
+    std::vector<CounterData> _counters;
+    EventIndex _counterIndex;
     std::chrono::system_clock::time_point _starttime;
     unsigned long _dualEvents;
     unsigned long _singleEvents;
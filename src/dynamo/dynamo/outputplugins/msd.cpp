@@ -86,8 +86,7 @@ namespace dynamo {
   {
     double acc = 0.0;
 
-    for (const size_t ID : range)
-      acc += (Sim->particles[ID].getPosition() - initPos[ID]).nrm2();
+    range.forEach([&](const size_t ID) { acc += (Sim->particles[ID].getPosition() - initPos[ID]).nrm2(); });
   
     return acc / range.size();
   }
@@ -105,13 +104,15 @@ namespace dynamo {
     Sim->dynamics->updateAllParticles();
 
     double acc = 0.0;
-    for (const shared_ptr<IDRange>& molRange : Itop.getMolecules())
+    for (size_t m(0); m < Itop.getMoleculeCount(); ++m)
       {
+	const IDRange::Block molecule = Itop.getMolecule(m);
 	Vector origPos{0,0,0}, currPos{0,0,0};
 	double totmass = 0.0;
-	for (const unsigned long& ID : *molRange)
+	for (size_t i(0); i < molecule.count; ++i)
 	  {
-	    double pmass = Sim->species[Sim->particles[ID]]->getMass(ID);
+	    const size_t ID = molecule[i];
+	    double pmass = Sim->species(Sim->particles[ID])->getMass(ID);
 
 	    totmass += pmass;
 	    currPos += Sim->particles[ID].getPosition() * pmass;
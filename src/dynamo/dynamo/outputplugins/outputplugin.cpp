@@ -123,6 +123,8 @@ namespace dynamo {
       return testGeneratePlugin<OPCTorsion>(Sim, XML);
     else if (!Name.compare("Misc"))
       return testGeneratePlugin<OPMisc>(Sim, XML);
+    else if (!Name.compare("Profiler"))
+      return testGeneratePlugin<OPProfiler>(Sim, XML);
     else if (!Name.compare("CollisionMatrix"))
       return testGeneratePlugin<OPCollMatrix>(Sim, XML);
     else if (!Name.compare("ContactMap"))
@@ -135,6 +137,8 @@ namespace dynamo {
       return testGeneratePlugin<OPChainBondAngles>(Sim, XML);
     else if (!Name.compare("Trajectory"))
       return testGeneratePlugin<OPTrajectory>(Sim, XML);
+    else if (!Name.compare("EventLog"))
+      return testGeneratePlugin<OPEventLog>(Sim, XML);
     else if (!Name.compare("ChainBondLength"))
       return testGeneratePlugin<OPChainBondLength>(Sim, XML);
     else if (!Name.compare("VelDist"))
@@ -0,0 +1,115 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <dynamo/outputplugins/profiler.hpp>
+#include <dynamo/outputplugins/eventtypetracking.hpp>
+#include <dynamo/simulation.hpp>
+#include <magnet/xmlwriter.hpp>
+#include <magnet/timer.hpp>
+
+namespace dynamo {
+  OPProfiler::OPProfiler(const dynamo::Simulation* tmp, const magnet::xml::Node&):
+    OutputPlugin(tmp, "Profiler"),
+    _startTicks(0)
+  {}
+
+  void
+  OPProfiler::initialise()
+  {
+    _profile = shared_ptr<Scheduler::Profile>(new Scheduler::Profile);
+    _profile->eventIndex.initialise(Sim);
+    Sim->ptrScheduler->setProfile(_profile);
+    _startTime = std::chrono::steady_clock::now();
+    _startTicks = magnet::cputicks();
+  }
+
+  void
+  OPProfiler::output(magnet::xml::XmlStream& XML)
+  {
+    using namespace magnet::xml;
+
+    const uint64_t totalTicks = magnet::cputicks() - _startTicks;
+    const double duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - _startTime).count();
+    //Calibrate the tick counter against the wall clock
+    const double secondsPerTick = totalTicks ? duration / totalTicks : 0;
+
+    size_t executedEvents(0);
+    for (const Scheduler::Profile::Counter& counter : _profile->events)
+      executedEvents += counter.count;
+
+    XML << tag("Profiler")
+	<< attr("Duration") << duration
+	<< attr("Ticks") << totalTicks
+	<< attr("TicksPerSecond") << (duration > 0 ? totalTicks / duration : 0);
+
+    XML << tag("Events");
+    for (const size_t id : _profile->eventIndex.sortedIDs())
+      {
+	const EventTypeTracking::EventIndex::Key& key = _profile->eventIndex.getKey(id);
+	const Scheduler::Profile::Counter& counter = _profile->events[id];
+	XML << tag("Event")
+	    << attr("Name") << EventTypeTracking::getName(key.first, Sim)
+	    << attr("Source") << EventTypeTracking::getClass(key.first)
+	    << attr("Type") << key.second
+	    << attr("Count") << counter.count
+	    << attr("Seconds") << counter.ticks * secondsPerTick
+	    << attr("MeanTicks") << double(counter.ticks) / counter.count
+	    << attr("Fraction") << double(counter.ticks) / totalTicks
+	    << endtag("Event");
+      }
+    XML << endtag("Events");
+
+    const auto writeCounter = [&](const char* name, const Scheduler::Profile::Counter& counter) {
+      XML << tag(name)
+	  << attr("Count") << counter.count
+	  << attr("Seconds") << counter.ticks * secondsPerTick
+	  << attr("MeanTicks") << (counter.count ? double(counter.ticks) / counter.count : 0)
+	  << attr("Fraction") << double(counter.ticks) / totalTicks
+	  << attr("PerEvent") << (executedEvents ? double(counter.count) / executedEvents : 0)
+	  << endtag(name);
+    };
+
+    writeCounter("Recalculations", _profile->recalculations);
+    writeCounter("InteractionRejections", _profile->interactionRejections);
+    writeCounter("LocalRejections", _profile->localRejections);
+    writeCounter("FullUpdates", _profile->fullUpdates);
+
+    size_t scans(0), scanned(0);
+    for (size_t length(0); length < _profile->neighbourScans.size(); ++length)
+      {
+	scans += _profile->neighbourScans[length];
+	scanned += length * _profile->neighbourScans[length];
+      }
+
+    XML << tag("NeighbourScans")
+	<< attr("Count") << scans
+	<< attr("Mean") << (scans ? double(scanned) / scans : 0)
+	<< attr("Max") << (_profile->neighbourScans.empty() ? 0 : _profile->neighbourScans.size() - 1);
+    for (size_t length(0); length < _profile->neighbourScans.size(); ++length)
+      if (_profile->neighbourScans[length])
+	XML << tag("Bin")
+	    << attr("Length") << length
+	    << attr("Count") << _profile->neighbourScans[length]
+	    << endtag("Bin");
+    XML << endtag("NeighbourScans");
+
+    XML << tag("Sorter")
+	<< attr("OverflowEvents") << Sim->ptrScheduler->getSorter()->overflowCount()
+	<< endtag("Sorter")
+	<< endtag("Profiler");
+  }
+}
@@ -0,0 +1,56 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <dynamo/outputplugins/outputplugin.hpp>
+#include <dynamo/schedulers/scheduler.hpp>
+#include <chrono>
+
+namespace dynamo {
+  /*! \brief A profiler of the event loop.
+
+    This plugin attaches a Scheduler::Profile to the Scheduler, which
+    then times every event it processes using the CPU tick counter
+    (see magnet::cputicks()). The time spent on each source/type of
+    event, in fullUpdate() calls, on RECALCULATE and rejected events,
+    as well as the distribution of the neighbour list lengths and
+    the FEL overflow count are all written to the output file.
+
+    The overhead is a couple of tick counter reads per event, so the
+    plugin can be left enabled in production runs.
+   */
+  class OPProfiler: public OutputPlugin
+  {
+  public:
+    OPProfiler(const dynamo::Simulation*, const magnet::xml::Node&);
+
+    virtual void initialise();
+
+    virtual void eventUpdate(const Event&, const NEventData&) {}
+
+    void output(magnet::xml::XmlStream&);
+
+    //The profile stays with the Scheduler of each Simulation, as it
+    //measures the cost of the event loop and not the configuration.
+    virtual void replicaExchange(OutputPlugin&) {}
+
+  protected:
+    shared_ptr<Scheduler::Profile> _profile;
+    uint64_t _startTicks;
+    std::chrono::steady_clock::time_point _startTime;
+  };
+}
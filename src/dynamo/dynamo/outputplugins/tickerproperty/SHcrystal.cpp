@@ -28,12 +28,19 @@
 #include <fstream>
 #include <cmath>
 #include <limits>
+#include <algorithm>
+#include <functional>
+#include <sstream>
+#include <thread>
 
 namespace dynamo {
   OPSHCrystal::OPSHCrystal(const dynamo::Simulation* tmp, const magnet::xml::Node& XML):
     OPTicker(tmp,"SHCrystal"), rg(1.2), maxl(7),
     nblistID(std::numeric_limits<size_t>::max()),
-    count(0)
+    count(0),
+    _recurrence(false),
+    _localOrder(true),
+    _threads(std::thread::hardware_concurrency())
   {
     operator<<(XML);
   }
@@ -47,6 +54,20 @@ namespace dynamo {
     if (XML.hasAttribute("MaxL"))
       maxl = XML.getAttribute("MaxL").as<size_t>();
 
+    if (XML.hasAttribute("Method"))
+      {
+	const std::string method = XML.getAttribute("Method").as<std::string>();
+	if (method == "Recurrence")
+	  _recurrence = true;
+	else if (method != "Direct")
+	  M_throw() << "Unknown SHCrystal Method \"" << method << "\", must be Direct or Recurrence";
+      }
+
+    if (XML.hasAttribute("LocalOrder"))
+      _localOrder = XML.getAttribute("LocalOrder").as<bool>();
+
+    if (XML.hasAttribute("Threads"))
+      _threads = XML.getAttribute("Threads").as<size_t>();
     rg *= Sim->units.unitLength();
 
 
@@ -80,12 +101,63 @@ namespace dynamo {
     for (size_t l=0; l < maxl; ++l)
       globalcoeff[l].resize(2*l+1,std::complex<double>(0,0));
 
+    //Precalculate the Wigner 3j symbols used for the W_l
+    _wigner3j.clear();
+    _wigner3j.resize(maxl);
+    for (int l(0); l < static_cast<int>(maxl); ++l)
+      for (int m1(-l); m1 <= l; ++m1)
+	for (int m2(-l); m2 <= l; ++m2)
+	  {
+	    const int m3 = -(m1+m2);
+	    if (std::abs(m3) > l) continue;
+	    const Wigner3jTerm term = {m1, m2, magnet::math::wignerThreej(l,l,l,m1,m2,m3)};
+	    if (term.value != 0)
+	      _wigner3j[l].push_back(term);
+	  }
+
+    if (_recurrence)
+      {
+	//The normalisation of the spherical harmonics,
+	//sqrt((2l+1)/(4 pi) (l-m)!/(l+m)!)
+	_Ynorm.resize(lmIndex(maxl, 0));
+	for (size_t l(0); l < maxl; ++l)
+	  for (size_t m(0); m <= l; ++m)
+	    {
+	      double factorialRatio(1);
+	      for (size_t i(l - m + 1); i <= l + m; ++i)
+		factorialRatio /= i;
+	      _Ynorm[lmIndex(l, m)] = std::sqrt((2.0 * l + 1.0) / (4.0 * M_PI) * factorialRatio);
+	    }
+
+	_localYsum.assign(Sim->N() * lmIndex(maxl, 0), std::complex<double>(0, 0));
+	_localCount.assign(Sim->N(), 0);
+
+	//Use a few chunks per thread to balance the load
+	const size_t threads = std::max(_threads, size_t(1));
+	_threadPool.setThreadCount((threads > 1) ? threads : 0);
+	const size_t chunks = std::max(size_t(1), std::min(Sim->N(), (threads > 1) ? 4 * threads : 1));
+	_chunks.resize(chunks);
+	for (size_t i(0); i < chunks; ++i)
+	  {
+	    _chunks[i].start = (i * Sim->N()) / chunks;
+	    _chunks[i].end = ((i + 1) * Sim->N()) / chunks;
+	    _chunks[i].Y.resize(lmIndex(maxl, 0));
+	    _chunks[i].coeffsum.resize(lmIndex(maxl, 0));
+	  }
+      }
+
     ticker();
   }
 
   void 
   OPSHCrystal::ticker()
   {
+    if (_recurrence)
+      {
+	recurrenceTicker();
+	return;
+      }
+
     sphericalsum ssum(Sim, rg, maxl);
   
     for (const Particle& part : Sim->particles)
@@ -109,42 +181,201 @@ namespace dynamo {
   {
     XML << magnet::xml::tag("SHCrystal");
   
-    for (int l(0); l < static_cast<int>(maxl); ++l)
+    for (size_t l(0); l < maxl; ++l)
+      XML << magnet::xml::tag("Q")
+	  << magnet::xml::attr("l") << l
+	  << magnet::xml::attr("val") << getQ(l)
+	  << magnet::xml::endtag("Q")
+	  << magnet::xml::tag("W")
+	  << magnet::xml::attr("l") << l
+	  << magnet::xml::attr("val") << getW(l)
+	  << magnet::xml::endtag("W");
+
+    if (_recurrence && _localOrder)
       {
-	XML << magnet::xml::tag("Q")
-	    << magnet::xml::attr("l") << l;
-      
-	double Qsum(0);
-	for (int m(-l); m <= l; ++m)
-	  Qsum += std::norm(globalcoeff[l][m+l] / std::complex<double>(count, 0));
-      
-	XML << magnet::xml::attr("val")
-	    << std::sqrt(Qsum * 4.0 * M_PI / (2.0 * l + 1.0))
-	    << magnet::xml::endtag("Q");
-      
-	XML << magnet::xml::tag("W")
-	    << magnet::xml::attr("l") << l;
+	std::ostringstream columns;
+	columns << "ID Neighbours";
+	for (size_t l(0); l < maxl; ++l)
+	  columns << " q_" << l;
+	for (size_t l(0); l < maxl; ++l)
+	  columns << " w_" << l;
+
+	XML << magnet::xml::tag("LocalOrder")
+	    << magnet::xml::attr("Columns") << columns.str()
+	    << magnet::xml::chardata();
+
+	for (const Particle& part : Sim->particles)
+	  {
+	    const size_t ID = part.getID();
+	    //Normalise the sums to give the q_lm of the particle
+	    std::vector<std::complex<double> > q(_localYsum.begin() + ID * lmIndex(maxl, 0), _localYsum.begin() + (ID + 1) * lmIndex(maxl, 0));
+	    if (_localCount[ID])
+	      for (std::complex<double>& val : q)
+		val /= double(_localCount[ID]);
+
+	    XML << ID << " " << _localCount[ID];
+	    for (size_t l(0); l < maxl; ++l)
+	      XML << " " << calcQ(q.data(), l);
+	    for (size_t l(0); l < maxl; ++l)
+	      XML << " " << calcW(q.data(), l);
+	    XML << "\n";
+	  }
+
+	XML << magnet::xml::endtag("LocalOrder");
+      }
+
+    XML << magnet::xml::endtag("SHCrystal");
+  }
+
+  double
+  OPSHCrystal::getQ(const size_t l) const
+  {
+    double Qsum(0);
+    for (const std::complex<double>& val : globalcoeff[l])
+      Qsum += std::norm(val / std::complex<double>(count, 0));
+
+    return std::sqrt(Qsum * 4.0 * M_PI / (2.0 * l + 1.0));
+  }
+
+  std::complex<double>
+  OPSHCrystal::getW(const size_t l) const
+  {
+    double Qsum(0);
+    for (const std::complex<double>& val : globalcoeff[l])
+      Qsum += std::norm(val / std::complex<double>(count, 0));
+
+    std::complex<double> Wsum(0, 0);
+    for (const Wigner3jTerm& term : _wigner3j[l])
+      Wsum += std::complex<double>(term.value * std::pow(count,-3.0), 0)
+	* globalcoeff[l][term.m1+l]
+	* globalcoeff[l][term.m2+l]
+	* globalcoeff[l][l-(term.m1+term.m2)];
+
+    return Wsum * std::pow(Qsum, -1.5);
+  }
+
+  void
+  OPSHCrystal::recurrenceTicker()
+  {
+    for (size_t chunk(0); chunk < _chunks.size(); ++chunk)
+      _threadPool.queueTask(std::bind(&OPSHCrystal::processChunk, this, chunk));
+    _threadPool.wait();
 
-	std::complex<double> Wsum(0, 0);
-	for (int m1(-l); m1 <= l; ++m1)
-	  for (int m2(-l); m2 <= l; ++m2)
+    for (const ChunkData& chunk : _chunks)
+      {
+	count += chunk.count;
+	for (size_t l(0); l < maxl; ++l)
+	  for (size_t m(0); m <= l; ++m)
 	    {
-	      int m3 = -(m1+m2);
-	      if (std::abs(m3) <= l)
-		Wsum += std::complex<double>(magnet::math::wignerThreej(l,l,l,m1,m2,m3) 
-					     * std::pow(count,-3.0), 0)
-		  * globalcoeff[l][m1+l]
-		  * globalcoeff[l][m2+l]
-		  * globalcoeff[l][l-(m1+m2)]
-		  ;
+	      const std::complex<double> val = chunk.coeffsum[lmIndex(l, m)];
+	      globalcoeff[l][l + m] += val;
+	      if (m)
+		//Y_{l,-m} = (-1)^m conj(Y_{lm})
+		globalcoeff[l][l - m] += ((m % 2) ? -1.0 : 1.0) * std::conj(val);
 	    }
-      
-	XML << magnet::xml::attr("val")
-	    << Wsum * std::pow(Qsum, -1.5)
-	    << magnet::xml::endtag("W");
       }
+  }
 
-    XML << magnet::xml::endtag("SHCrystal");
+  void
+  OPSHCrystal::processChunk(const size_t chunkID)
+  {
+    ChunkData& chunk = _chunks[chunkID];
+    const GNeighbourList& nblist = static_cast<const GNeighbourList&>(*Sim->globals[nblistID]);
+    const size_t lmCount = lmIndex(maxl, 0);
+
+    chunk.count = 0;
+    std::fill(chunk.coeffsum.begin(), chunk.coeffsum.end(), std::complex<double>(0, 0));
+
+    for (size_t ID(chunk.start); ID < chunk.end; ++ID)
+      {
+	const Particle& part = Sim->particles[ID];
+	std::complex<double>* Ysum = &_localYsum[ID * lmCount];
+	std::fill(Ysum, Ysum + lmCount, std::complex<double>(0, 0));
+	size_t& bonds = _localCount[ID];
+	bonds = 0;
+
+	chunk.neighbours.clear();
+	nblist.getParticleNeighbours(part, chunk.neighbours);
+	for (const size_t& ID2 : chunk.neighbours)
+	  {
+	    if (ID2 == ID) continue;
+	    Vector rij = part.getPosition() - Sim->particles[ID2].getPosition();
+	    Sim->BCs->applyBC(rij);
+	    const double norm = rij.nrm();
+	    if ((norm > rg) || (norm == 0)) continue;
+
+	    ++bonds;
+	    sphericalHarmonics(rij / norm, chunk.Y.data());
+	    for (size_t lm(0); lm < lmCount; ++lm)
+	      Ysum[lm] += chunk.Y[lm];
+	  }
+
+	chunk.count += bonds;
+	for (size_t lm(0); lm < lmCount; ++lm)
+	  chunk.coeffsum[lm] += Ysum[lm];
+      }
+  }
+
+  void
+  OPSHCrystal::sphericalHarmonics(const Vector& rij, std::complex<double>* Y) const
+  {
+    //The associated Legendre polynomials are calculated divided by
+    //sin^m(theta), which is instead included through (x+iy)^m =
+    //sin^m(theta) e^{i m phi}. This avoids calculating any angles.
+    const double z = rij[2];
+    const std::complex<double> xy(rij[0], rij[1]);
+    std::complex<double> xym(1, 0);
+    double Pmm(1);
+    for (size_t m(0); m < maxl; ++m)
+      {
+	//P_m^m / sin^m = (-1)^m (2m-1)!!
+	if (m) Pmm *= -(2.0 * m - 1.0);
+
+	double Plm2(0), Plm1(Pmm);
+	Y[lmIndex(m, m)] = _Ynorm[lmIndex(m, m)] * Pmm * xym;
+	for (size_t l(m + 1); l < maxl; ++l)
+	  {
+	    const double Plm = ((2.0 * l - 1.0) * z * Plm1 - (l + m - 1.0) * Plm2) / (l - m);
+	    Y[lmIndex(l, m)] = _Ynorm[lmIndex(l, m)] * Plm * xym;
+	    Plm2 = Plm1;
+	    Plm1 = Plm;
+	  }
+
+	xym *= xy;
+      }
+  }
+
+  std::complex<double>
+  OPSHCrystal::getqlm(const std::complex<double>* q, const int l, const int m) const
+  {
+    if (m >= 0)
+      return q[lmIndex(l, m)];
+    return ((m % 2) ? -1.0 : 1.0) * std::conj(q[lmIndex(l, -m)]);
+  }
+
+  double
+  OPSHCrystal::calcQ(const std::complex<double>* q, const int l) const
+  {
+    double sum(0);
+    for (int m(-l); m <= l; ++m)
+      sum += std::norm(getqlm(q, l, m));
+    return std::sqrt(sum * 4.0 * M_PI / (2.0 * l + 1.0));
+  }
+
+  double
+  OPSHCrystal::calcW(const std::complex<double>* q, const int l) const
+  {
+    double sum(0);
+    for (int m(-l); m <= l; ++m)
+      sum += std::norm(getqlm(q, l, m));
+
+    if (sum == 0) return 0;
+
+    std::complex<double> Wsum(0, 0);
+    for (const Wigner3jTerm& term : _wigner3j[l])
+      Wsum += term.value * getqlm(q, l, term.m1) * getqlm(q, l, term.m2) * getqlm(q, l, -(term.m1 + term.m2));
+
+    return Wsum.real() * std::pow(sum, -1.5);
   }
 
   OPSHCrystal::sphericalsum::sphericalsum
@@ -169,17 +400,10 @@ namespace dynamo {
       {
 	++count;
 	rij /= norm;
-	double theta = std::acos(rij[0]);
-	double sintheta = std::sin(theta);
-	double phi = rij[1] / sintheta;
-      
-	if (fabs(phi) > 1.0)
-	  phi = (phi > 0) ? 0.5 * M_PI : 1.5 * M_PI;
-	else
-	  phi = std::asin(phi);
-
-	if (std::sin(theta) == 0) phi = 0;
-      
+	//The x axis is the polar axis. The azimuthal angle must be
+	//taken from both of the other components to get its quadrant.
+	double theta = std::acos(std::max(-1.0, std::min(1.0, rij[0])));
+	double phi = std::atan2(rij[2], rij[1]);
 	if (phi < 0) phi += 2.0 * M_PI;
 
 	for (size_t l(0); l < maxl; ++l)
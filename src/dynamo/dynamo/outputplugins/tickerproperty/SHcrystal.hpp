@@ -17,11 +17,30 @@
 
 #pragma once
 #include <dynamo/outputplugins/tickerproperty/ticker.hpp>
+#include <magnet/math/vector.hpp>
+#include <magnet/thread/threadpool.hpp>
 #include <vector>
 #include <complex>
 
 namespace dynamo {
   class Particle;
+
+  /*! \brief Calculates the Steinhardt bond-orientational order
+      parameters \f$Q_l\f$ and \f$W_l\f$ of the system.
+
+    The bonds are all pairs of particles closer than the "CutOffR",
+    and the order parameters are calculated for all \f$l\f$ below
+    "MaxL".
+
+    By default ("Method"="Direct") the spherical harmonics of each
+    bond are evaluated one at a time. With "Method"="Recurrence", the
+    \f$q_{lm}\f$ of each particle are calculated in parallel (using
+    "Threads" threads, default: the number of processors) from a
+    recurrence relation for all of the \f$Y_{lm}\f$ of a bond at
+    once. In this mode, the local \f$q_l\f$ and \f$w_l\f$ of each
+    particle at the last tick are also written to the output (for
+    detecting crystalline particles), unless "LocalOrder"="false".
+   */
   class OPSHCrystal: public OPTicker
   {
   public:
@@ -37,10 +56,66 @@ namespace dynamo {
 
     virtual void operator<<(const magnet::xml::Node&);
 
+    //! \brief The global \f$Q_l\f$ averaged over all ticks.
+    double getQ(size_t l) const;
+
+    //! \brief The global (normalised) \f$W_l\f$ averaged over all ticks.
+    std::complex<double> getW(size_t l) const;
+
   protected:
 
     std::complex<double> localq(const Particle& part, int l, int m);
 
+    //! \brief The index of \f$Y_{lm}\f$ (\f$m\ge0\f$) in the per-particle arrays.
+    static size_t lmIndex(size_t l, size_t m) { return l * (l + 1) / 2 + m; }
+
+    //! \brief Calculates the \f$Y_{lm}\f$ (\f$m\ge0\f$) of a unit vector.
+    void sphericalHarmonics(const Vector& rij, std::complex<double>* Y) const;
+
+    //! \brief Calculates the \f$q_{lm}\f$ of the particles of one chunk.
+    void processChunk(size_t chunk);
+
+    void recurrenceTicker();
+
+    //! \brief Returns \f$q_{lm}\f$ for any m from the \f$m\ge0\f$ values.
+    std::complex<double> getqlm(const std::complex<double>* q, int l, int m) const;
+
+    double calcQ(const std::complex<double>* q, int l) const;
+    double calcW(const std::complex<double>* q, int l) const;
+
+    bool _recurrence;
+    bool _localOrder;
+    size_t _threads;
+    magnet::thread::ThreadPool _threadPool;
+
+    //! The normalisation of the \f$Y_{lm}\f$, indexed by lmIndex().
+    std::vector<double> _Ynorm;
+
+    struct Wigner3jTerm
+    {
+      int m1, m2;
+      double value;
+    };
+
+    //! The non-zero Wigner 3j symbols \f$(l,l,l,m_1,m_2,-m_1-m_2)\f$ for each l.
+    std::vector<std::vector<Wigner3jTerm> > _wigner3j;
+
+    //! The sum of the \f$Y_{lm}\f$ of the bonds of each particle, [ID * lmIndex(maxl, 0) + lmIndex(l, m)].
+    std::vector<std::complex<double> > _localYsum;
+    //! The number of bonds of each particle.
+    std::vector<size_t> _localCount;
+
+    struct ChunkData
+    {
+      size_t start, end;
+      size_t count;
+      std::vector<size_t> neighbours;
+      std::vector<std::complex<double> > Y;
+      std::vector<std::complex<double> > coeffsum;
+    };
+
+    std::vector<ChunkData> _chunks;
+
     //! Cut-off radius 
     double rg;
     size_t maxl;
@@ -63,21 +63,25 @@ namespace dynamo {
   OPChainBondAngles::ticker()
   {
     for (Cdata& dat : chains)
-      for (const shared_ptr<IDRange>& range : Sim->topology[dat.chainID]->getMolecules())
-      if (range->size() > 2)
+      {
+	const Topology& topo = *Sim->topology[dat.chainID];
+	for (size_t m(0); m < topo.getMoleculeCount(); ++m)
 	{
+	  const IDRange::Block range = topo.getMolecule(m);
+	  if (range.count <= 2) continue;
+
 	  //Walk the polymer
-	  for (size_t j = 0; j < range->size()-2; ++j)
+	  for (size_t j = 0; j < range.count-2; ++j)
 	    {
-	      Vector  bond1 = Sim->particles[(*range)[j+1]].getPosition()
-		- Sim->particles[(*range)[j]].getPosition();
+	      Vector  bond1 = Sim->particles[range[j+1]].getPosition()
+		- Sim->particles[range[j]].getPosition();
 
 	      bond1 /= bond1.nrm();
 
-	      for (size_t i = j+2; i < range->size(); ++i)
+	      for (size_t i = j+2; i < range.count; ++i)
 		{
-		  Vector  bond2 = Sim->particles[(*range)[i]].getPosition()
-		    -Sim->particles[(*range)[i-1]].getPosition();
+		  Vector  bond2 = Sim->particles[range[i]].getPosition()
+		    -Sim->particles[range[i-1]].getPosition();
 		
 		  bond2 /= bond2.nrm();
 		
@@ -87,6 +91,7 @@ namespace dynamo {
 		}
 	    }
 	}
+      }
   }
 
   void 
@@ -48,13 +48,19 @@ namespace dynamo {
   OPChainBondLength::ticker()
   {
     for (Cdata& dat : chains)
-      for (const shared_ptr<IDRange>& range : Sim->topology[dat.chainID]->getMolecules())
-      if (range->size() > 2)
-	//Walk the polymer
-	for (size_t j = 0; j < range->size()-1; ++j)
-	  dat.BondLengths[j].addVal
-	    ((Sim->particles[(*range)[j+1]].getPosition()
-	      - Sim->particles[(*range)[j]].getPosition()).nrm());
+      {
+	const Topology& topo = *Sim->topology[dat.chainID];
+	for (size_t m(0); m < topo.getMoleculeCount(); ++m)
+	  {
+	    const IDRange::Block range = topo.getMolecule(m);
+	    if (range.count > 2)
+	      //Walk the polymer
+	      for (size_t j = 0; j < range.count-1; ++j)
+		dat.BondLengths[j].addVal
+		  ((Sim->particles[range[j+1]].getPosition()
+		    - Sim->particles[range[j]].getPosition()).nrm());
+	  }
+      }
   }
 
   void 
@@ -67,16 +67,17 @@ namespace dynamo {
   OPCContactMap::ticker()
   {
     for (Cdata& dat : chains)
-      for (const shared_ptr<IDRange>& range : dat.chainPtr->getMolecules())
+      for (size_t m(0); m < dat.chainPtr->getMoleculeCount(); ++m)
       {
+	const IDRange::Block range = dat.chainPtr->getMolecule(m);
 	dat.counter++;
 	for (unsigned long i = 0; i < dat.chainlength; i++)
 	  {
-	    const Particle& part1 = Sim->particles[(*range)[i]];
+	    const Particle& part1 = Sim->particles[range[i]];
 	 
 	    for (unsigned long j = i+1; j < dat.chainlength; j++)
 	      {
-		const Particle& part2 = Sim->particles[(*range)[j]];
+		const Particle& part2 = Sim->particles[range[j]];
 
 		for (const shared_ptr<Interaction>& ptr : Sim->interactions)
 		  if (ptr->isInteraction(part1,part2))
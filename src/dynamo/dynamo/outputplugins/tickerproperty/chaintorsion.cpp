@@ -78,11 +78,15 @@ namespace dynamo {
       {
 	double sysGamma  = 0.0;
 	long count = 0;
-	for (const shared_ptr<IDRange>& range : dat.chainPtr->getMolecules())
+	for (size_t m(0); m < dat.chainPtr->getMoleculeCount(); ++m)
 	  {
-	    if (range->size() < 3)//Need three for curv and torsion
+	    const IDRange::Block range = dat.chainPtr->getMolecule(m);
+	    if (range.count < 3)//Need three for curv and torsion
 	      break;
 
+	    const size_t* const begin = range.ids;
+	    const size_t* const end = range.ids + range.count;
+
 #ifdef DYNAMO_DEBUG
 	    if (NDIM != 3)
 	      M_throw() << "Not implemented chain curvature in non 3 dimensional systems";
@@ -95,7 +99,7 @@ namespace dynamo {
 	    std::vector<Vector> vec;
 
 	    //Calc first and second derivatives
-	    for (IDRange::iterator it = range->begin() + 1; it != range->end() - 1; it++)
+	    for (const size_t* it = begin + 1; it != end - 1; it++)
 	      {
 		tmp = 0.5 * (Sim->particles[*(it+1)].getPosition()
 			     - Sim->particles[*(it-1)].getPosition());
@@ -133,28 +137,28 @@ namespace dynamo {
 
 		double minradius = std::numeric_limits<float>::infinity();
 
-		for (IDRange::iterator it1 = range->begin(); 
-		     it1 != range->end(); it1++)
+		for (const size_t* it1 = begin; 
+		     it1 != end; it1++)
 		  //Check this particle is not the same, or adjacent
-		  if (*it1 != *(range->begin()+2+i)
-		      && *it1 != *(range->begin()+1+i)
-		      && *it1 != *(range->begin()+3+i))
-		    for (IDRange::iterator it2 = range->begin() + 1; 
-			 it2 != range->end() - 1; it2++)
+		  if (*it1 != *(begin+2+i)
+		      && *it1 != *(begin+1+i)
+		      && *it1 != *(begin+3+i))
+		    for (const size_t* it2 = begin + 1; 
+			 it2 != end - 1; it2++)
 		      //Check this particle is not the same, or adjacent to the studied particle
 		      if (*it1 != *it2
-			  && *it2 != *(range->begin()+2+i)
-			  && *it2 != *(range->begin()+1+i)
-			  && *it2 != *(range->begin()+3+i))
+			  && *it2 != *(begin+2+i)
+			  && *it2 != *(begin+1+i)
+			  && *it2 != *(begin+3+i))
 			{
 			  //We have three points, calculate the lengths
 			  //of the triangle sides
 			  double a = (Sim->particles[*it1].getPosition() 
 				      - Sim->particles[*it2].getPosition()).nrm(),
-			    b = (Sim->particles[*(range->begin()+2+i)].getPosition() 
+			    b = (Sim->particles[*(begin+2+i)].getPosition() 
 				 - Sim->particles[*it2].getPosition()).nrm(),
 			    c = (Sim->particles[*it1].getPosition() 
-				 - Sim->particles[*(range->begin()+2+i)].getPosition()).nrm();
+				 - Sim->particles[*(begin+2+i)].getPosition()).nrm();
 
 			  //Now calc the area of the triangle
 			  double s = (a + b + c) / 2.0;
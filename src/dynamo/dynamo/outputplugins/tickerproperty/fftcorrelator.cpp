@@ -0,0 +1,170 @@
+/*  dynamo:- Event driven molecular dynamics simulator 
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <dynamo/outputplugins/tickerproperty/fftcorrelator.hpp>
+#include <magnet/exception.hpp>
+#include <algorithm>
+#include <functional>
+
+namespace dynamo {
+  FFTBlockCorrelator::FFTBlockCorrelator():
+    _mode(AUTOCORRELATION),
+    _length(0),
+    _blockLength(0),
+    _sample(0)
+  {}
+
+  void
+  FFTBlockCorrelator::init(Mode mode, size_t length, size_t blockLength, const std::vector<size_t>& seriesGroups, size_t groupCount, size_t threads)
+  {
+    if (!length)
+      M_throw() << "The correlation length must be at least one";
+
+    if (blockLength < length)
+      M_throw() << "The block length (" << blockLength << ") must be at least the correlation length (" << length << ")";
+
+    _mode = mode;
+    _length = length;
+    _blockLength = blockLength;
+    _sample = 0;
+    _seriesGroups = seriesGroups;
+    _buffer.assign(_seriesGroups.size() * NDIM * _blockLength, 0);
+    //Zero padding to twice the block length gives the linear (not
+    //circular) correlation
+    _fft = magnet::math::FFT(magnet::math::nextPow2(2 * _blockLength));
+    _results.assign(groupCount, std::vector<double>(_length, 0));
+
+    //Use a few chunks per thread to balance the load
+    threads = std::max(threads, size_t(1));
+    _threads.setThreadCount((threads > 1) ? threads : 0);
+    const size_t chunks = std::max(size_t(1), std::min(_seriesGroups.size(), (threads > 1) ? 4 * threads : 1));
+
+    _chunkStart.resize(chunks + 1);
+    for (size_t i(0); i <= chunks; ++i)
+      _chunkStart[i] = (i * _seriesGroups.size()) / chunks;
+
+    _chunkData.assign(chunks, std::vector<double>(groupCount * _length, 0));
+    _chunkWork.assign(chunks, std::vector<magnet::math::FFT::complex>(_fft.size()));
+    _chunkSpectrum.assign(chunks, std::vector<magnet::math::FFT::complex>(_fft.size()));
+  }
+
+  bool
+  FFTBlockCorrelator::endSample()
+  {
+    if (++_sample != _blockLength)
+      return false;
+
+    _sample = 0;
+
+    for (size_t chunk(0); chunk < _chunkData.size(); ++chunk)
+      _threads.queueTask(std::bind(&FFTBlockCorrelator::processChunk, this, chunk));
+    _threads.wait();
+
+    for (std::vector<double>& result : _results)
+      std::fill(result.begin(), result.end(), 0);
+
+    for (const std::vector<double>& data : _chunkData)
+      for (size_t group(0); group < _results.size(); ++group)
+	for (size_t lag(0); lag < _length; ++lag)
+	  _results[group][lag] += data[group * _length + lag];
+
+    return true;
+  }
+
+  void
+  FFTBlockCorrelator::processChunk(const size_t chunk)
+  {
+    std::vector<double>& data = _chunkData[chunk];
+    std::fill(data.begin(), data.end(), 0);
+
+    for (size_t series(_chunkStart[chunk]); series < _chunkStart[chunk + 1]; ++series)
+      correlate(series, _chunkWork[chunk], _chunkSpectrum[chunk], &data[_seriesGroups[series] * _length]);
+  }
+
+  void
+  FFTBlockCorrelator::correlate(const size_t series, std::vector<magnet::math::FFT::complex>& work, std::vector<magnet::math::FFT::complex>& spectrum, double* out) const
+  {
+    typedef magnet::math::FFT::complex complex;
+    const size_t T = _blockLength;
+    const size_t P = _fft.size();
+    const double* x[NDIM];
+    //The MSD is translationally invariant, so the first value is
+    //subtracted to reduce the round off error.
+    double origin[NDIM];
+    for (size_t iDim(0); iDim < NDIM; ++iDim)
+      {
+	x[iDim] = &_buffer[(series * NDIM + iDim) * T];
+	origin[iDim] = (_mode == MEAN_SQUARE_DISPLACEMENT) ? x[iDim][0] : 0;
+      }
+
+    //Sum the power spectra of each dimension. Two dimensions are
+    //transformed at once by storing them as the real and imaginary
+    //parts, as the sum of their power spectra is then
+    //(|Z_k|^2+|Z_{P-k}|^2)/2.
+    std::fill(spectrum.begin(), spectrum.end(), complex(0, 0));
+    for (size_t iDim(0); iDim < NDIM; iDim += 2)
+      {
+	const bool paired = (iDim + 1 < NDIM);
+	for (size_t k(0); k < T; ++k)
+	  work[k] = complex(x[iDim][k] - origin[iDim], paired ? (x[iDim + 1][k] - origin[iDim + 1]) : 0);
+	std::fill(work.begin() + T, work.end(), complex(0, 0));
+
+	_fft.transform(work.data());
+
+	if (paired)
+	  for (size_t k(0); k < P; ++k)
+	    spectrum[k] += 0.5 * (std::norm(work[k]) + std::norm(work[(P - k) % P]));
+	else
+	  for (size_t k(0); k < P; ++k)
+	    spectrum[k] += std::norm(work[k]);
+      }
+
+    //The inverse transform gives the sum over the origins of x(k).x(k+m)
+    _fft.transform(spectrum.data(), true);
+
+    switch (_mode)
+      {
+      case AUTOCORRELATION:
+	for (size_t m(0); m < _length; ++m)
+	  out[m] += spectrum[m].real() / (T - m);
+	break;
+      case MEAN_SQUARE_DISPLACEMENT:
+	{
+	  //Sum over the origins of |x(k)|^2 + |x(k+m)|^2, calculated
+	  //recursively in m
+	  const auto sqr = [&](const size_t k) {
+	    double sum(0);
+	    for (size_t iDim(0); iDim < NDIM; ++iDim)
+	      sum += (x[iDim][k] - origin[iDim]) * (x[iDim][k] - origin[iDim]);
+	    return sum;
+	  };
+
+	  double Q(0);
+	  for (size_t k(0); k < T; ++k)
+	    Q += 2 * sqr(k);
+
+	  //The zero lag is always zero
+	  for (size_t m(1); m < _length; ++m)
+	    {
+	      Q -= sqr(m - 1) + sqr(T - m);
+	      out[m] += (Q - 2 * spectrum[m].real()) / (T - m);
+	    }
+	  break;
+	}
+      }
+  }
+}
@@ -0,0 +1,109 @@
+/*  dynamo:- Event driven molecular dynamics simulator 
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <magnet/math/vector.hpp>
+#include <magnet/math/fft.hpp>
+#include <magnet/thread/threadpool.hpp>
+#include <vector>
+
+namespace dynamo {
+  /*! \brief Calculates block averaged time correlation functions of
+      many vector quantities using Fast Fourier Transforms.
+
+    The values of every series (e.g., the position of each particle)
+    are buffered for a block of samples, stored as one contiguous
+    array per series and dimension. Once the block is full, the
+    correlation function at every lag is calculated at once for each
+    series using the Wiener-Khinchin theorem, which costs O(T\log T)
+    per series for a block of T samples instead of the O(T\,L) of
+    directly summing over the L lags at each sample. The series are
+    processed in parallel using a magnet::thread::ThreadPool.
+
+    Each series belongs to a group (e.g., a Species), and the results
+    of the block are the sum over the series of each group of the
+    correlation function, averaged over all time origins in the
+    block. Correlations across the boundaries of the blocks are not
+    included.
+   */
+  class FFTBlockCorrelator
+  {
+  public:
+    enum Mode
+      {
+	//! \f$\langle|x(t+m)-x(t)|^2\rangle\f$, e.g., the mean square displacement.
+	MEAN_SQUARE_DISPLACEMENT,
+	//! \f$\langle x(t+m)\cdot x(t)\rangle\f$, e.g., the velocity autocorrelation function.
+	AUTOCORRELATION
+      };
+
+    FFTBlockCorrelator();
+
+    /*! \brief Sets up the correlator and clears the buffers.
+      
+      \param mode The correlation function to calculate.
+      \param length The number of lags (including zero) to calculate.
+      \param blockLength The number of samples in a block (at least length).
+      \param seriesGroups The group of each series.
+      \param groupCount The number of groups.
+      \param threads The number of threads to use.
+     */
+    void init(Mode mode, size_t length, size_t blockLength, const std::vector<size_t>& seriesGroups, size_t groupCount, size_t threads);
+
+    //! \brief Stores the value of a series for the current sample.
+    inline void set(const size_t series, const Vector& val)
+    {
+      for (size_t iDim(0); iDim < NDIM; ++iDim)
+	_buffer[(series * NDIM + iDim) * _blockLength + _sample] = val[iDim];
+    }
+
+    /*! \brief Completes the current sample, once every series has
+        been set.
+
+      \return True if the block was completed and its results are
+      available through getResult().
+     */
+    bool endSample();
+
+    /*! \brief The correlation function of a group for the last
+        completed block.
+     */
+    const std::vector<double>& getResult(const size_t group) const { return _results[group]; }
+
+  private:
+    void processChunk(size_t chunk);
+
+    void correlate(size_t series, std::vector<magnet::math::FFT::complex>& work, std::vector<magnet::math::FFT::complex>& spectrum, double* out) const;
+
+    Mode _mode;
+    size_t _length;
+    size_t _blockLength;
+    size_t _sample;
+    std::vector<size_t> _seriesGroups;
+    std::vector<double> _buffer;
+    magnet::math::FFT _fft;
+    magnet::thread::ThreadPool _threads;
+
+    //! The series processed by each chunk are [_chunkStart[i], _chunkStart[i+1]).
+    std::vector<size_t> _chunkStart;
+    //! The per-chunk results, [group * _length + lag].
+    std::vector<std::vector<double> > _chunkData;
+    std::vector<std::vector<magnet::math::FFT::complex> > _chunkWork;
+    std::vector<std::vector<magnet::math::FFT::complex> > _chunkSpectrum;
+    std::vector<std::vector<double> > _results;
+  };
+}
@@ -22,6 +22,7 @@
 #include <dynamo/systems/sysTicker.hpp>
 #include <magnet/xmlwriter.hpp>
 #include <magnet/xmlreader.hpp>
+#include <thread>
 
 namespace dynamo {
   OPMSDCorrelator::OPMSDCorrelator(const dynamo::Simulation* tmp, 
@@ -30,7 +31,10 @@ namespace dynamo {
     length(20),
     currCorrLength(0),
     ticksTaken(0),
-    notReady(true)
+    notReady(true),
+    _useFFT(false),
+    _blockLength(0),
+    _threads(std::thread::hardware_concurrency())
   {
     operator<<(XML);
   }
@@ -40,25 +44,67 @@ namespace dynamo {
   {
     if (XML.hasAttribute("Length"))
       length = XML.getAttribute("Length").as<size_t>();
+
+    if (XML.hasAttribute("Method"))
+      {
+	const std::string method = XML.getAttribute("Method").as<std::string>();
+	if (method == "FFT")
+	  _useFFT = true;
+	else if (method != "Direct")
+	  M_throw() << "Unknown MSD Method \"" << method << "\", must be Direct or FFT";
+      }
+
+    if (XML.hasAttribute("BlockLength"))
+      _blockLength = XML.getAttribute("BlockLength").as<size_t>();
+
+    if (XML.hasAttribute("Threads"))
+      _threads = XML.getAttribute("Threads").as<size_t>();
   }
 
   void 
   OPMSDCorrelator::initialise()
   {
     dout << "The length of the MSD correlator is " << length << std::endl;
+
+    speciesData.resize(Sim->species.size(), std::vector<double>(length, 0.0));
+    structData.resize(Sim->topology.size(), std::vector<double>(length, 0.0));
+
+    if (_useFFT)
+      {
+	if (!_blockLength)
+	  _blockLength = 2 * length;
+
+	dout << "Using the FFT method with blocks of " << _blockLength << " ticks and " << _threads << " threads" << std::endl;
+
+	//The particles are the first series, followed by the molecules
+	std::vector<size_t> seriesGroups(Sim->N());
+	for (const Particle& part : Sim->particles)
+	  seriesGroups[part.getID()] = Sim->species(part)->getID();
+
+	for (const shared_ptr<Topology>& topo : Sim->topology)
+	  seriesGroups.resize(seriesGroups.size() + topo->getMolecules().size(), Sim->species.size() + topo->getID());
+
+	_fftCorrelator.init(FFTBlockCorrelator::MEAN_SQUARE_DISPLACEMENT, length, _blockLength, seriesGroups, Sim->species.size() + Sim->topology.size(), _threads);
+	fftSample();
+	return;
+      }
+
     posHistory.resize(Sim->N(), boost::circular_buffer<Vector>(length));
     currCorrLength=1;
 
     for (const Particle& part : Sim->particles)
       posHistory[part.getID()].push_front(part.getPosition());
-
-    speciesData.resize(Sim->species.size(), std::vector<double>(length, 0.0));
-    structData.resize(Sim->topology.size(), std::vector<double>(length, 0.0));
   }
 
   void 
   OPMSDCorrelator::ticker()
   {
+    if (_useFFT)
+      {
+	fftSample();
+	return;
+      }
+
     for (const Particle& part : Sim->particles)
       posHistory[part.getID()].push_front(part.getPosition());
   
@@ -79,19 +125,22 @@ namespace dynamo {
     ++ticksTaken;
   
     for (const shared_ptr<Species>& sp : Sim->species)
-      for (const size_t& ID : *sp->getRange())
-      for (size_t step(1); step < length; ++step)
-	speciesData[sp->getID()][step] += (posHistory[ID][step] - posHistory[ID][0]).nrm2();
+      sp->getRange()->forEach([&](const size_t ID) {
+	  for (size_t step(1); step < length; ++step)
+	    speciesData[sp->getID()][step] += (posHistory[ID][step] - posHistory[ID][0]).nrm2();
+	});
   
     for (const shared_ptr<Topology>& topo : Sim->topology)
-      for (const shared_ptr<IDRange>& range : topo->getMolecules())
+      for (size_t m(0); m < topo->getMoleculeCount(); ++m)
       {
+	const IDRange::Block range = topo->getMolecule(m);
 	Vector  molCOM({0,0,0});
 	double molMass(0);
 
-	for (const size_t& ID : *range)
+	for (size_t i(0); i < range.count; ++i)
 	  {
-	    double mass = Sim->species[Sim->particles[ID]]->getMass(ID);
+	    const size_t ID = range[i];
+	    double mass = Sim->species(Sim->particles[ID])->getMass(ID);
 	    molCOM += posHistory[ID][0] * mass;
 	    molMass += mass;
 	  }
@@ -102,9 +151,9 @@ namespace dynamo {
 	  {
 	    Vector  molCOM2({0,0,0});
 	  
-	    for (const size_t& ID : *range)
-	      molCOM2 += posHistory[ID][step] 
-	      * Sim->species[Sim->particles[ID]]->getMass(ID);
+	    for (size_t i(0); i < range.count; ++i)
+	      molCOM2 += posHistory[range[i]][step] 
+	      * Sim->species(Sim->particles[range[i]])->getMass(range[i]);
 	  
 	    molCOM2 /= molMass;
 	  
@@ -113,6 +162,62 @@ namespace dynamo {
       }
   }
 
+  void
+  OPMSDCorrelator::fftSample()
+  {
+    for (const Particle& part : Sim->particles)
+      _fftCorrelator.set(part.getID(), part.getPosition());
+
+    size_t series = Sim->N();
+    for (const shared_ptr<Topology>& topo : Sim->topology)
+      for (size_t m(0); m < topo->getMoleculeCount(); ++m)
+	{
+	  const IDRange::Block range = topo->getMolecule(m);
+	  Vector sum({0,0,0});
+	  double molMass(0);
+	  for (size_t i(0); i < range.count; ++i)
+	    {
+	      const size_t ID = range[i];
+	      const double mass = Sim->species(Sim->particles[ID])->getMass(ID);
+	      sum += Sim->particles[ID].getPosition() * mass;
+	      molMass += mass;
+	    }
+	  _fftCorrelator.set(series++, sum / molMass);
+	}
+
+    if (!_fftCorrelator.endSample())
+      return;
+
+    ++ticksTaken;
+
+    for (size_t step(0); step < length; ++step)
+      {
+	for (const shared_ptr<Species>& sp : Sim->species)
+	  speciesData[sp->getID()][step] += _fftCorrelator.getResult(sp->getID())[step];
+
+	for (const shared_ptr<Topology>& topo : Sim->topology)
+	  structData[topo->getID()][step] += _fftCorrelator.getResult(Sim->species.size() + topo->getID())[step];
+      }
+  }
+
+  double
+  OPMSDCorrelator::getSpeciesResult(const size_t speciesID, const size_t step) const
+  {
+    return speciesData[speciesID][step]
+      / (static_cast<double>(ticksTaken)
+	 * static_cast<double>(Sim->species[speciesID]->getCount())
+	 * Sim->units.unitArea());
+  }
+
+  double
+  OPMSDCorrelator::getStructureResult(const size_t topologyID, const size_t step) const
+  {
+    return structData[topologyID][step]
+      / (static_cast<double>(ticksTaken)
+	 * static_cast<double>(Sim->topology[topologyID]->getMolecules().size())
+	 * Sim->units.unitArea());
+  }
+
   void
   OPMSDCorrelator::output(magnet::xml::XmlStream &XML)
   {
@@ -132,10 +237,7 @@ namespace dynamo {
       
 	for (size_t step(0); step < length; ++step)
 	  XML << dt * step << " "
-	      << speciesData[sp->getID()][step] 
-	    / (static_cast<double>(ticksTaken) 
-	       * static_cast<double>(sp->getCount())
-	       * Sim->units.unitArea())
+	      << getSpeciesResult(sp->getID(), step)
 	      << "\n";
       
 	XML << magnet::xml::endtag("Species");
@@ -153,10 +255,7 @@ namespace dynamo {
       
 	for (size_t step(0); step < length; ++step)
 	  XML << dt * step << " "
-	      << structData[topo->getID()][step]
-	    / (static_cast<double>(ticksTaken) 
-	       * static_cast<double>(topo->getMolecules().size())
-	       * Sim->units.unitArea())
+	      << getStructureResult(topo->getID(), step)
 	      << "\n";
 	
 	XML << magnet::xml::endtag("Structure");
@@ -18,10 +18,24 @@
 #pragma once
 #include <dynamo/outputplugins/tickerproperty/ticker.hpp>
 #include <boost/circular_buffer.hpp>
+#include <dynamo/outputplugins/tickerproperty/fftcorrelator.hpp>
 #include <magnet/math/vector.hpp>
 #include <vector>
 
 namespace dynamo {
+  /*! \brief Calculates the mean square displacement of the particles
+      (by Species) and of the molecules (by Topology).
+
+    By default ("Method"="Direct") the history of the last "Length"
+    ticks is stored for every particle and summed over at every
+    tick. With "Method"="FFT", the values are collected in blocks of
+    "BlockLength" ticks (default: twice the Length) and the
+    correlation is calculated for all lags at once by the
+    FFTBlockCorrelator, using "Threads" threads (default: the number
+    of processors). This is much faster for long correlations, but
+    does not include the correlations between blocks. The output
+    format is the same for both methods.
+   */
   class OPMSDCorrelator: public OPTicker
   {
   public:
@@ -32,6 +46,12 @@ namespace dynamo {
     void output(magnet::xml::XmlStream &); 
 
     virtual void operator<<(const magnet::xml::Node&);
+
+    //! \brief The averaged correlator of a Species at a lag of step ticks, in reduced units.
+    double getSpeciesResult(size_t speciesID, size_t step) const;
+
+    //! \brief The averaged correlator of a Topology at a lag of step ticks, in reduced units.
+    double getStructureResult(size_t topologyID, size_t step) const;
   
   protected:
     virtual void stream(double) {}
@@ -39,6 +59,8 @@ namespace dynamo {
 
     void accPass();
 
+    void fftSample();
+
     std::vector<boost::circular_buffer<Vector> > posHistory;
     std::vector<std::vector<double> > speciesData;
     std::vector<std::vector<double> > structData;
@@ -46,5 +68,11 @@ namespace dynamo {
     size_t currCorrLength;
     size_t ticksTaken;
     bool notReady;
+
+    //! If true, the FFTBlockCorrelator is used instead of the direct sum over the history.
+    bool _useFFT;
+    size_t _blockLength;
+    size_t _threads;
+    FFTBlockCorrelator _fftCorrelator;
   };
 }
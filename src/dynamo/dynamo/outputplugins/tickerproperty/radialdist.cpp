@@ -136,14 +136,14 @@ namespace dynamo {
         {
           if (sp1->getID() == std::get<0>(pairI) && sp2->getID() == std::get<1>(pairI))
           {
-            for (const size_t& p1 : *sp1->getRange())
-           	for (const size_t& p2 : *sp2->getRange())
-           	{
-           	  Vector  rij = Sim->particles[p1].getPosition() - Sim->particles[p2].getPosition();
-           	  Sim->BCs->applyBC(rij);
-           	  const size_t i = static_cast<size_t>(rij.nrm() / binWidth + 0.5);
-           	  if (i < length) ++data[sp1->getID()][sp2->getID()][i];
-           	}
+            sp1->getRange()->forEach([&](const size_t p1) {
+                sp2->getRange()->forEach([&](const size_t p2) {
+                    Vector  rij = Sim->particles[p1].getPosition() - Sim->particles[p2].getPosition();
+                    Sim->BCs->applyBC(rij);
+                    const size_t i = static_cast<size_t>(rij.nrm() / binWidth + 0.5);
+                    if (i < length) ++data[sp1->getID()][sp2->getID()][i];
+                  });
+              });
           }
         }
   }
@@ -84,7 +84,7 @@ namespace dynamo {
   }
 
   OPRGyration::molGyrationDat
-  OPRGyration::getGyrationEigenSystem(const shared_ptr<IDRange>& range, const dynamo::Simulation* Sim)
+  OPRGyration::getGyrationEigenSystem(const IDRange::Block& range, const dynamo::Simulation* Sim)
   {
     //Determine the centre of mass. Watch for periodic images
     Vector  tmpVec;  
@@ -92,19 +92,19 @@ namespace dynamo {
     molGyrationDat retVal;
     retVal.MassCentre = Vector{0,0,0};
 
-    double totmass = Sim->species(Sim->particles[*(range->begin())])->getMass(*(range->begin()));
+    double totmass = Sim->species(Sim->particles[range[0]])->getMass(range[0]);
     //Walk along the chain
     Vector origin_position = Vector{0,0,0};
     Matrix inertiaTensor;
     
-    for (IDRange::iterator iPtr = range->begin()+1; iPtr != range->end(); iPtr++)
+    for (size_t i = 1; i < range.count; ++i)
       {
-	Vector currRelPos = Sim->particles[*iPtr].getPosition() - Sim->particles[*(iPtr - 1)].getPosition();
+	Vector currRelPos = Sim->particles[range[i]].getPosition() - Sim->particles[range[i - 1]].getPosition();
 	Sim->BCs->applyBC(currRelPos);
 
 	const Vector unfolded_pos = currRelPos + origin_position;
 
-	const double mass = Sim->species(Sim->particles[*iPtr])->getMass(*iPtr);
+	const double mass = Sim->species(Sim->particles[range[i]])->getMass(range[i]);
 
 	retVal.MassCentre += origin_position * mass;
 	inertiaTensor += mass * ((unfolded_pos * unfolded_pos) * Matrix::identity() - Dyadic(unfolded_pos, unfolded_pos));
@@ -113,14 +113,14 @@ namespace dynamo {
       }
 
     retVal.MassCentre /= totmass;
-    retVal.MassCentre += Sim->particles[*(range->begin())].getPosition();
+    retVal.MassCentre += Sim->particles[range[0]].getPosition();
     
     std::pair<std::array<Vector, 3>, std::array<double, 3> > result
       = magnet::math::symmetric_eigen_decomposition(inertiaTensor / totmass);
 
     for (size_t i = 0; i < NDIM; i++)
       {	
-	retVal.EigenVal[i] = result.second[i] / range->size();
+	retVal.EigenVal[i] = result.second[i] / range.count;
 
 	//EigenVec Components
 	for (size_t j = 0; j < NDIM; j++)
@@ -163,9 +163,9 @@ namespace dynamo {
       {
 	std::list<Vector  > molAxis;
 
-	for (const shared_ptr<IDRange>& range : dat.chainPtr->getMolecules())
+	for (size_t m(0); m < dat.chainPtr->getMoleculeCount(); ++m)
 	  {
-	    molGyrationDat vals = getGyrationEigenSystem(range, Sim);	  
+	    molGyrationDat vals = getGyrationEigenSystem(dat.chainPtr->getMolecule(m), Sim);	  
 	    //Take the largest eigenvector as the molecular axis
 	    molAxis.push_back(vals.EigenVec[NDIM-1]);
 	    //Now add the radius of gyration
@@ -200,8 +200,8 @@ namespace dynamo {
 
 	std::list<Vector  > molAxis;
 
-	for (const shared_ptr<IDRange>& range : dat.chainPtr->getMolecules())
-	  molAxis.push_back(getGyrationEigenSystem(range, Sim).EigenVec[NDIM-1]);
+	for (size_t m(0); m < dat.chainPtr->getMoleculeCount(); ++m)
+	  molAxis.push_back(getGyrationEigenSystem(dat.chainPtr->getMolecule(m), Sim).EigenVec[NDIM-1]);
 
 	Vector  EigenVal = NematicOrderParameter(molAxis);
             
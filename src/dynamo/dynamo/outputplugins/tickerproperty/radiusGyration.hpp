@@ -18,12 +18,11 @@
 #pragma once
 
 #include <dynamo/outputplugins/tickerproperty/ticker.hpp>
+#include <dynamo/ranges/IDRange.hpp>
 #include <magnet/math/histogram.hpp>
 #include <magnet/math/vector.hpp>
 #include <list>
 
-class IDRange;
-
 namespace dynamo {
   class TChain;
 
@@ -49,7 +48,7 @@ namespace dynamo {
       Vector  MassCentre;
     };
   
-    static molGyrationDat getGyrationEigenSystem(const shared_ptr<IDRange>&, const dynamo::Simulation*);
+    static molGyrationDat getGyrationEigenSystem(const IDRange::Block&, const dynamo::Simulation*);
 
     static Vector  NematicOrderParameter(const std::list<Vector  >&);
 
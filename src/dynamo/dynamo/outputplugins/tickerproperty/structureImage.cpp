@@ -90,11 +90,13 @@ namespace dynamo {
   void
   OPStructureImaging::printImage()
   {
-    for (const shared_ptr<IDRange>& prange : Sim->topology[id]->getMolecules())
+    const Topology& topo = *Sim->topology[id];
+    for (size_t m(0); m < topo.getMoleculeCount(); ++m)
       {
+	const IDRange::Block molecule = topo.getMolecule(m);
 	std::vector<Vector  > atomDescription;
 
-	Vector  lastpos(Sim->particles[*prange->begin()].getPosition());
+	Vector  lastpos(Sim->particles[molecule[0]].getPosition());
       
 	Vector  masspos{0,0,0};
 
@@ -102,8 +104,9 @@ namespace dynamo {
 
 	Vector  sumrij{0,0,0};
       
-	for (const size_t& pid : *prange)
+	for (size_t i(0); i < molecule.count; ++i)
 	  {
+	    const size_t pid = molecule[i];
 	    //This is all to make sure we walk along the structure
 	    const Particle& part(Sim->particles[pid]);
 	    Vector  rij = part.getPosition() - lastpos;
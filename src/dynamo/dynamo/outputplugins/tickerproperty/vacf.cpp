@@ -22,6 +22,7 @@
 #include <dynamo/systems/sysTicker.hpp>
 #include <magnet/xmlwriter.hpp>
 #include <magnet/xmlreader.hpp>
+#include <thread>
 
 namespace dynamo {
   OPVACF::OPVACF(const dynamo::Simulation* tmp, 
@@ -30,7 +31,10 @@ namespace dynamo {
     length(50),
     currCorrLength(0),
     ticksTaken(0),
-    notReady(true)
+    notReady(true),
+    _useFFT(false),
+    _blockLength(0),
+    _threads(std::thread::hardware_concurrency())
   {
     operator<<(XML);
   }
@@ -40,6 +44,21 @@ namespace dynamo {
   {
     if (XML.hasAttribute("Length"))
       length = XML.getAttribute("Length").as<size_t>();
+
+    if (XML.hasAttribute("Method"))
+      {
+	const std::string method = XML.getAttribute("Method").as<std::string>();
+	if (method == "FFT")
+	  _useFFT = true;
+	else if (method != "Direct")
+	  M_throw() << "Unknown VACF Method \"" << method << "\", must be Direct or FFT";
+      }
+
+    if (XML.hasAttribute("BlockLength"))
+      _blockLength = XML.getAttribute("BlockLength").as<size_t>();
+
+    if (XML.hasAttribute("Threads"))
+      _threads = XML.getAttribute("Threads").as<size_t>();
   }
 
   void 
@@ -47,20 +66,45 @@ namespace dynamo {
   {
     dout << "The length of the VACF correlator is " << length << std::endl;
 
-    velHistory.resize(Sim->N(), boost::circular_buffer<Vector>(length));
+    speciesData.resize(Sim->species.size(), std::vector<double>(length, 0.0));
+    structData.resize(Sim->topology.size(), std::vector<double>(length, 0.0));
+
+    if (_useFFT)
+      {
+	if (!_blockLength)
+	  _blockLength = 2 * length;
+
+	dout << "Using the FFT method with blocks of " << _blockLength << " ticks and " << _threads << " threads" << std::endl;
+
+	//The particles are the first series, followed by the molecules
+	std::vector<size_t> seriesGroups(Sim->N());
+	for (const Particle& part : Sim->particles)
+	  seriesGroups[part.getID()] = Sim->species(part)->getID();
+
+	for (const shared_ptr<Topology>& topo : Sim->topology)
+	  seriesGroups.resize(seriesGroups.size() + topo->getMolecules().size(), Sim->species.size() + topo->getID());
 
+	_fftCorrelator.init(FFTBlockCorrelator::AUTOCORRELATION, length, _blockLength, seriesGroups, Sim->species.size() + Sim->topology.size(), _threads);
+	fftSample();
+	return;
+      }
+
+    velHistory.resize(Sim->N(), boost::circular_buffer<Vector>(length));
     currCorrLength=1;
 
     for (const Particle& part : Sim->particles)
-      velHistory[part.getID()].push_front(part.getPosition());
-    
-    speciesData.resize(Sim->species.size(), std::vector<double>(length, 0.0));
-    structData.resize(Sim->topology.size(), std::vector<double>(length, 0.0));
+      velHistory[part.getID()].push_front(part.getVelocity());
   }
 
   void 
   OPVACF::ticker()
   {
+    if (_useFFT)
+      {
+	fftSample();
+	return;
+      }
+
     for (const Particle& part : Sim->particles)
       velHistory[part.getID()].push_front(part.getVelocity());
   
@@ -79,19 +123,22 @@ namespace dynamo {
     ++ticksTaken;
   
     for (const shared_ptr<Species>& sp : Sim->species)
-      for (const size_t& ID : *sp->getRange())
-      for (size_t step(0); step < length; ++step)
-	speciesData[sp->getID()][step] += velHistory[ID][step] | velHistory[ID][0];
+      sp->getRange()->forEach([&](const size_t ID) {
+	  for (size_t step(0); step < length; ++step)
+	    speciesData[sp->getID()][step] += velHistory[ID][step] | velHistory[ID][0];
+	});
   
     for (const shared_ptr<Topology>& topo : Sim->topology)
-      for (const shared_ptr<IDRange>& range : topo->getMolecules())
+      for (size_t m(0); m < topo->getMoleculeCount(); ++m)
 	{
+	  const IDRange::Block range = topo->getMolecule(m);
 	  Vector COMvelocity({0,0,0});
 	  double molMass(0);
 	  
-	  for (const size_t& ID : *range)
+	  for (size_t i(0); i < range.count; ++i)
 	    {
-	      double mass = Sim->species[Sim->particles[ID]]->getMass(ID);
+	      const size_t ID = range[i];
+	      double mass = Sim->species(Sim->particles[ID])->getMass(ID);
 	      COMvelocity += velHistory[ID][0] * mass;
 	      molMass += mass;
 	    }
@@ -102,14 +149,64 @@ namespace dynamo {
 	    {
 	      Vector COMvelocity2({0,0,0});
 	      
-	      for (const size_t& ID : *range)
-		COMvelocity2 += velHistory[ID][step] * Sim->species[Sim->particles[ID]]->getMass(ID);
+	      for (size_t i(0); i < range.count; ++i)
+		COMvelocity2 += velHistory[range[i]][step] * Sim->species(Sim->particles[range[i]])->getMass(range[i]);
 	      COMvelocity2 /= molMass;
 	      structData[topo->getID()][step] += COMvelocity | COMvelocity2;
 	    }
 	}
   }
 
+  void
+  OPVACF::fftSample()
+  {
+    for (const Particle& part : Sim->particles)
+      _fftCorrelator.set(part.getID(), part.getVelocity());
+
+    size_t series = Sim->N();
+    for (const shared_ptr<Topology>& topo : Sim->topology)
+      for (size_t m(0); m < topo->getMoleculeCount(); ++m)
+	{
+	  const IDRange::Block range = topo->getMolecule(m);
+	  Vector sum({0,0,0});
+	  double molMass(0);
+	  for (size_t i(0); i < range.count; ++i)
+	    {
+	      const size_t ID = range[i];
+	      const double mass = Sim->species(Sim->particles[ID])->getMass(ID);
+	      sum += Sim->particles[ID].getVelocity() * mass;
+	      molMass += mass;
+	    }
+	  _fftCorrelator.set(series++, sum / molMass);
+	}
+
+    if (!_fftCorrelator.endSample())
+      return;
+
+    ++ticksTaken;
+
+    for (size_t step(0); step < length; ++step)
+      {
+	for (const shared_ptr<Species>& sp : Sim->species)
+	  speciesData[sp->getID()][step] += _fftCorrelator.getResult(sp->getID())[step];
+
+	for (const shared_ptr<Topology>& topo : Sim->topology)
+	  structData[topo->getID()][step] += _fftCorrelator.getResult(Sim->species.size() + topo->getID())[step];
+      }
+  }
+
+  double
+  OPVACF::getSpeciesResult(const size_t speciesID, const size_t step) const
+  {
+    return speciesData[speciesID][step] / (static_cast<double>(ticksTaken) * static_cast<double>(Sim->species[speciesID]->getCount()) * Sim->units.unitVelocity() * Sim->units.unitVelocity());
+  }
+
+  double
+  OPVACF::getStructureResult(const size_t topologyID, const size_t step) const
+  {
+    return structData[topologyID][step] / (static_cast<double>(ticksTaken) * static_cast<double>(Sim->topology[topologyID]->getMolecules().size()) * Sim->units.unitVelocity() * Sim->units.unitVelocity());
+  }
+
   void
   OPVACF::output(magnet::xml::XmlStream &XML)
   {
@@ -127,7 +224,7 @@ namespace dynamo {
       
 	for (size_t step(0); step < length; ++step)
 	  XML << dt * step << " "
-	      << speciesData[sp->getID()][step] / (static_cast<double>(ticksTaken) * static_cast<double>(sp->getCount()) * Sim->units.unitVelocity() * Sim->units.unitVelocity())
+	      << getSpeciesResult(sp->getID(), step)
 	      << "\n";
       
 	XML << magnet::xml::endtag("Species");
@@ -145,7 +242,7 @@ namespace dynamo {
       
 	for (size_t step(0); step < length; ++step)
 	  XML << dt * step << " "
-	      << structData[topo->getID()][step] / (static_cast<double>(ticksTaken) * static_cast<double>(topo->getMolecules().size()) * Sim->units.unitVelocity() * Sim->units.unitVelocity())
+	      << getStructureResult(topo->getID(), step)
 	      << "\n";
 	
 	XML << magnet::xml::endtag("Structure");
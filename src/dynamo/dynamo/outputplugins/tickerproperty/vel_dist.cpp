@@ -56,10 +56,11 @@ namespace dynamo {
   OPVelDist::ticker()
   {
     for (const shared_ptr<Species>& sp : Sim->species)
-      for (const size_t& ID : *sp->getRange())
-      for (size_t iDim = 0; iDim < NDIM; ++iDim)
-	data[iDim][sp->getID()]
-	  .addVal(Sim->particles[ID].getVelocity()[iDim]);
+      sp->getRange()->forEach([&](const size_t ID) {
+	  for (size_t iDim = 0; iDim < NDIM; ++iDim)
+	    data[iDim][sp->getID()]
+	      .addVal(Sim->particles[ID].getVelocity()[iDim]);
+	});
   }
 
   void
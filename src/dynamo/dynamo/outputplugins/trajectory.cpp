@@ -47,24 +47,30 @@ namespace dynamo {
   void 
   OPTrajectory::eventUpdate(const Event& eevent, const NEventData& SDat)
   {
-    logfile << std::setw(8) << std::setfill('0') << Sim->eventCount 
+    writeEvent(logfile, *Sim, eevent, SDat);
+  }
+
+  void 
+  OPTrajectory::writeEvent(std::ostream& logfile, const dynamo::Simulation& Sim, const Event& eevent, const NEventData& SDat)
+  {
+    logfile << std::setw(8) << std::setfill('0') << Sim.eventCount 
 	    << ", Source=" <<  eevent._source 
 	    << ", SourceID=" << eevent._sourceID
 	    << ", Event Type=" << eevent._type
-	    << ", t=" << Sim->systemTime / Sim->units.unitTime() 
-	    << ", dt=" << eevent._dt / Sim->units.unitTime()
+	    << ", t=" << Sim.systemTime / Sim.units.unitTime() 
+	    << ", dt=" << eevent._dt / Sim.units.unitTime()
       ;
 
     for (const ParticleEventData& pData : SDat.L1partChanges)
       {
 	logfile << "\n";
-	const Particle& part = Sim->particles[pData.getParticleID()];
+	const Particle& part = Sim.particles[pData.getParticleID()];
 	logfile << "   1PEvent: p1=" << part.getID() << ", Type=" << pData.getType();
-	Vector delP = Sim->species[pData.getSpeciesID()]->getMass(part.getID()) * (part.getVelocity() - pData.getOldVel());
-	delP /= Sim->units.unitMomentum();
-	Vector pos = part.getPosition() / Sim->units.unitLength();
-	Vector oldv = pData.getOldVel() / Sim->units.unitVelocity();
-	Vector newv = part.getVelocity() / Sim->units.unitVelocity();
+	Vector delP = Sim.species[pData.getSpeciesID()]->getMass(part.getID()) * (part.getVelocity() - pData.getOldVel());
+	delP /= Sim.units.unitMomentum();
+	Vector pos = part.getPosition() / Sim.units.unitLength();
+	Vector oldv = pData.getOldVel() / Sim.units.unitVelocity();
+	Vector newv = part.getVelocity() / Sim.units.unitVelocity();
 	logfile << ", delP1=" << delP.toString() << ", pos=" << pos.toString() << ", vel=" << newv.toString() << ", oldvel=" << oldv.toString() << "\n";
       }
   
@@ -72,12 +78,12 @@ namespace dynamo {
       {
 	const size_t id1 = std::min(pData.particle1_.getParticleID(), pData.particle2_.getParticleID());
 	const size_t id2 = std::max(pData.particle1_.getParticleID(), pData.particle2_.getParticleID());
-	Vector  rij = Sim->particles[id1].getPosition() - Sim->particles[id2].getPosition(),
-	  vij = Sim->particles[id1].getVelocity() - Sim->particles[id2].getVelocity();
+	Vector  rij = Sim.particles[id1].getPosition() - Sim.particles[id2].getPosition(),
+	  vij = Sim.particles[id1].getVelocity() - Sim.particles[id2].getVelocity();
 	
-	Sim->BCs->applyBC(rij, vij);
-	rij /= Sim->units.unitLength();
-	vij /= Sim->units.unitVelocity();
+	Sim.BCs->applyBC(rij, vij);
+	rij /= Sim.units.unitLength();
+	vij /= Sim.units.unitVelocity();
 	
 	logfile << "\n   2PEvent:";
 	logfile << " p1=" << std::setw(5) << id1
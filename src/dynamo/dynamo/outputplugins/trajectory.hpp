@@ -31,6 +31,14 @@ namespace dynamo {
 
     void eventUpdate(const Event&, const NEventData&);
 
+    /*! \brief Writes the text description of an event to a stream.
+
+      The state of the Simulation must be that just after the event
+      was run. This is also used by the dynaeventlog program to
+      convert binary event logs (see OPEventLog) to this format.
+     */
+    static void writeEvent(std::ostream&, const dynamo::Simulation&, const Event&, const NEventData&);
+
     virtual void replicaExchange(OutputPlugin&)
     { M_throw() << "This output plugin hasn't been prepared for changes of system"; }
 
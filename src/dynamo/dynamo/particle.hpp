@@ -40,6 +40,9 @@ namespace dynamo {
       if (!particle.testState(Particle::DYNAMIC))
 	XML << magnet::xml::attr("Static") <<  "Static";
 
+      if (particle.testState(Particle::SLEEPING))
+	XML << magnet::xml::attr("Sleeping") <<  "Sleeping";
+
       XML << magnet::xml::tag("P")
 	  << (particle._pos)
 	  << magnet::xml::endtag("P")
@@ -64,6 +67,7 @@ namespace dynamo {
       _peculiarTime(0.0), _ID(nID), _state(DEFAULT)
     {
       if (XML.hasAttribute("Static")) clearState(DYNAMIC);
+      if (XML.hasAttribute("Sleeping")) setState(SLEEPING);
     
       _pos << XML.getNode("P");
       _vel << XML.getNode("V");
@@ -106,7 +110,8 @@ namespace dynamo {
     typedef enum {
       DEFAULT = 0x01 | 0x02,//!< The default flags for the Particle's State.
       DYNAMIC = 0x01, //!< For the DynGravity Dynamics it Enables/Disables the gravity force for acting on this Particle.
-      ALIVE = 0x02 //!< Flags if the particle is actually in the Simulation.
+      ALIVE = 0x02, //!< Flags if the particle is actually in the Simulation.
+      SLEEPING = 0x04 //!< The Particle is at rest and not DYNAMIC (see SSleep), so it cannot have an event with another SLEEPING Particle.
     } State;
   
     //! \brief Used to test if the Particle has a State flag set.
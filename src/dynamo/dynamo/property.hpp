@@ -318,6 +318,9 @@ namespace dynamo {
       _namedProperties.push_back(property);
     }
 
+    //! \brief The number of properties looked up by their name.
+    inline size_t size() const { return _namedProperties.size(); }
+
     inline friend magnet::xml::XmlStream& operator<<(magnet::xml::XmlStream& XML, const PropertyStore& propStore)
     {
       XML << magnet::xml::tag("Properties");
@@ -73,6 +73,25 @@ namespace dynamo {
 
     typedef iterator const_iterator;
 
+    /*! \brief A contiguous block of the IDs of a range.
+
+      If ids is set, the block is the array of IDs [ids, ids + count),
+      otherwise it is the interval of IDs [start, start + count).
+     */
+    struct Block
+    {
+      Block(): ids(nullptr), start(0), count(0) {}
+      Block(const size_t* nIDs, size_t nCount): ids(nIDs), start(0), count(nCount) {}
+      Block(size_t nStart, size_t nCount): ids(nullptr), start(nStart), count(nCount) {}
+
+      inline size_t operator[](size_t i) const
+      { return ids ? ids[i] : start + i; }
+
+      const size_t* ids;
+      size_t start;
+      size_t count;
+    };
+
     virtual ~IDRange() {};
 
     virtual bool isInRange(const Particle&) const = 0;
@@ -83,6 +102,38 @@ namespace dynamo {
 
     virtual unsigned long at(unsigned long) const = 0;
 
+    /*! \brief The number of contiguous blocks the IDs of the range
+        are stored in.
+
+      Ranges are iterated over by block (see forEach()) to avoid a
+      virtual call per ID.
+     */
+    virtual size_t blockCount() const = 0;
+
+    //! Returns a contiguous block of the IDs, in range order.
+    virtual Block getBlock(size_t) const = 0;
+
+    /*! \brief Calls func(ID) for every ID in the range, in order.
+
+      There are only two virtual calls per block, so the loop over the
+      IDs can be inlined.
+     */
+    template<class F>
+    inline void forEach(F func) const
+    {
+      const size_t blocks = blockCount();
+      for (size_t b(0); b < blocks; ++b)
+	{
+	  const Block block = getBlock(b);
+	  if (block.ids)
+	    for (size_t i(0); i < block.count; ++i)
+	      func(block.ids[i]);
+	  else
+	    for (size_t ID(block.start); ID < block.start + block.count; ++ID)
+	      func(ID);
+	}
+    }
+
     static IDRange* getClass(const magnet::xml::Node&, const dynamo::Simulation * Sim);
 
     friend magnet::xml::XmlStream& operator<<(magnet::xml::XmlStream& XML,
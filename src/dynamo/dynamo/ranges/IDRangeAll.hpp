@@ -44,6 +44,10 @@ namespace dynamo {
     virtual unsigned long operator[](unsigned long i) const  
     { return i; }
 
+    virtual size_t blockCount() const { return 1; }
+
+    virtual Block getBlock(size_t) const { return Block(size_t(0), Sim->particles.size()); }
+
     virtual unsigned long at(unsigned long i) const 
     { 
       if (i >= Sim->particles.size())
@@ -56,6 +56,10 @@ namespace dynamo {
 
     virtual unsigned long at(unsigned long i) const { return IDs.at(i); }
 
+    virtual size_t blockCount() const { return IDs.empty() ? 0 : 1; }
+
+    virtual Block getBlock(size_t) const { return Block(IDs.data(), IDs.size()); }
+
   protected:
 
     virtual void outputXML(magnet::xml::XmlStream& XML) const
@@ -41,6 +41,10 @@ namespace dynamo {
     virtual unsigned long at(unsigned long i) const 
     { M_throw() << "Nothing to access"; }
 
+    virtual size_t blockCount() const { return 0; }
+
+    virtual Block getBlock(size_t) const { M_throw() << "Nothing to access"; }
+
   protected:
 
     virtual void outputXML(magnet::xml::XmlStream& XML) const
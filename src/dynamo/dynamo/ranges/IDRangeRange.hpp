@@ -49,6 +49,10 @@ namespace dynamo {
       return startID + i;
     }
 
+    virtual size_t blockCount() const { return 1; }
+
+    virtual Block getBlock(size_t) const { return Block(startID, size()); }
+
   protected:
     virtual void outputXML(magnet::xml::XmlStream& XML) const
     {
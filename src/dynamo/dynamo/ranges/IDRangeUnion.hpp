@@ -70,6 +70,25 @@ namespace dynamo {
       return operator[](i);
     }
 
+    virtual size_t blockCount() const
+    {
+      size_t count(0);
+      for (const shared_ptr<IDRange>& r : ranges)
+	count += r->blockCount();
+      return count;
+    }
+
+    virtual Block getBlock(size_t i) const
+    {
+      for (const shared_ptr<IDRange>& r : ranges)
+	{
+	  if (i < r->blockCount())
+	    return r->getBlock(i);
+	  i -= r->blockCount();
+	}
+      M_throw() << "Out of range access";
+    }
+
   protected:
 
     virtual void outputXML(magnet::xml::XmlStream& XML) const
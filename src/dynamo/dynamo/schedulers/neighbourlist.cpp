@@ -152,6 +152,34 @@ namespace dynamo {
     return std::unique_ptr<IDRange>(range_ptr);
   }
     
+  std::unique_ptr<IDRange>
+  SNeighbourList::getAwakeParticleNeighbours(const Particle& part) const
+  {
+#ifdef DYNAMO_DEBUG
+    if (!std::dynamic_pointer_cast<GNeighbourList>(Sim->globals[NBListID]))
+      M_throw() << "Not a GNeighbourList!";
+#endif
+
+    const GNeighbourList& nblist(*static_cast<const GNeighbourList*>(Sim->globals[NBListID].get()));
+    IDRangeList* range_ptr = new IDRangeList();
+    nblist.getAwakeParticleNeighbours(part, range_ptr->getContainer());
+    return std::unique_ptr<IDRange>(range_ptr);
+  }
+
+  std::unique_ptr<IDRange>
+  SNeighbourList::getExposedParticleNeighbours(const Particle& part) const
+  {
+#ifdef DYNAMO_DEBUG
+    if (!std::dynamic_pointer_cast<GNeighbourList>(Sim->globals[NBListID]))
+      M_throw() << "Not a GNeighbourList!";
+#endif
+
+    const GNeighbourList& nblist(*static_cast<const GNeighbourList*>(Sim->globals[NBListID].get()));
+    IDRangeList* range_ptr = new IDRangeList();
+    nblist.getExposedParticleNeighbours(part, range_ptr->getContainer());
+    return std::unique_ptr<IDRange>(range_ptr);
+  }
+
   std::unique_ptr<IDRange> 
   SNeighbourList::getParticleLocals(const Particle& part) const {
     return std::unique_ptr<IDRange>(new IDRangeRange(0, Sim->locals.size() - 1));
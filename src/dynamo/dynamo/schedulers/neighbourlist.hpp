@@ -33,6 +33,8 @@ namespace dynamo {
     virtual std::unique_ptr<IDRange> getParticleNeighbours(const Particle&) const;
     virtual std::unique_ptr<IDRange> getParticleNeighbours(const Vector&) const;
     virtual std::unique_ptr<IDRange> getParticleLocals(const Particle&) const;
+    virtual std::unique_ptr<IDRange> getAwakeParticleNeighbours(const Particle&) const;
+    virtual std::unique_ptr<IDRange> getExposedParticleNeighbours(const Particle&) const;
 
   protected:
     virtual void outputXML(magnet::xml::XmlStream&) const;
@@ -26,12 +26,18 @@
 #include <dynamo/simulation.hpp>
 #include <dynamo/units/units.hpp>
 #include <dynamo/NparticleEventData.hpp>
+#include <dynamo/checkpoint.hpp>
 #ifdef DYNAMO_DEBUG
 #include <dynamo/globals/neighbourList.hpp>
 #include <dynamo/NparticleEventData.hpp>
 #endif
 #include <magnet/xmlwriter.hpp>
 #include <magnet/xmlreader.hpp>
+#include <magnet/thread/threadpool.hpp>
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+#include <typeinfo>
 
 namespace dynamo {
   Scheduler::Scheduler(dynamo::Simulation* const tmp, const char * aName,
@@ -39,7 +45,10 @@ namespace dynamo {
     SimBase(tmp, aName),
     sorter(nS),
     _interactionRejectionCounter(0),
-    _localRejectionCounter(0)
+    _localRejectionCounter(0),
+    _predictionThreads(0),
+    _parallelThreshold(256),
+    _parallelSafe(false)
   {}
 
   Scheduler::~Scheduler() {}
@@ -48,11 +57,30 @@ namespace dynamo {
   Scheduler::operator<<(const magnet::xml::Node& XML)
   {
     sorter = FEL::getClass(XML.getNode("Sorter"));
+
+    if (XML.hasAttribute("Threads"))
+      _predictionThreads = XML.getAttribute("Threads").as<size_t>();
+
+    if (XML.hasAttribute("ParallelThreshold"))
+      _parallelThreshold = XML.getAttribute("ParallelThreshold").as<size_t>();
   }
 
   void
   Scheduler::initialise()
   {
+    _parallelSafe = _predictionThreads;
+    for (const auto& interaction_ptr : Sim->interactions)
+      _parallelSafe = _parallelSafe && interaction_ptr->threadSafeGetEvent();
+
+    if (_predictionThreads && !_parallelSafe)
+      derr << "Some Interactions cannot predict events concurrently, the parallel event prediction is disabled" << std::endl;
+
+    if (_parallelSafe)
+      dout << "Predicting the events of particles with at least " << _parallelThreshold 
+	   << " neighbours using " << _predictionThreads << " threads" << std::endl;
+
+    if (restoreCheckpoint()) return;
+
     //Now, the scheduler is used to test the state of the system.
     dout << "Checking the simulation configuration for any errors" << std::endl;
     size_t warnings(0);
@@ -63,20 +91,41 @@ namespace dynamo {
 	warnings += interaction_ptr->validateState(warnings < 101, 101 - warnings);
       }
     
-    for (size_t id1(0); id1 < Sim->particles.size(); ++id1)
-      {
-	std::unique_ptr<IDRange> ids(getParticleNeighbours(Sim->particles[id1]));
-	for (const size_t id2 : *ids)
-	  if (id2 > id1)
-	    if (Sim->getInteraction(Sim->particles[id1], Sim->particles[id2])
-		->validateState(Sim->particles[id1], Sim->particles[id2], (warnings < 101)))
-	      ++warnings;
-      }
-    
-    for(const Particle& part : Sim->particles)
-      for (const shared_ptr<Local>& lcl : Sim->locals)
-      if (lcl->isInteraction(part))
-	if (lcl->validateState(part, (warnings < 101)))
+    //The pairs and locals are tested (silently) in parallel, then the
+    //invalid states are retested in order to report them exactly as
+    //a serial test would.
+    std::vector<std::vector<std::pair<size_t, size_t> > > invalidPairs(parallelBatches(Sim->N(), _parallelSafe));
+    parallelFor(Sim->N(), [&](const size_t batch, const size_t begin, const size_t end) {
+	for (size_t id1(begin); id1 < end; ++id1)
+	  {
+	    const Particle& p1 = Sim->particles[id1];
+	    std::unique_ptr<IDRange> ids(getParticleNeighbours(p1));
+	    ids->forEach([&](const size_t id2) {
+		if (id2 > id1)
+		  if (Sim->getInteraction(p1, Sim->particles[id2])->validateState(p1, Sim->particles[id2], false))
+		    invalidPairs[batch].push_back(std::make_pair(id1, id2));
+	      });
+	  }
+      }, _parallelSafe);
+
+    for (const auto& batch : invalidPairs)
+      for (const auto& pair : batch)
+	if (Sim->getInteraction(Sim->particles[pair.first], Sim->particles[pair.second])
+	    ->validateState(Sim->particles[pair.first], Sim->particles[pair.second], (warnings < 101)))
+	  ++warnings;
+
+    std::vector<std::vector<std::pair<size_t, size_t> > > invalidLocals(parallelBatches(Sim->N(), _parallelSafe));
+    parallelFor(Sim->N(), [&](const size_t batch, const size_t begin, const size_t end) {
+	for (size_t id(begin); id < end; ++id)
+	  for (size_t localID(0); localID < Sim->locals.size(); ++localID)
+	    if (Sim->locals[localID]->isInteraction(Sim->particles[id]))
+	      if (Sim->locals[localID]->validateState(Sim->particles[id], false))
+		invalidLocals[batch].push_back(std::make_pair(id, localID));
+      }, _parallelSafe);
+
+    for (const auto& batch : invalidLocals)
+      for (const auto& local : batch)
+	if (Sim->locals[local.second]->validateState(Sim->particles[local.first], (warnings < 101)))
 	  ++warnings;
     
     if (warnings > 100)
@@ -86,17 +135,204 @@ namespace dynamo {
     rebuildList();
   }
 
+  void
+  Scheduler::saveCheckpoint(std::ostream& os, bool withFEL) const
+  {
+    checkpoint::write(os, uint64_t(_interactionRejectionCounter));
+    checkpoint::write(os, uint64_t(_localRejectionCounter));
+
+    //The stored system events are only reused if the systems (and
+    //their timers) are unchanged on the restart
+    checkpoint::write(os, uint64_t(Sim->systems.size()));
+    for (const auto& sysptr : Sim->systems)
+      {
+	checkpoint::write(os, sysptr->getName());
+	checkpoint::write(os, sysptr->getdt());
+      }
+
+    checkpoint::write(os, uint8_t(withFEL));
+    if (!withFEL) return;
+
+    //Flush any pending updates of the sorter. The next call to top()
+    //would do the same, so this does not alter the run.
+    sorter->empty();
+    std::ostringstream felData;
+    sorter->saveCheckpoint(felData);
+    checkpoint::write(os, std::string(typeid(*sorter).name()));
+    checkpoint::write(os, felData.str());
+  }
+
+  void
+  Scheduler::loadCheckpoint(std::istream& is)
+  {
+    _checkpoint.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+  }
+
+  bool
+  Scheduler::restoreCheckpoint()
+  {
+    if (_checkpoint.empty()) return false;
+
+    std::istringstream is(_checkpoint);
+    _checkpoint.clear();
+
+    uint64_t interactionRejections, localRejections;
+    checkpoint::read(is, interactionRejections);
+    checkpoint::read(is, localRejections);
+    _interactionRejectionCounter = interactionRejections;
+    _localRejectionCounter = localRejections;
+
+    uint64_t systemCount;
+    checkpoint::read(is, systemCount);
+    bool systemsChanged = (systemCount != Sim->systems.size());
+    for (size_t i(0); i < systemCount; ++i)
+      {
+	std::string name;
+	double dt;
+	checkpoint::read(is, name);
+	checkpoint::read(is, dt);
+	systemsChanged = systemsChanged || (i >= Sim->systems.size()) 
+	  || (Sim->systems[i]->getName() != name) || (Sim->systems[i]->getdt() != dt);
+      }
+
+    uint8_t withFEL;
+    checkpoint::read(is, withFEL);
+    std::string felType, felData;
+    if (withFEL)
+      {
+	checkpoint::read(is, felType);
+	checkpoint::read(is, felData);
+      }
+
+    //The configuration was valid when it was checkpointed, so it is
+    //not revalidated here.
+    if (withFEL && (felType == typeid(*sorter).name()))
+      {
+	dout << "Restoring the event list of collision " << Sim->eventCount << " from the checkpoint" << std::endl;
+	sorter->clear();
+	sorter->init(Sim->N() + 1);
+	std::istringstream felStream(felData);
+	sorter->loadCheckpoint(felStream);
+	if (systemsChanged)
+	  rebuildSystemEvents();
+      }
+    else
+      {
+	if (withFEL)
+	  derr << "The checkpointed event list is for a different sorter, rebuilding it" << std::endl;
+	dout << "Building all events on collision " << Sim->eventCount << std::endl;
+	rebuildList();
+      }
+
+    return true;
+  }
+
   void
   Scheduler::rebuildList()
   {
     sorter->clear();
     sorter->init(Sim->N() + 1);
 
-    for (Particle& part : Sim->particles)
-      addEvents(part);
+    if (!_parallelSafe)
+      {
+	for (Particle& part : Sim->particles)
+	  addEvents(part);
+	rebuildSystemEvents();
+	return;
+      }
+
+    //The interaction events of whole blocks of particles are
+    //predicted in parallel. Everything is brought up to date first,
+    //so the predictions only read the particles.
+    Sim->dynamics->updateAllParticles();
+
+    //The blocks limit the memory held by the predicted events
+    const size_t blockSize = 65536;
+    std::vector<std::vector<Event> > events(parallelBatches(blockSize, true));
+    std::vector<std::vector<size_t> > scanned(events.size()), ends(events.size());
+    for (size_t blockStart(0); blockStart < Sim->N(); blockStart += blockSize)
+      {
+	const size_t blockEnd = std::min(blockStart + blockSize, Sim->N());
+	const size_t batches = parallelBatches(blockEnd - blockStart, true);
+	parallelFor(blockEnd - blockStart, [&](const size_t batch, const size_t begin, const size_t end) {
+	    events[batch].clear();
+	    scanned[batch].clear();
+	    ends[batch].clear();
+	    for (size_t id1(blockStart + begin); id1 < blockStart + end; ++id1)
+	      {
+		const Particle& part = Sim->particles[id1];
+		const bool sleeping = part.testState(Particle::SLEEPING);
+		std::unique_ptr<IDRange> ids(sleeping ? getAwakeParticleNeighbours(part) : getExposedParticleNeighbours(part));
+		scanned[batch].push_back(ids->size());
+		ids->forEach([&](const size_t id2) {
+		    if ((id2 != id1) && (!sleeping || !Sim->particles[id2].testState(Particle::SLEEPING)))
+		      events[batch].push_back(Sim->getEvent(part, Sim->particles[id2]));
+		  });
+		ends[batch].push_back(events[batch].size());
+	      }
+	  }, true);
+
+	//Merge the events in the order addEvents() pushes them, so the
+	//FEL is identical to a serial build
+	size_t id1 = blockStart;
+	for (size_t batch(0); batch < batches; ++batch)
+	  {
+	    auto event = events[batch].begin();
+	    for (size_t i(0); i < scanned[batch].size(); ++i)
+	      {
+		const size_t neighbours = scanned[batch][i];
+		Particle& part = Sim->particles[id1++];
+		for (const shared_ptr<Global>& glob : Sim->globals)
+		  if (glob->isInteraction(part))
+		    sorter->push(glob->getEvent(part));
+
+		std::unique_ptr<IDRange> ids(getParticleLocals(part));
+		ids->forEach([&](const size_t id2) { addLocalEvent(part, id2); });
+
+		if (_profile)
+		  {
+		    if (_profile->neighbourScans.size() <= neighbours)
+		      _profile->neighbourScans.resize(neighbours + 1, 0);
+		    ++_profile->neighbourScans[neighbours];
+		  }
+
+		for (const auto last = events[batch].begin() + ends[batch][i]; event != last; ++event)
+		  sorter->push(*event);
+	      }
+	  }
+      }
+
     rebuildSystemEvents();
   }
 
+  size_t
+  Scheduler::parallelBatches(const size_t count, const bool threadSafe) const
+  {
+    if (!threadSafe || !_predictionThreads)
+      return std::min(count, size_t(1));
+
+    return std::min(count, 4 * _predictionThreads);
+  }
+
+  void
+  Scheduler::parallelFor(const size_t count, const std::function<void(size_t, size_t, size_t)>& func, const bool threadSafe)
+  {
+    const size_t batches = parallelBatches(count, threadSafe);
+    if (batches < 2)
+      {
+	if (count) func(0, 0, count);
+	return;
+      }
+
+    if (!_predictionPool)
+      _predictionPool.reset(new magnet::thread::ThreadPool);
+    _predictionPool->setThreadCount(_predictionThreads);
+
+    for (size_t batch(0); batch < batches; ++batch)
+      _predictionPool->queueTask(std::bind(func, batch, batch * count / batches, (batch + 1) * count / batches));
+    _predictionPool->wait();
+  }
+
 
   void 
   Scheduler::addEvents(Particle& part)
@@ -110,14 +346,54 @@ namespace dynamo {
   
     //Add the local cell events
     std::unique_ptr<IDRange> ids(getParticleLocals(part));
-    
-    for (const size_t id2 : *ids)
-      addLocalEvent(part, id2);
+    ids->forEach([&](const size_t id2) { addLocalEvent(part, id2); });
 
-    //Now add the interaction events
-    ids = getParticleNeighbours(part);
-    for (const size_t id2 : *ids)
-      addInteractionEvent(part, id2);
+    //Now add the interaction events. A sleeping particle is at rest,
+    //so it only has events with the awake particles, and an awake
+    //particle cannot reach the sleeping particles buried in their
+    //islands.
+    const bool sleeping = part.testState(Particle::SLEEPING);
+    ids = sleeping ? getAwakeParticleNeighbours(part) : getExposedParticleNeighbours(part);
+
+    if (_profile)
+      {
+	const size_t scanned = ids->size();
+	if (_profile->neighbourScans.size() <= scanned)
+	  _profile->neighbourScans.resize(scanned + 1, 0);
+	++_profile->neighbourScans[scanned];
+      }
+
+    if (!_parallelSafe || (ids->size() < _parallelThreshold))
+      {
+	ids->forEach([&](const size_t id2) {
+	    if (!sleeping || !Sim->particles[id2].testState(Particle::SLEEPING))
+	      addInteractionEvent(part, id2);
+	  });
+	return;
+      }
+
+    //Bring the neighbours up to date serially, as this modifies them
+    _predictionIDs.clear();
+    ids->forEach([&](const size_t id2) {
+	if ((id2 != part.getID()) && (!sleeping || !Sim->particles[id2].testState(Particle::SLEEPING)))
+	  {
+	    Sim->dynamics->updateParticle(Sim->particles[id2]);
+	    _predictionIDs.push_back(id2);
+	  }
+      });
+
+    //The predictions only read the particles, and are split into a
+    //few contiguous batches per thread to balance the load
+    _predictionEvents.resize(_predictionIDs.size());
+    parallelFor(_predictionIDs.size(), [&](const size_t, const size_t begin, const size_t end) {
+	for (size_t i(begin); i < end; ++i)
+	  _predictionEvents[i] = Sim->getEvent(part, Sim->particles[_predictionIDs[i]]);
+      }, true);
+
+    //The events are pushed in the order of the neighbour range, so
+    //the FEL is identical to the serial prediction
+    for (const Event& event : _predictionEvents)
+      sorter->push(event);
   }
 
   shared_ptr<Scheduler>
@@ -137,6 +413,10 @@ namespace dynamo {
   magnet::xml::XmlStream& operator<<(magnet::xml::XmlStream& XML, 
 				     const Scheduler& g)
   {
+    if (g._predictionThreads)
+      XML << magnet::xml::attr("Threads") << g._predictionThreads
+	  << magnet::xml::attr("ParallelThreshold") << g._parallelThreshold;
+
     g.outputXML(XML);
     return XML;
   }
@@ -168,6 +448,33 @@ namespace dynamo {
 
   void
   Scheduler::runNextEvent()
+  {
+    if (!_profile)
+      {
+	executeNextEvent();
+	return;
+      }
+
+    const Event next_event = sorter->top();
+    const uint64_t start = magnet::cputicks();
+    const bool executed = executeNextEvent();
+    const uint64_t ticks = magnet::cputicks() - start;
+
+    if (next_event._type == RECALCULATE)
+      _profile->recalculations.add(ticks);
+    else if (!executed)
+      (next_event._source == LOCAL ? _profile->localRejections : _profile->interactionRejections).add(ticks);
+    else
+      {
+	const size_t id = _profile->eventIndex.getID(next_event);
+	if (id >= _profile->events.size())
+	  _profile->events.resize(id + 1);
+	_profile->events[id].add(ticks);
+      }
+  }
+
+  bool
+  Scheduler::executeNextEvent()
   {
 #ifdef DYNAMO_DEBUG
     if (sorter->empty())
@@ -225,7 +532,7 @@ namespace dynamo {
 	  // events for this particle recalculated.
 	  this->fullUpdate(Sim->particles[next_event._particle1ID]);
 
-	return;
+	return false;
       }
     
     if (next_event._type == NONE)
@@ -288,7 +595,7 @@ namespace dynamo {
 	  if ((Event._type == NONE) || ((Event._dt > next_event._dt) && (++_interactionRejectionCounter < rejectionLimit)))
 	    {
 	      this->fullUpdate(p1, p2);
-	      return;
+	      return false;
 	    }
 
 	  //Reset the rejection watchdog counter as we are about to
@@ -338,7 +645,14 @@ namespace dynamo {
 	  //We don't stream the system for globals as neighbour lists
 	  //optimise this (they dont need it).  We also don't recheck
 	  //Global events! (Check, some events might rely on this
-	  //behavior)
+	  //behavior). Only events the Global itself has outdated are
+	  //dropped.
+	  if (!Sim->globals[next_event._sourceID]->isEventValid(next_event))
+	    {
+	      sorter->pop();
+	      return false;
+	    }
+
 	  Sim->globals[next_event._sourceID]->runEvent(Sim->particles[next_event._particle1ID], next_event._dt);
 	  break;
 	}
@@ -367,7 +681,7 @@ namespace dynamo {
 	  if ((iEvent._type == NONE) || ((iEvent._dt > next_event._dt) && (++_localRejectionCounter < rejectionLimit)))
 	    {
 	      this->fullUpdate(part);
-	      return;
+	      return false;
 	    }
 
 	  _localRejectionCounter = 0;
@@ -406,7 +720,10 @@ namespace dynamo {
 		      << "\nParticle ID = " << next_event._particle1ID
 		      << "\nSystem (ID=" << next_event._sourceID << ")= " << Sim->systems[next_event._sourceID]->getName()
 	      ;
-	  
+
+	  //Immediate events are run at the current time
+	  next_event._dt = std::max(next_event._dt, 0.0);
+
 	  Sim->systemTime += next_event._dt;
 	  stream(next_event._dt);
 	  Sim->stream(next_event._dt);
@@ -434,6 +751,8 @@ namespace dynamo {
 	M_throw() << "Unhandled event type requested to be run\n"
 		  << "Type is " << next_event._type;
       }
+
+    return true;
   }
 
   void 
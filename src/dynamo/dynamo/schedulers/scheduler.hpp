@@ -20,11 +20,18 @@
 #include <dynamo/schedulers/sorters/FEL.hpp>
 #include <magnet/math/vector.hpp>
 #include <magnet/function/delegate.hpp>
+#include <magnet/timer.hpp>
 #include <dynamo/ranges/IDRange.hpp>
+#include <dynamo/outputplugins/eventtypetracking.hpp>
+#include <functional>
 #include <memory>
 #include <vector>
+#include <map>
+#include <string>
+#include <iosfwd>
 
 namespace magnet { namespace xml { class Node; } }
+namespace magnet { namespace thread { class ThreadPool; } }
 
 namespace dynamo {
   class Particle;
@@ -33,6 +40,38 @@ namespace dynamo {
   class Scheduler: public dynamo::SimBase
   {
   public:
+    /*! \brief Statistics on the cost of the event loop.
+
+      These are only collected if a Profile has been attached to the
+      Scheduler (see setProfile() and the OPProfiler output
+      plugin). All timings are in raw magnet::cputicks() units.
+     */
+    struct Profile
+    {
+      struct Counter
+      {
+	Counter(): count(0), ticks(0) {}
+	void add(const uint64_t t) { ++count; ticks += t; }
+	size_t count;
+	uint64_t ticks;
+      };
+
+      //! Maps the source and type of the executed events to their counter.
+      EventTypeTracking::EventIndex eventIndex;
+      //! Executed events, indexed by their eventIndex ID.
+      std::vector<Counter> events;
+      //! RECALCULATE events.
+      Counter recalculations;
+      //! Interaction events which were rejected as out of sequence.
+      Counter interactionRejections;
+      //! Local events which were rejected as out of sequence.
+      Counter localRejections;
+      //! Calls of fullUpdate (these are nested within the above).
+      Counter fullUpdates;
+      //! Histogram of the number of neighbours scanned in addEvents().
+      std::vector<size_t> neighbourScans;
+    };
+
     Scheduler(dynamo::Simulation* const, const char *, FEL*);
   
     virtual ~Scheduler() = 0;
@@ -46,8 +85,11 @@ namespace dynamo {
      */
     inline void fullUpdate(Particle& part)
     {
+      const uint64_t start = _profile ? magnet::cputicks() : 0;
       invalidateEvents(part);
       addEvents(part);
+      if (_profile)
+	_profile->fullUpdates.add(magnet::cputicks() - start);
     }
 
     /*! \brief Retest for events for two particles.
@@ -82,6 +124,11 @@ namespace dynamo {
   
     void runNextEvent();
 
+    /*! \brief Attach a Profile to collect event loop statistics in
+        (or detach it by passing an empty pointer).
+     */
+    void setProfile(const shared_ptr<Profile>& profile) { _profile = profile; }
+
     friend magnet::xml::XmlStream& operator<<(magnet::xml::XmlStream&, const Scheduler&);
 
     static shared_ptr<Scheduler>
@@ -93,17 +140,69 @@ namespace dynamo {
 
     const shared_ptr<FEL>& getSorter() const { return sorter; }
 
+    void setSorter(const shared_ptr<FEL>& newSorter) { sorter = newSorter; }
+
+    /*! \brief Write the state of the scheduler to a checkpoint.
+
+      \param withFEL If true, the sorted event list is also stored so
+      that a restart does not need to repredict every event. The
+      stored list can only be restored into the same type of sorter.
+     */
+    void saveCheckpoint(std::ostream&, bool withFEL) const;
+
+    /*! \brief Load the scheduler state from a checkpoint.
+
+      The data is only applied when the scheduler is next initialised,
+      where it replaces the validation of the configuration and (if
+      the FEL was stored) the rebuild of the event list.
+     */
+    void loadCheckpoint(std::istream&);
+
     void rebuildSystemEvents() const;
 
     void addInteractionEvent(const Particle&, const size_t&) const;
     
     void addLocalEvent(const Particle&, const size_t&) const;
+
+    /*! \brief The number of batches parallelFor() splits count items
+        into.
+
+      \param threadSafe If false, the items are processed serially in
+      a single batch.
+     */
+    size_t parallelBatches(size_t count, bool threadSafe) const;
+
+    /*! \brief Calls func(batch, begin, end) for contiguous batches of
+        the items [0, count) on the worker threads.
+
+      Results collected per batch and merged in batch order are in the
+      same order as a serial loop, whatever the thread count.
+     */
+    void parallelFor(size_t count, const std::function<void(size_t, size_t, size_t)>& func, bool threadSafe);
     
     
     virtual double getNeighbourhoodDistance() const = 0;
     virtual std::unique_ptr<IDRange> getParticleNeighbours(const Particle&) const = 0;
     virtual std::unique_ptr<IDRange> getParticleNeighbours(const Vector&) const = 0;
     virtual std::unique_ptr<IDRange> getParticleLocals(const Particle&) const = 0;
+
+    /*! \brief The neighbours of a Particle::SLEEPING particle which
+        it may have events with.
+
+      The range may still contain sleeping particles, but
+      neighbourlists can leave out whole regions of them.
+     */
+    virtual std::unique_ptr<IDRange> getAwakeParticleNeighbours(const Particle& part) const
+    { return getParticleNeighbours(part); }
+
+    /*! \brief The neighbours of an awake particle which it may have
+        events with.
+
+      Neighbourlists can leave out the sleeping particles buried
+      inside their islands.
+     */
+    virtual std::unique_ptr<IDRange> getExposedParticleNeighbours(const Particle& part) const
+    { return getParticleNeighbours(part); }
     
   protected:
     mutable shared_ptr<FEL> sorter;
@@ -111,6 +210,42 @@ namespace dynamo {
     size_t _interactionRejectionCounter;
     size_t _localRejectionCounter;
 
+    shared_ptr<Profile> _profile;
+
+    /*! \brief The worker threads used to predict interaction events
+        (the "Threads" attribute, zero disables the parallel mode).
+
+      When a particle has at least _parallelThreshold neighbours (the
+      "ParallelThreshold" attribute), addEvents() predicts its
+      interaction events in contiguous batches on these threads. The
+      validation of the configuration and the initial build of the
+      event list are also split over them (see parallelFor()).
+     */
+    size_t _predictionThreads;
+    size_t _parallelThreshold;
+    //! True if every Interaction::threadSafeGetEvent().
+    bool _parallelSafe;
+    std::unique_ptr<magnet::thread::ThreadPool> _predictionPool;
+    //! The neighbour IDs and events of the current parallel prediction.
+    std::vector<size_t> _predictionIDs;
+    std::vector<Event> _predictionEvents;
+
+    //! Checkpoint data waiting to be applied in initialise().
+    std::string _checkpoint;
+
+    /*! \brief Apply any checkpoint data loaded by loadCheckpoint().
+
+      \return true if the scheduler was initialised from a checkpoint.
+     */
+    bool restoreCheckpoint();
+
+    /*! \brief Execute (or reschedule) the next event in the FEL.
+
+      \return false if the event was deferred instead of being
+      executed (a RECALCULATE event or a rejected event).
+     */
+    bool executeNextEvent();
+
     virtual void outputXML(magnet::xml::XmlStream&) const = 0;
   };
 }
@@ -20,11 +20,21 @@
 #include <dynamo/schedulers/sorters/FEL.hpp>
 #include <magnet/exception.hpp>
 #include <magnet/xmlwriter.hpp>
+#include <dynamo/checkpoint.hpp>
 #include <vector>
 #include <cmath>
 
 namespace dynamo {
-  template<class PEL>
+  /*! \brief A Future Event List using a complete binary (tournament)
+      tree over the Particle Event Lists.
+
+    \tparam CachedKeys If true, the minimum event time of each PEL is
+    also stored in a dense array (_Key), which is synchronised when
+    the changes to a PEL are flushed. The tree comparisons then only
+    read contiguous doubles instead of copying the top Event out of
+    two (large and scattered) PELs at every level of the tree.
+   */
+  template<class PEL, bool CachedKeys = false>
   class CBTFEL: public FEL
   {
   public:
@@ -35,6 +45,8 @@ namespace dynamo {
       _CBT.resize(2 * N);
       _Leaf.resize(N + 1, std::numeric_limits<size_t>::max());
       _Min.resize(N + 1);
+      if (CachedKeys)
+	_Key.resize(N + 1, std::numeric_limits<float>::infinity());
       _eventCount.resize(N, 0);
     }
 
@@ -43,6 +55,7 @@ namespace dynamo {
       _CBT.clear();
       _Leaf.clear();
       _Min.clear();
+      _Key.clear();
       _N = 0;
       _NP = 0;
       _pecTime = 0.0;
@@ -61,6 +74,8 @@ namespace dynamo {
 	{
 	  for (auto& pDat : _Min)
 	    pDat.stream(_pecTime);
+	  for (double& key : _Key)
+	    key -= _pecTime;
 	  _pecTime = 0.0;
 	}
     }
@@ -125,9 +140,48 @@ namespace dynamo {
     {
       for (auto& pDat : _Min)
 	pDat.rescaleTimes(factor);
+      for (double& key : _Key)
+	key *= factor;
       _pecTime *= factor;
     }
 
+    virtual void saveCheckpoint(std::ostream& os) const
+    {
+      if (_activeID != std::numeric_limits<size_t>::max())
+	M_throw() << "Cannot checkpoint an unsorted FEL";
+
+      checkpoint::write(os, uint64_t(_Min.size()));
+      for (const auto& pDat : _Min)
+	pDat.saveCheckpoint(os);
+      checkpoint::write(os, _CBT);
+      checkpoint::write(os, _Leaf);
+      checkpoint::write(os, _eventCount);
+      checkpoint::write(os, _NP);
+      checkpoint::write(os, _streamFreq);
+      checkpoint::write(os, _nUpdate);
+      checkpoint::write(os, _pecTime);
+    }
+
+    virtual void loadCheckpoint(std::istream& is)
+    {
+      uint64_t size;
+      checkpoint::read(is, size);
+      if (size != _Min.size())
+	M_throw() << "The checkpointed FEL has a different particle count (" << size - 1 << " != " << _Min.size() - 1 << ")";
+      for (auto& pDat : _Min)
+	pDat.loadCheckpoint(is);
+      checkpoint::read(is, _CBT);
+      checkpoint::read(is, _Leaf);
+      checkpoint::read(is, _eventCount);
+      checkpoint::read(is, _NP);
+      checkpoint::read(is, _streamFreq);
+      checkpoint::read(is, _nUpdate);
+      checkpoint::read(is, _pecTime);
+      for (size_t i(0); i < _Key.size(); ++i)
+	_Key[i] = _Min[i].top()._dt;
+      _activeID = std::numeric_limits<size_t>::max();
+    }
+
     protected:
     size_t _activeID;
 
@@ -139,6 +193,9 @@ namespace dynamo {
 	      Delete(_activeID + 1);
 	    }
 	  } else {
+	    if (CachedKeys)
+	      _Key[_activeID + 1] = _Min[_activeID + 1].top()._dt;
+
 	    if (_Leaf[_activeID + 1] == std::numeric_limits<size_t>::max()) {
 	      Insert(_activeID + 1);
 	    }
@@ -153,12 +210,18 @@ namespace dynamo {
     std::vector<size_t> _CBT;
     std::vector<size_t> _Leaf;
     std::vector<PEL> _Min;
+    //! The minimum event time of each PEL (only used if CachedKeys).
+    std::vector<double> _Key;
     size_t _NP, _N, _streamFreq, _nUpdate;
   
     double _pecTime;
   
     std::vector<size_t> _eventCount;
 
+    //! \brief Returns true if the next event of PEL i is after PEL j's.
+    inline bool later(const size_t i, const size_t j) const
+    { return CachedKeys ? (_Key[i] > _Key[j]) : (_Min[i] > _Min[j]); }
+
     ///////////////////////////BINARY TREE IMPLEMENTATION
     inline void UpdateCBT(const size_t i)
     {
@@ -168,7 +231,7 @@ namespace dynamo {
 	{
 	  size_t l = _CBT[f*2],
 	    r = _CBT[f*2+1];
-	  _CBT[f] = (_Min[r] > _Min[l]) ? l : r;
+	  _CBT[f] = later(r, l) ? l : r;
 	}
 
       //Walk up finding the winners till it doesn't change or you hit
@@ -179,7 +242,7 @@ namespace dynamo {
 	    l = _CBT[f*2],
 	    r = _CBT[f*2+1];
 	
-	  _CBT[f] = (_Min[r] > _Min[l]) ? l : r;
+	  _CBT[f] = later(r, l) ? l : r;
 
 	  if (_CBT[f] == w) return; /* end of the event time comparisons */
 	}
@@ -208,7 +271,14 @@ namespace dynamo {
   
     inline void Delete(const size_t i)
     {
-      if (_NP < 2) { _CBT[1]=0; _Leaf[0]=1; --_NP; return; }
+      if (_NP < 2)
+	{
+	  _CBT[1]=0;
+	  _Leaf[0]=1;
+	  _Leaf[i] = std::numeric_limits<size_t>::max();
+	  --_NP;
+	  return;
+	}
 
       size_t l = _NP * 2 - 1;
 
@@ -238,6 +308,6 @@ namespace dynamo {
     }
 
     virtual void outputXML(magnet::xml::XmlStream& XML) const
-    { XML << magnet::xml::attr("Type") << (std::string("CBT") + PEL::name()); }
+    { XML << magnet::xml::attr("Type") << (std::string(CachedKeys ? "CBTKey" : "CBT") + PEL::name()); }
     };
   }
@@ -20,6 +20,8 @@
 #include <dynamo/schedulers/sorters/referenceFEL.hpp>
 #include <dynamo/schedulers/sorters/CBTFEL.hpp>
 #include <dynamo/schedulers/sorters/boundedPQFEL.hpp>
+#include <dynamo/schedulers/sorters/quadHeapFEL.hpp>
+#include <dynamo/schedulers/sorters/ladderFEL.hpp>
 #include <dynamo/simulation.hpp>
 #include <magnet/xmlwriter.hpp>
 #include <magnet/xmlreader.hpp>
@@ -28,27 +30,42 @@ namespace dynamo {
   shared_ptr<FEL>
   FEL::getClass(const magnet::xml::Node& XML)
   {
-    if (std::string(XML.getAttribute("Type")) == std::string("BoundedPQHeap"))
+    return getClass(std::string(XML.getAttribute("Type")));
+  }
+
+  shared_ptr<FEL>
+  FEL::getClass(const std::string& type)
+  {
+    if (type == "BoundedPQHeap")
       return shared_ptr<FEL>(new BoundedPQFEL<HeapPEL>());
-    if (std::string(XML.getAttribute("Type")) == std::string("BoundedPQMinMax2"))
+    if (type == "BoundedPQMinMax2")
       return shared_ptr<FEL>(new BoundedPQFEL<MinMaxPEL<2> >());
-    if (std::string(XML.getAttribute("Type")) == std::string("BoundedPQMinMax3"))
+    if (type == "BoundedPQMinMax3")
       return shared_ptr<FEL>(new BoundedPQFEL<MinMaxPEL<3> >());
-    if (std::string(XML.getAttribute("Type")) == std::string("BoundedPQMinMax4"))
+    if (type == "BoundedPQMinMax4")
       return shared_ptr<FEL>(new BoundedPQFEL<MinMaxPEL<4> >());
-    if (std::string(XML.getAttribute("Type")) == std::string("BoundedPQMinMax5"))
+    if (type == "BoundedPQMinMax5")
       return shared_ptr<FEL>(new BoundedPQFEL<MinMaxPEL<5> >());
-    if (std::string(XML.getAttribute("Type")) == std::string("BoundedPQMinMax6"))
+    if (type == "BoundedPQMinMax6")
       return shared_ptr<FEL>(new BoundedPQFEL<MinMaxPEL<6> >());
-    if (std::string(XML.getAttribute("Type")) == std::string("BoundedPQMinMax7"))
+    if (type == "BoundedPQMinMax7")
       return shared_ptr<FEL>(new BoundedPQFEL<MinMaxPEL<7> >());
-    if (std::string(XML.getAttribute("Type")) == std::string("BoundedPQMinMax8"))
+    if (type == "BoundedPQMinMax8")
       return shared_ptr<FEL>(new BoundedPQFEL<MinMaxPEL<8> >());
-    else if ((std::string(XML.getAttribute("Type")) == std::string("CBT"))
-	     || (std::string(XML.getAttribute("Type")) == std::string("CBTHeap")))
+    else if ((type == "CBT") || (type == "CBTHeap"))
       return shared_ptr<FEL>(new CBTFEL<HeapPEL>());
+    else if ((type == "CBTKey") || (type == "CBTKeyHeap"))
+      return shared_ptr<FEL>(new CBTFEL<HeapPEL, true>());
+    else if (type == "QuadHeapHeap")
+      return shared_ptr<FEL>(new QuadHeapFEL<HeapPEL>());
+    else if (type == "QuadHeapMinMax3")
+      return shared_ptr<FEL>(new QuadHeapFEL<MinMaxPEL<3> >());
+    else if (type == "LadderHeap")
+      return shared_ptr<FEL>(new LadderFEL<HeapPEL>());
+    else if (type == "LadderMinMax3")
+      return shared_ptr<FEL>(new LadderFEL<MinMaxPEL<3> >());
     else 
-      M_throw() << "Unknown type of Sorter encountered";
+      M_throw() << "Unknown type of Sorter encountered (" << type << ")";
   }
 
   magnet::xml::XmlStream& operator<<(magnet::xml::XmlStream& XML, const FEL& srtr)
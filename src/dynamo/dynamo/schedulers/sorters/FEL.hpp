@@ -18,6 +18,7 @@
 #pragma once
 #include <dynamo/base.hpp>
 #include <dynamo/eventtypes.hpp>
+#include <string>
 
 namespace magnet { namespace xml { class Node; class XmlStream; } }
 
@@ -95,8 +96,32 @@ namespace dynamo {
     virtual void stream(const double) = 0;
     
     virtual Event top() = 0;
+
+    /*! \brief The number of events which fell outside the primary
+        sorting structure of the FEL and had to be handled by a
+        (slower) overflow mechanism.
+     */
+    virtual size_t overflowCount() const { return 0; }
+
+    /*! \brief Write the exact state of the FEL to a binary
+        checkpoint (see Simulation::writeCheckpoint()).
+
+      The FEL must be in a sorted state (see empty()).
+     */
+    virtual void saveCheckpoint(std::ostream&) const
+    { M_throw() << "This sorter does not support checkpointing"; }
+
+    /*! \brief Restore the state of the FEL from a binary checkpoint.
+
+      The FEL must have been initialised (see init()) for the same
+      number of particles as when the checkpoint was written.
+     */
+    virtual void loadCheckpoint(std::istream&)
+    { M_throw() << "This sorter does not support checkpointing"; }
  
     static shared_ptr<FEL> getClass(const magnet::xml::Node&);
+    //! Construct a FEL from its type name (as used in the XML "Type" attribute).
+    static shared_ptr<FEL> getClass(const std::string&);
     friend ::magnet::xml::XmlStream& operator<<(::magnet::xml::XmlStream&, const FEL&);
 
   private:
@@ -17,6 +17,7 @@
 
 #pragma once
 #include <dynamo/eventtypes.hpp>
+#include <dynamo/checkpoint.hpp>
 #include <magnet/containers/MinMaxHeap.hpp>
 #include <string>
 
@@ -96,6 +97,10 @@ namespace dynamo {
       _store.swap(rhs._store);
     }
 
+    void saveCheckpoint(std::ostream& os) const { checkpoint::write(os, _store); }
+
+    void loadCheckpoint(std::istream& is) { checkpoint::read(is, _store); }
+
     static inline std::string name()
     { return "MinMax" + std::to_string(Size); }
   };
@@ -34,6 +34,20 @@ namespace dynamo {
     struct BPQEntry : public PEL {
       BPQEntry(): next(NO_LINK), previous(NO_LINK), qIndex(NO_LINK) {}
       size_t next, previous, qIndex;
+
+      void saveCheckpoint(std::ostream& os) const {
+	PEL::saveCheckpoint(os);
+	checkpoint::write(os, next);
+	checkpoint::write(os, previous);
+	checkpoint::write(os, qIndex);
+      }
+
+      void loadCheckpoint(std::istream& is) {
+	PEL::loadCheckpoint(is);
+	checkpoint::read(is, next);
+	checkpoint::read(is, previous);
+	checkpoint::read(is, qIndex);
+      }
     };
   }
 
@@ -59,6 +73,30 @@ namespace dynamo {
       std::cout << "Exception Events = " << exceptionCount << std::endl;
     }
 
+    virtual size_t overflowCount() const { return exceptionCount; }
+
+    virtual void saveCheckpoint(std::ostream& os) const
+    {
+      Base::saveCheckpoint(os);
+      checkpoint::write(os, linearLists);
+      checkpoint::write(os, currentIndex);
+      checkpoint::write(os, scale);
+      checkpoint::write(os, nlists);
+      checkpoint::write(os, exceptionCount);
+      checkpoint::write(os, _optimizeCounter);
+    }
+
+    virtual void loadCheckpoint(std::istream& is)
+    {
+      Base::loadCheckpoint(is);
+      checkpoint::read(is, linearLists);
+      checkpoint::read(is, currentIndex);
+      checkpoint::read(is, scale);
+      checkpoint::read(is, nlists);
+      checkpoint::read(is, exceptionCount);
+      checkpoint::read(is, _optimizeCounter);
+    }
+
     void init(const size_t N)
     {
       clear();
@@ -243,6 +281,10 @@ namespace dynamo {
 
     inline void orderNextEvent()
     {
+      //In CBT mode every PEL is inserted in the CBT, so there is
+      //nothing to move in (and the list width is infinite)
+      if (scale == 0) return;
+
       while(Base::_NP==0)
 	{
 	  /*The current priority queue is exhausted, move on to the
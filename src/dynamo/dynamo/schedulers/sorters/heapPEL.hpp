@@ -17,6 +17,7 @@
 
 #pragma once
 #include <dynamo/eventtypes.hpp>
+#include <dynamo/checkpoint.hpp>
 #include <vector>
 #include <algorithm>
 #include <functional>
@@ -78,6 +79,10 @@ namespace dynamo {
       std::swap(_store, rhs._store);
     }
 
+    void saveCheckpoint(std::ostream& os) const { checkpoint::write(os, _store); }
+
+    void loadCheckpoint(std::istream& is) { checkpoint::read(is, _store); }
+
     static inline std::string name()
     { return "Heap"; }
   };
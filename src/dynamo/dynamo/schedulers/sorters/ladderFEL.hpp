@@ -0,0 +1,389 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <dynamo/eventtypes.hpp>
+#include <dynamo/schedulers/sorters/CBTFEL.hpp>
+#include <magnet/exception.hpp>
+#include <string>
+#include <vector>
+#include <limits>
+#include <cmath>
+
+namespace dynamo {
+  namespace detail {
+    template<class PEL>
+    struct LadderEntry : public PEL {
+      LadderEntry():
+	next(std::numeric_limits<size_t>::max()),
+	previous(std::numeric_limits<size_t>::max()),
+	rung(std::numeric_limits<size_t>::max()),
+	bucket(std::numeric_limits<size_t>::max())
+      {}
+
+      size_t next, previous, rung, bucket;
+
+      void saveCheckpoint(std::ostream& os) const {
+	PEL::saveCheckpoint(os);
+	checkpoint::write(os, next);
+	checkpoint::write(os, previous);
+	checkpoint::write(os, rung);
+	checkpoint::write(os, bucket);
+      }
+
+      void loadCheckpoint(std::istream& is) {
+	PEL::loadCheckpoint(is);
+	checkpoint::read(is, next);
+	checkpoint::read(is, previous);
+	checkpoint::read(is, rung);
+	checkpoint::read(is, bucket);
+      }
+    };
+  }
+
+  /*! \brief A Future Event List which sorts the Particle Event Lists
+      using a ladder queue.
+
+    The ladder queue (Tang, Goh and Thng, ACM TOMACS 15, 175 (2005))
+    has three tiers:
+
+    - The "top", an unsorted list of the PELs whose next event is
+      beyond _topStart.
+
+    - A ladder of "rungs" of buckets. When the rest of the queue is
+      exhausted, the top is spread over a new rung with (on average)
+      one PEL per bucket. Each lower rung subdivides a single crowded
+      bucket of the rung above.
+
+    - The "bottom", which holds the PELs of the earliest bucket and is
+      sorted by the complete binary tree of the CBTFEL.
+
+    Buckets are transferred to the bottom in order, and buckets with
+    more than Threshold PELs are first split into a new rung. The
+    bucket widths therefore adapt to the event-time distribution,
+    making the ladder well suited to systems with very heterogeneous
+    event rates (e.g., granular systems). Like the BoundedPQFEL, the
+    lazy deletion of invalidated events is inherited from the CBTFEL.
+   */
+  template<typename PEL>
+  class LadderFEL: public CBTFEL<detail::LadderEntry<PEL> >
+  {
+    typedef CBTFEL<detail::LadderEntry<PEL> > Base;
+
+    struct Rung
+    {
+      double start, width;
+      //! The next bucket to be transferred to the bottom.
+      size_t current;
+      //! The head of the linked list of PELs in each bucket.
+      std::vector<size_t> buckets;
+
+      double currentStart() const { return start + width * current; }
+    };
+
+    //! The LadderEntry::rung value of PELs in the top.
+    static const size_t InTop = std::numeric_limits<size_t>::max() - 1;
+    //! The LadderEntry::rung value of PELs in the bottom.
+    static const size_t InBottom = std::numeric_limits<size_t>::max() - 2;
+    //! Buckets holding more PELs than this are split into a new rung.
+    static const size_t Threshold = 50;
+    static const size_t MaxRungs = 8;
+
+    size_t _top;
+    double _topStart;
+    //! The rungs (only the first _nRungs are in use).
+    std::vector<Rung> _rungs;
+    size_t _nRungs;
+
+  public:
+    LadderFEL() { clear(); }
+
+    void init(const size_t N)
+    {
+      clear();
+      Base::init(N);
+    }
+
+    void clear()
+    {
+      Base::clear();
+      _top = std::numeric_limits<size_t>::max();
+      _topStart = -std::numeric_limits<double>::infinity();
+      _nRungs = 0;
+    }
+
+    inline void stream(const double ndt) { Base::_pecTime += ndt; }
+
+    inline void rescaleTimes(const double factor)
+    {
+      Base::rescaleTimes(factor);
+      _topStart *= factor;
+      for (size_t r(0); r < _nRungs; ++r)
+	{
+	  _rungs[r].start *= factor;
+	  _rungs[r].width *= factor;
+	}
+    }
+
+    inline void pop()
+    {
+      //Make sure the next event has been moved into the bottom
+      flushChanges();
+      Base::pop();
+    }
+
+    virtual void saveCheckpoint(std::ostream& os) const
+    {
+      Base::saveCheckpoint(os);
+      checkpoint::write(os, _top);
+      checkpoint::write(os, _topStart);
+      checkpoint::write(os, _nRungs);
+      for (size_t r(0); r < _nRungs; ++r)
+	{
+	  checkpoint::write(os, _rungs[r].start);
+	  checkpoint::write(os, _rungs[r].width);
+	  checkpoint::write(os, _rungs[r].current);
+	  checkpoint::write(os, _rungs[r].buckets);
+	}
+    }
+
+    virtual void loadCheckpoint(std::istream& is)
+    {
+      Base::loadCheckpoint(is);
+      checkpoint::read(is, _top);
+      checkpoint::read(is, _topStart);
+      checkpoint::read(is, _nRungs);
+      _rungs.resize(std::max(_rungs.size(), _nRungs));
+      for (size_t r(0); r < _nRungs; ++r)
+	{
+	  checkpoint::read(is, _rungs[r].start);
+	  checkpoint::read(is, _rungs[r].width);
+	  checkpoint::read(is, _rungs[r].current);
+	  checkpoint::read(is, _rungs[r].buckets);
+	}
+    }
+
+  private:
+    /*! \brief Reinsert the changed PEL, and make sure the bottom
+        holds the next event if the FEL is to be queried.
+     */
+    virtual void flushChanges(const size_t ID = std::numeric_limits<size_t>::max())
+    {
+      if ((Base::_activeID != ID) && (Base::_activeID != std::numeric_limits<size_t>::max()))
+	insertInEventQ(Base::_activeID + 1);
+      Base::_activeID = ID;
+
+      if (ID == std::numeric_limits<size_t>::max())
+	orderNextEvent();
+    }
+
+    inline double key(const size_t p) const { return Base::_Min[p].top()._dt; }
+
+    inline void link(size_t& head, const size_t p)
+    {
+      Base::_Min[p].previous = std::numeric_limits<size_t>::max();
+      Base::_Min[p].next = head;
+      if (head != std::numeric_limits<size_t>::max())
+	Base::_Min[head].previous = p;
+      head = p;
+    }
+
+    inline void unlink(size_t& head, const size_t p)
+    {
+      const size_t prev = Base::_Min[p].previous,
+	next = Base::_Min[p].next;
+      if (prev == std::numeric_limits<size_t>::max())
+	head = next;
+      else
+	Base::_Min[prev].next = next;
+
+      if (next != std::numeric_limits<size_t>::max())
+	Base::_Min[next].previous = prev;
+    }
+
+    //! \brief The bucket of a rung which a time falls in.
+    inline size_t bucketIndex(const Rung& rung, const double t) const
+    {
+      const double box = (t - rung.start) / rung.width;
+      const size_t last = rung.buckets.size() - 1;
+      //Clamp to account for round off at the edges of the rung
+      const size_t b = (box < last) ? static_cast<size_t>(std::max(box, 0.0)) : last;
+      return std::max(b, rung.current);
+    }
+
+    ///////////////////////////LADDER QUEUE IMPLEMENTATION
+    inline void insertInEventQ(const size_t p)
+    {
+      if (Base::_Min[p].rung != std::numeric_limits<size_t>::max())
+	deleteFromEventQ(p);
+
+      //Don't bother adding PELs with no events which will happen
+      if (Base::_Min[p].empty() || (key(p) == std::numeric_limits<float>::infinity()))
+	return;
+
+      const double t = key(p);
+      if (t >= _topStart)
+	{
+	  link(_top, p);
+	  Base::_Min[p].rung = InTop;
+	  return;
+	}
+
+      for (size_t r(0); r < _nRungs; ++r)
+	if (t >= _rungs[r].currentStart())
+	  {
+	    const size_t b = bucketIndex(_rungs[r], t);
+	    link(_rungs[r].buckets[b], p);
+	    Base::_Min[p].rung = r;
+	    Base::_Min[p].bucket = b;
+	    return;
+	  }
+
+      //Negative time events and events in the current bucket go
+      //straight to the bottom
+      Base::Insert(p);
+      Base::_Min[p].rung = InBottom;
+    }
+
+    inline void deleteFromEventQ(const size_t p)
+    {
+      const size_t rung = Base::_Min[p].rung;
+      if (rung == InBottom)
+	Base::Delete(p);
+      else if (rung == InTop)
+	unlink(_top, p);
+      else
+	unlink(_rungs[rung].buckets[Base::_Min[p].bucket], p);
+
+      Base::_Min[p].rung = std::numeric_limits<size_t>::max();
+    }
+
+    /*! \brief Spread a linked list of PELs with keys in [start,
+        start+width*count) over a new rung.
+     */
+    inline void spawnRung(size_t head, const size_t count, const double start, const double width)
+    {
+      if (_rungs.size() == _nRungs)
+	_rungs.push_back(Rung());
+      Rung& rung = _rungs[_nRungs];
+      rung.start = start;
+      rung.width = width;
+      rung.current = 0;
+      rung.buckets.assign(count, std::numeric_limits<size_t>::max());
+
+      while (head != std::numeric_limits<size_t>::max())
+	{
+	  const size_t next = Base::_Min[head].next;
+	  const size_t b = bucketIndex(rung, key(head));
+	  link(rung.buckets[b], head);
+	  Base::_Min[head].rung = _nRungs;
+	  Base::_Min[head].bucket = b;
+	  head = next;
+	}
+      ++_nRungs;
+    }
+
+    inline void moveToBottom(size_t head)
+    {
+      while (head != std::numeric_limits<size_t>::max())
+	{
+	  const size_t next = Base::_Min[head].next;
+	  Base::Insert(head);
+	  Base::_Min[head].rung = InBottom;
+	  head = next;
+	}
+    }
+
+    /*! \brief Spread the top over the first rung.
+
+      As the rest of the queue is empty, every PEL with a pending
+      event is in the top. These are brought up to the current time
+      here, which keeps the peculiar time (and the keys) small.
+     */
+    inline void transferTop()
+    {
+      double minKey(std::numeric_limits<double>::infinity()),
+	maxKey(-std::numeric_limits<double>::infinity());
+      size_t count(0);
+      for (size_t e = _top; e != std::numeric_limits<size_t>::max(); e = Base::_Min[e].next)
+	{
+	  Base::_Min[e].stream(Base::_pecTime);
+	  minKey = std::min(minKey, key(e));
+	  maxKey = std::max(maxKey, key(e));
+	  ++count;
+	}
+      Base::_pecTime = 0;
+      _topStart = maxKey;
+
+      const size_t head = _top;
+      _top = std::numeric_limits<size_t>::max();
+
+      const double width = (maxKey - minKey) / count;
+      if ((count <= Threshold) || !(minKey + width > minKey))
+	moveToBottom(head);
+      else
+	//The extra bucket holds the PELs with the maximum key
+	spawnRung(head, count + 1, minKey, width);
+    }
+
+    inline void orderNextEvent()
+    {
+      while (Base::_NP == 0)
+	{
+	  if (!_nRungs)
+	    {
+	      if (_top == std::numeric_limits<size_t>::max())
+		{
+		  //The queue is empty, so anything can go in the top
+		  _topStart = -std::numeric_limits<double>::infinity();
+		  return;
+		}
+	      transferTop();
+	      continue;
+	    }
+
+	  Rung& rung = _rungs[_nRungs - 1];
+	  while ((rung.current < rung.buckets.size()) && (rung.buckets[rung.current] == std::numeric_limits<size_t>::max()))
+	    ++rung.current;
+
+	  if (rung.current == rung.buckets.size())
+	    {
+	      --_nRungs;
+	      continue;
+	    }
+
+	  const size_t bucket = rung.current++;
+	  const size_t head = rung.buckets[bucket];
+	  rung.buckets[bucket] = std::numeric_limits<size_t>::max();
+	  const double start = rung.start + rung.width * bucket;
+
+	  size_t count(0);
+	  for (size_t e = head; e != std::numeric_limits<size_t>::max(); e = Base::_Min[e].next)
+	    ++count;
+
+	  const double width = rung.width / count;
+	  if ((count > Threshold) && (_nRungs < MaxRungs) && (start + width > start))
+	    spawnRung(head, count, start, width);
+	  else
+	    moveToBottom(head);
+	}
+    }
+
+    virtual void outputXML(magnet::xml::XmlStream& XML) const
+    { XML << magnet::xml::attr("Type") << (std::string("Ladder") + PEL::name()); }
+  };
+}
@@ -0,0 +1,298 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <dynamo/eventtypes.hpp>
+#include <dynamo/schedulers/sorters/FEL.hpp>
+#include <magnet/exception.hpp>
+#include <magnet/xmlwriter.hpp>
+#include <dynamo/checkpoint.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <cmath>
+
+namespace dynamo {
+  /*! \brief A Future Event List which sorts the Particle Event Lists
+      in a 4-ary implicit heap.
+
+    Each node of the heap holds the time of the next event of a PEL
+    alongside the PEL's index, so sifting only reads the dense node
+    array and never the PELs themselves. The nodes are 16 bytes and
+    the array is offset so that the four children of a node always
+    share one 64 byte cache line. The heap is half the depth of a
+    binary heap, and each level of a sift down touches a single cache
+    line.
+
+    The PELs, their streaming and the lazy deletion of the events of
+    invalidated particles (using _eventCount) are handled exactly as
+    in the CBTFEL.
+   */
+  template<class PEL>
+  class QuadHeapFEL: public FEL
+  {
+    struct Node
+    {
+      double key;
+      size_t ID;
+    };
+
+  public:
+    QuadHeapFEL() { clear(); }
+
+    virtual void init(const size_t N)
+    {
+      clear();
+      _streamFreq = N;
+      _Min.resize(N);
+      _pos.resize(N, std::numeric_limits<size_t>::max());
+      _eventCount.resize(N, 0);
+      //Allocate enough slack to offset the heap so that the children
+      //of each node (which start at indices 4i+1) are cache aligned.
+      _storage.resize(N + 64 / sizeof(Node));
+      const size_t misalignment = reinterpret_cast<std::uintptr_t>(_storage.data() + 1) % 64;
+      _heap = _storage.data() + (misalignment ? (64 - misalignment) / sizeof(Node) : 0);
+    }
+
+    virtual void clear()
+    {
+      _Min.clear();
+      _pos.clear();
+      _eventCount.clear();
+      _storage.clear();
+      _heap = nullptr;
+      _size = 0;
+      _pecTime = 0.0;
+      _streamFreq = 0;
+      _nUpdate = 0;
+      _activeID = std::numeric_limits<size_t>::max();
+    }
+
+    virtual void stream(const double dt)
+    {
+      _pecTime += dt;
+      ++_nUpdate;
+
+      if (!(_nUpdate % _streamFreq))
+	{
+	  for (auto& pDat : _Min)
+	    pDat.stream(_pecTime);
+	  for (size_t i(0); i < _size; ++i)
+	    _heap[i].key -= _pecTime;
+	  _pecTime = 0.0;
+	}
+    }
+
+    virtual void invalidate(const size_t ID)
+    {
+      flushChanges(ID);
+      _Min[ID].clear();
+      ++_eventCount[ID];
+    }
+
+    virtual void pop()
+    {
+      flushChanges(_heap[0].ID);
+      _Min[_heap[0].ID].pop();
+    }
+
+    virtual bool empty()
+    {
+      flushChanges();
+
+      //Lazily delete any invalid events at the top of the queue
+      while (_size)
+	{
+	  const Event next_event = _Min[_heap[0].ID].top();
+	  if ((next_event._source != INTERACTION) || (next_event._particle2eventcounter == _eventCount[next_event._particle2ID]))
+	    return false;
+	  pop();
+	  flushChanges();
+	}
+
+      return true;
+    }
+
+    virtual Event top()
+    {
+      //empty() causes a flush and lazy deletion
+      if (empty()) M_throw() << "Event queue is empty!";
+      Event next_event = _Min[_heap[0].ID].top();
+      next_event._dt -= _pecTime;
+      return next_event;
+    }
+
+    virtual void push(Event event)
+    {
+#ifdef DYNAMO_DEBUG
+      if (std::isnan(event._dt))
+	M_throw() << "NaN value pushed into the sorter.";
+#endif
+      //Only push events which will actually happen
+      if (event._dt != std::numeric_limits<float>::infinity()) {
+	flushChanges(event._particle1ID);
+	event._dt += _pecTime;
+	if (event._source == INTERACTION)
+	  event._particle2eventcounter = _eventCount[event._particle2ID];
+	_Min[event._particle1ID].push(event);
+      }
+    }
+
+    virtual void rescaleTimes(const double factor)
+    {
+      for (auto& pDat : _Min)
+	pDat.rescaleTimes(factor);
+      for (size_t i(0); i < _size; ++i)
+	_heap[i].key *= factor;
+      _pecTime *= factor;
+    }
+
+    virtual void saveCheckpoint(std::ostream& os) const
+    {
+      if (_activeID != std::numeric_limits<size_t>::max())
+	M_throw() << "Cannot checkpoint an unsorted FEL";
+
+      checkpoint::write(os, uint64_t(_Min.size()));
+      for (const auto& pDat : _Min)
+	pDat.saveCheckpoint(os);
+      checkpoint::write(os, std::vector<Node>(_heap, _heap + _size));
+      checkpoint::write(os, _pos);
+      checkpoint::write(os, _eventCount);
+      checkpoint::write(os, _streamFreq);
+      checkpoint::write(os, _nUpdate);
+      checkpoint::write(os, _pecTime);
+    }
+
+    virtual void loadCheckpoint(std::istream& is)
+    {
+      uint64_t size;
+      checkpoint::read(is, size);
+      if (size != _Min.size())
+	M_throw() << "The checkpointed FEL has a different particle count (" << size << " != " << _Min.size() << ")";
+      for (auto& pDat : _Min)
+	pDat.loadCheckpoint(is);
+      std::vector<Node> nodes;
+      checkpoint::read(is, nodes);
+      std::copy(nodes.begin(), nodes.end(), _heap);
+      _size = nodes.size();
+      checkpoint::read(is, _pos);
+      checkpoint::read(is, _eventCount);
+      checkpoint::read(is, _streamFreq);
+      checkpoint::read(is, _nUpdate);
+      checkpoint::read(is, _pecTime);
+      _activeID = std::numeric_limits<size_t>::max();
+    }
+
+  private:
+    //! The PEL of each particle.
+    std::vector<PEL> _Min;
+    //! The position of each PEL in the heap (or max() if it is not in the heap).
+    std::vector<size_t> _pos;
+    std::vector<size_t> _eventCount;
+    //! The memory of the heap, _heap points to an aligned location in here.
+    std::vector<Node> _storage;
+    Node* _heap;
+    size_t _size, _streamFreq, _nUpdate;
+    double _pecTime;
+    size_t _activeID;
+
+    void flushChanges(const size_t ID = std::numeric_limits<size_t>::max())
+    {
+      if ((_activeID != ID) && (_activeID != std::numeric_limits<size_t>::max()))
+	{
+	  const PEL& pel = _Min[_activeID];
+	  if (pel.empty() || (pel.top()._dt == std::numeric_limits<float>::infinity()))
+	    {
+	      if (_pos[_activeID] != std::numeric_limits<size_t>::max())
+		remove(_activeID);
+	    }
+	  else
+	    update(_activeID, pel.top()._dt);
+	}
+      _activeID = ID;
+    }
+
+    ///////////////////////////4-ARY HEAP IMPLEMENTATION
+    //! \brief Insert a PEL, or move it to the position for its new key.
+    inline void update(const size_t ID, const double key)
+    {
+      const Node node = {key, ID};
+      const size_t i = _pos[ID];
+
+      if (i == std::numeric_limits<size_t>::max())
+	siftUp(_size++, node);
+      else if (key < _heap[i].key)
+	siftUp(i, node);
+      else
+	siftDown(i, node);
+    }
+
+    inline void remove(const size_t ID)
+    {
+      const size_t i = _pos[ID];
+      _pos[ID] = std::numeric_limits<size_t>::max();
+      const Node last = _heap[--_size];
+      if (i == _size) return;
+
+      if (last.key < _heap[i].key)
+	siftUp(i, last);
+      else
+	siftDown(i, last);
+    }
+
+    //! \brief Place a node at or above the hole at i.
+    inline void siftUp(size_t i, const Node& node)
+    {
+      while (i)
+	{
+	  const size_t parent = (i - 1) / 4;
+	  if (!(node.key < _heap[parent].key)) break;
+	  _heap[i] = _heap[parent];
+	  _pos[_heap[i].ID] = i;
+	  i = parent;
+	}
+      _heap[i] = node;
+      _pos[node.ID] = i;
+    }
+
+    //! \brief Place a node at or below the hole at i.
+    inline void siftDown(size_t i, const Node& node)
+    {
+      for (;;)
+	{
+	  const size_t first = 4 * i + 1;
+	  if (first >= _size) break;
+	  const size_t last = std::min(first + 4, _size);
+	  size_t child = first;
+	  for (size_t c = first + 1; c < last; ++c)
+	    if (_heap[c].key < _heap[child].key)
+	      child = c;
+
+	  if (!(_heap[child].key < node.key)) break;
+	  _heap[i] = _heap[child];
+	  _pos[_heap[i].ID] = i;
+	  i = child;
+	}
+      _heap[i] = node;
+      _pos[node.ID] = i;
+    }
+
+    virtual void outputXML(magnet::xml::XmlStream& XML) const
+    { XML << magnet::xml::attr("Type") << (std::string("QuadHeap") + PEL::name()); }
+  };
+}
@@ -38,6 +38,8 @@ namespace dynamo {
   void
   SSystemOnly::initialise()
   {
+    if (restoreCheckpoint()) return;
+
     dout << "Reinitialising on collision " << Sim->eventCount << std::endl;
 
     if (Sim->systems.empty())
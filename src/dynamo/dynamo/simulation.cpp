@@ -31,7 +31,13 @@
 #include <dynamo/globals/PBCSentinel.hpp>
 #include <boost/filesystem.hpp>
 #include <dynamo/BC/BC.hpp>
+#include <dynamo/checkpoint.hpp>
+#include <algorithm>
 #include <iomanip>
+#include <limits>
+#include <fstream>
+#include <iterator>
+#include <sstream>
 #include <set>
 
 //! The configuration file version, a version mismatch prevents an XML file load.
@@ -48,13 +54,231 @@ namespace dynamo
     nextPrintEvent(0),
     _force_unwrapped(false),
     primaryCellSize({1,1,1}),
-    ranGenerator(std::random_device()()),
     lastRunMFT(0.0),
     simID(0),
     stateID(0),
     replexExchangeNumber(0),
     status(START)
-  {}
+  {
+    setRandomSeed(std::random_device()());
+  }
+
+  namespace {
+    const std::string checkpointMagic = "DynamOCheckpoint1";
+
+    template<class Container>
+    void writeBlocks(std::ostream& os, const Container& objs)
+    {
+      checkpoint::write(os, uint64_t(objs.size()));
+      for (const auto& ptr : objs)
+	checkpoint::writeBlock(os, ptr->getName(), *ptr);
+    }
+
+    /*! \brief Load named checkpoint blocks into the matching objects.
+
+      \param strict If true, the checkpoint must have a block for
+      every object (and no others).
+     */
+    template<class Container>
+    void readBlocks(std::istream& is, Container& objs, const char* type, bool strict, std::ostream& warn)
+    {
+      uint64_t count;
+      checkpoint::read(is, count);
+      if (strict && (count != objs.size()))
+	M_throw() << "The checkpoint has " << count << " " << type << "s but the configuration has " 
+		  << objs.size() << ", was the checkpoint written with this configuration?";
+
+      for (size_t i(0); i < count; ++i)
+	{
+	  std::string data;
+	  const std::string name = checkpoint::readBlock(is, data);
+	  auto it = std::find_if(objs.begin(), objs.end(), [&](const typename Container::value_type& ptr) { return ptr->getName() == name; });
+	  if (it == objs.end())
+	    {
+	      if (strict)
+		M_throw() << "The checkpoint has state for the " << type << " \"" << name << "\" which is not in the configuration";
+	      warn << "The checkpoint has state for the " << type << " \"" << name << "\" which is not in the configuration, skipping it" << std::endl;
+	      continue;
+	    }
+	  std::istringstream block(data);
+	  (*it)->loadCheckpoint(block);
+	}
+    }
+  }
+
+  void
+  Simulation::writeCheckpoint(std::string filename, bool withFEL)
+  {
+    if (status != INITIALISED)
+      M_throw() << "Cannot checkpoint an uninitialised simulation";
+
+    std::ofstream os(filename, std::ios::binary);
+    if (!os)
+      M_throw() << "Could not open \"" << filename << "\" to write the checkpoint";
+
+    checkpoint::write(os, checkpointMagic);
+    checkpoint::write(os, uint64_t(N()));
+    for (const Particle& part : particles)
+      {
+	checkpoint::write(os, part.getPosition());
+	checkpoint::write(os, part.getVelocity());
+	checkpoint::write(os, part.getPecTime());
+	checkpoint::write(os, uint8_t(part.testState(Particle::DYNAMIC) | (part.testState(Particle::ALIVE) << 1) | (part.testState(Particle::SLEEPING) << 2)));
+      }
+
+    checkpoint::write(os, systemTime);
+    checkpoint::write(os, uint64_t(eventCount));
+    checkpoint::write(os, _ranSeed);
+    std::ostringstream rngState;
+    rngState << ranGenerator;
+    checkpoint::write(os, rngState.str());
+
+    checkpoint::writeBlock(os, "Dynamics", *dynamics);
+    checkpoint::writeBlock(os, "BC", *BCs);
+    writeBlocks(os, interactions);
+    writeBlocks(os, locals);
+    writeBlocks(os, globals);
+    writeBlocks(os, systems);
+
+    std::ostringstream schedulerState;
+    ptrScheduler->saveCheckpoint(schedulerState, withFEL);
+    checkpoint::write(os, schedulerState.str());
+
+    if (!os)
+      M_throw() << "Failed to write the checkpoint \"" << filename << "\"";
+  }
+
+  void
+  Simulation::loadCheckpoint(std::string filename)
+  {
+    if (status != START)
+      M_throw() << "Checkpoints must be loaded before the simulation is initialised";
+
+    std::ifstream is(filename, std::ios::binary);
+    if (!is)
+      M_throw() << "Could not open the checkpoint \"" << filename << "\"";
+    _checkpoint.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+
+    if (_checkpoint.empty())
+      M_throw() << "\"" << filename << "\" is not a DynamO checkpoint";
+  }
+
+  void
+  Simulation::shareImmutableData(const Simulation& other)
+  {
+    if (status != START)
+      M_throw() << "Immutable data must be shared before the simulation is initialised";
+
+    if (other.status != INITIALISED)
+      M_throw() << "Immutable data can only be shared from an initialised simulation";
+
+    //The ranges are only valid for simulations of the same size
+    if (N() != other.N())
+      return;
+
+    if (species.size() == other.species.size())
+      for (size_t i(0); i < species.size(); ++i)
+	if ((typeid(*species[i]) == typeid(*other.species[i]))
+	    && (species[i]->getName() == other.species[i]->getName()))
+	  species[i]->shareImmutableData(*other.species[i]);
+
+    if (topology.size() == other.topology.size())
+      for (size_t i(0); i < topology.size(); ++i)
+	if (typeid(*topology[i]) == typeid(*other.topology[i]))
+	  topology[i]->shareImmutableData(*other.topology[i]);
+
+    if (interactions.size() == other.interactions.size())
+      for (size_t i(0); i < interactions.size(); ++i)
+	if ((typeid(*interactions[i]) == typeid(*other.interactions[i]))
+	    && (interactions[i]->getName() == other.interactions[i]->getName()))
+	  interactions[i]->shareImmutableData(*other.interactions[i]);
+
+    if (locals.size() == other.locals.size())
+      for (size_t i(0); i < locals.size(); ++i)
+	if ((typeid(*locals[i]) == typeid(*other.locals[i]))
+	    && (locals[i]->getName() == other.locals[i]->getName()))
+	  locals[i]->shareImmutableData(*other.locals[i]);
+  }
+
+  void
+  Simulation::restoreCheckpoint()
+  {
+    dout << "Restoring the simulation state from the checkpoint" << std::endl;
+    std::istringstream is(_checkpoint);
+    _checkpoint.clear();
+
+    std::string magic;
+    checkpoint::read(is, magic);
+    if (magic != checkpointMagic)
+      M_throw() << "Not a DynamO checkpoint (or an incompatible version)";
+
+    uint64_t count;
+    checkpoint::read(is, count);
+    if (count != N())
+      M_throw() << "The checkpoint has " << count << " particles but the configuration has " << N();
+
+    for (Particle& part : particles)
+      {
+	uint8_t state;
+	checkpoint::read(is, part.getPosition());
+	checkpoint::read(is, part.getVelocity());
+	checkpoint::read(is, part.getPecTime());
+	checkpoint::read(is, state);
+	part.clearState(Particle::DEFAULT);
+	part.clearState(Particle::SLEEPING);
+	if (state & 0x1) part.setState(Particle::DYNAMIC);
+	if (state & 0x2) part.setState(Particle::ALIVE);
+	if (state & 0x4) part.setState(Particle::SLEEPING);
+      }
+
+    checkpoint::read(is, systemTime);
+    checkpoint::read(is, count);
+    eventCount = count;
+    //The event limit counts from the restart
+    if (endEventCount)
+      endEventCount = (endEventCount > std::numeric_limits<size_t>::max() - eventCount) 
+	? std::numeric_limits<size_t>::max() : endEventCount + eventCount;
+    checkpoint::read(is, _ranSeed);
+    std::string rngState;
+    checkpoint::read(is, rngState);
+    std::istringstream(rngState) >> ranGenerator;
+
+    std::string data;
+    if (checkpoint::readBlock(is, data) != "Dynamics")
+      M_throw() << "Corrupt checkpoint, expected the Dynamics state";
+    {
+      std::istringstream block(data);
+      dynamics->loadCheckpoint(block);
+    }
+
+    if (checkpoint::readBlock(is, data) != "BC")
+      M_throw() << "Corrupt checkpoint, expected the BC state";
+    {
+      std::istringstream block(data);
+      BCs->loadCheckpoint(block);
+    }
+
+    readBlocks(is, interactions, "Interaction", true, derr);
+    readBlocks(is, locals, "Local", true, derr);
+    readBlocks(is, globals, "Global", true, derr);
+    //Systems are added/removed by the command line options, so they
+    //are matched by name
+    readBlocks(is, systems, "System", false, derr);
+
+    if (ptrScheduler == NULL)
+      M_throw() << "The scheduler has not been set!";
+    std::string schedulerState;
+    checkpoint::read(is, schedulerState);
+    std::istringstream schedulerStream(schedulerState);
+    ptrScheduler->loadCheckpoint(schedulerStream);
+  }
+
+  void
+  Simulation::setRandomSeed(unsigned int seed)
+  {
+    ranGenerator.seed(seed);
+    _ranSeed = seed;
+  }
 
   namespace {
     /*! \brief Hidden functor used for sorting containers of
@@ -131,6 +355,9 @@ namespace dynamo
 
     status = SPECIES_INIT;
 
+    for (shared_ptr<Topology>& ptr : topology)
+      ptr->initialise();
+
     dout << "Validating self-Interaction definitions" << std::endl;
     //Check that each particle has a representative interaction
     for (const Particle& particle : particles) {
@@ -223,6 +450,9 @@ namespace dynamo
 
     status = ENSEMBLE_INIT;
 
+    if (!_checkpoint.empty())
+      restoreCheckpoint();
+
     if (ptrScheduler == NULL)
       M_throw() << "The scheduler has not been set!";      
 
@@ -23,7 +23,9 @@
 #include <dynamo/property.hpp>
 #include <dynamo/units/units.hpp>
 #include <magnet/function/delegate.hpp>
+#include <magnet/math/philox.hpp>
 #include <random>
+#include <string>
 #include <vector>
 
 namespace dynamo
@@ -64,6 +66,12 @@ namespace dynamo
     } ESimulationStatus;
   
   typedef std::mt19937 baseRNG;
+
+  /*! \brief The counter-based random number generator type.
+    
+    \sa Simulation::getParticleRNG Simulation::getSystemRNG
+   */
+  typedef magnet::math::Philox4x32 counterRNG;
   
   /*! \brief Fundamental collection of the Simulation data.
    
@@ -278,6 +286,60 @@ namespace dynamo
     */
     void writeXMLfile(std::string filename, bool applyBC = true, bool round = false);
 
+    /*! \brief Writes an exact-state binary checkpoint of the Simulation.
+
+      The XML configuration files are written at a rounded precision
+      and are taken after all particles are streamed to the current
+      time, so a run restarted from them diverges from the original
+      run. The checkpoint instead stores the state of the simulation
+      exactly (including the particle peculiar times, capture maps,
+      random number generators and System timers), so that a restart
+      replays the original run bit for bit.
+
+      The checkpoint only complements the XML configuration file, and
+      a restart must load the configuration file written alongside the
+      checkpoint (see loadCheckpoint()). This must be called before
+      the configuration file is written out, as writing the XML file
+      updates all particles.
+
+      \param filename The path of the checkpoint to write.
+      \param withFEL If true, the sorted event list is also stored,
+      removing the need to repredict all events on restart.
+    */
+    void writeCheckpoint(std::string filename, bool withFEL = true);
+
+    /*! \brief Loads a checkpoint written by writeCheckpoint().
+
+      This must be called after the configuration has been loaded and
+      before initialise(). The checkpointed state is applied during
+      initialise(), which then skips the validation of the
+      configuration (and the prediction of all events if the FEL is
+      available). The event count is restored from the checkpoint, so
+      the endEventCount is taken as the number of events to run after
+      the restart.
+     */
+    void loadCheckpoint(std::string filename);
+
+    /*! \brief Share the immutable configuration data of another
+        Simulation with this Simulation.
+
+      When running many replicas of the same system (e.g., in the
+      EReplicaExchangeSimulation engine), the configuration data that
+      is never modified once the simulation is initialised (the
+      species and topology ranges, the interaction parameter tables,
+      Potential step tables and triangle meshes) is identical for
+      every replica. This replaces the data of this Simulation with
+      the data of the passed Simulation wherever they are identical,
+      so that it is only held in memory once. The particle state,
+      capture maps, sorters and output plugins remain per-replica.
+
+      This must be called after the configuration has been loaded and
+      before initialise(), and \p other must already be initialised
+      (and must outlive this Simulation). Objects which differ between
+      the simulations are not shared.
+     */
+    void shareImmutableData(const Simulation& other);
+
     /*! \brief The Ensemble of the Simulation. */
     shared_ptr<Ensemble> ensemble;
 
@@ -365,6 +427,40 @@ namespace dynamo
 
     /*! \brief The random number generator of the system. */
     mutable baseRNG ranGenerator;
+
+    /*! \brief Seeds all of the random number generators of the
+        Simulation.
+     */
+    void setRandomSeed(unsigned int seed);
+
+    /*! \brief Returns a counter-based random stream for a particle.
+
+      The stream is keyed on the seed of the Simulation, the ID of
+      the particle and the current Simulation::eventCount. The random
+      numbers drawn from it are therefore independent of the order
+      in which particles (or threads) draw their random numbers, and
+      of any other use of the sequential \ref ranGenerator. Each
+      stream must only be used once per event, as a second call for
+      the same particle in the same event returns the same stream.
+
+      \param ID The ID of the particle.
+     */
+    counterRNG getParticleRNG(size_t ID) const
+    { return counterRNG(_ranSeed, ID, eventCount); }
+
+    /*! \brief Returns a counter-based random stream for a System event.
+
+      Streams are seperated from the particle streams and from other
+      System events. Events which do not increment the
+      Simulation::eventCount must provide their own counter.
+
+      \param sysID The ID of the System event.
+      \param counter A counter unique to each execution of the event.
+      \param stream Allows independent streams within a single event
+      execution, e.g., for each trial of a sampling loop.
+     */
+    counterRNG getSystemRNG(size_t sysID, size_t counter, size_t stream = 0) const
+    { return counterRNG(_ranSeed | (uint64_t(sysID + 1) << 32), stream, counter); }
     
     /*! \brief The collection of OutputPlugin's operating on this system.
      */
@@ -417,6 +513,15 @@ namespace dynamo
 
   private:
     size_t _nextPrint;
+
+    //! Checkpoint data waiting to be applied in initialise().
+    std::string _checkpoint;
+
+    //! Apply the state in \ref _checkpoint.
+    void restoreCheckpoint();
+
+    /*! \brief The seed used for the counter-based random streams. */
+    uint32_t _ranSeed;
   };
 
 }
@@ -23,6 +23,13 @@
 namespace dynamo {
   Species::~Species() {}
 
+  void
+  Species::shareImmutableData(const Species& other)
+  {
+    if (magnet::xml::toXMLString(range) == magnet::xml::toXMLString(other.range))
+      range = other.range;
+  }
+
   shared_ptr<Species>
   Species::getClass(const magnet::xml::Node& XML, dynamo::Simulation* tmp, size_t nID)
   {
@@ -54,6 +54,11 @@ namespace dynamo {
     virtual double getParticleKineticEnergy(size_t ID) const = 0;
 
     virtual double getDOF() const = 0;
+
+    /*! \brief Share the IDRange of an identically configured Species
+        of another Simulation (see Simulation::shareImmutableData()).
+     */
+    void shareImmutableData(const Species& other);
     
   protected:
     template<class T1>
@@ -26,13 +26,15 @@
 #include <dynamo/dynamics/dynamics.hpp>
 #include <dynamo/schedulers/scheduler.hpp>
 #include <dynamo/outputplugins/outputplugin.hpp>
+#include <dynamo/checkpoint.hpp>
 #include <magnet/xmlwriter.hpp>
 #include <magnet/xmlreader.hpp>
 
 namespace dynamo {
   SysDSMCSpheres::SysDSMCSpheres(const magnet::xml::Node& XML, dynamo::Simulation* tmp): 
     System(tmp),
-    maxprob(0.0)
+    maxprob(0.0),
+    stepCount(0)
   {
     dt = std::numeric_limits<float>::infinity();
     operator<<(XML);
@@ -48,6 +50,7 @@ namespace dynamo {
     diameter(nd),
     maxprob(0.0),
     e(ne),
+    stepCount(0),
     range1(r1),
     range2(r2)
   {
@@ -59,28 +62,41 @@ namespace dynamo {
   SysDSMCSpheres::runEvent()
   {
     dt = tstep;
-    std::normal_distribution<> norm_sampler;
-    std::uniform_real_distribution<> uniform_sampler;
+    ++stepCount;
     std::uniform_int_distribution<size_t> id1sampler(0, range1->size() - 1);
     std::uniform_int_distribution<size_t> id2sampler(0, range2->size() - 1);
+
+    //Single block ranges are sampled directly, without a virtual
+    //call per particle
+    const IDRange::Block block1 = (range1->blockCount() == 1) ? range1->getBlock(0) : IDRange::Block();
+    const IDRange::Block block2 = (range2->blockCount() == 1) ? range2->getBlock(0) : IDRange::Block();
+    const auto id1 = [&](const size_t i) { return block1.count ? block1[i] : (*range1)[i]; };
+    const auto id2 = [&](const size_t i) { return block2.count ? block2[i] : (*range2)[i]; };
         
     //Find the likely maximum number of interacting pairs. The
     //addition of the random variable is a neat way to randomly pick
     //an extra pair to, on average, pick the correct number of
     //fractional pairs (thanks Severin!)
-    const size_t nmax = static_cast<size_t>(0.5 * maxprob * range1->size() + uniform_sampler(Sim->ranGenerator));
+    counterRNG steprng = Sim->getSystemRNG(ID, stepCount);
+    const size_t nmax = static_cast<size_t>(0.5 * maxprob * range1->size() + std::uniform_real_distribution<>()(steprng));
 
     NEventData retval;
 
     for (size_t n = 0; n < nmax; ++n)
       {
-	Particle& p1(Sim->particles[*(range1->begin() + id1sampler(Sim->ranGenerator))]);
+	//Each trial has its own random stream, so the trials are
+	//independent of the order they are sampled in.
+	counterRNG rng = Sim->getSystemRNG(ID, stepCount, n + 1);
+	std::normal_distribution<> norm_sampler;
+	std::uniform_real_distribution<> uniform_sampler;
+
+	Particle& p1(Sim->particles[id1(id1sampler(rng))]);
 	
-	size_t p2id = *(range2->begin() + id2sampler(Sim->ranGenerator));
+	size_t p2id = id2(id2sampler(rng));
 	
 	//Find another particle which is not p1
 	while (p2id == p1.getID())
-	  p2id = *(range2->begin()+id2sampler(Sim->ranGenerator));
+	  p2id = id2(id2sampler(rng));
 	
 	Particle& p2(Sim->particles[p2id]);
 	
@@ -88,12 +104,12 @@ namespace dynamo {
       
 	Vector rij;
 	for (size_t iDim(0); iDim < NDIM; ++iDim)
-	  rij[iDim] = norm_sampler(Sim->ranGenerator);
+	  rij[iDim] = norm_sampler(rng);
 	
 	//This is the extra diameter term missing from the "factor" variable
 	rij *= diameter / rij.nrm();
       
-	if (Sim->dynamics->DSMCSpheresTest(p1, p2, maxprob, factor, rij))
+	if (Sim->dynamics->DSMCSpheresTest(p1, p2, maxprob, factor, rij, uniform_sampler(rng)))
 	  {
 	    ++Sim->eventCount;
 	    retval.L2partChanges.push_back(PairEventData(Sim->dynamics->DSMCSpheresRun(p1, p2, e, rij)));
@@ -107,6 +123,7 @@ namespace dynamo {
   {
     ID = nID;
     dt = tstep;
+    stepCount = 0;
 
     //An extra factor of diameter is missing here, which is used to
     //give the vector rij below and in runEvent the "correct"
@@ -116,19 +133,22 @@ namespace dynamo {
   
     if (maxprob == 0.0)
       {
-	std::normal_distribution<> norm_sampler;
 	std::uniform_int_distribution<size_t> id1sampler(0, range1->size() - 1);
 	std::uniform_int_distribution<size_t> id2sampler(0, range2->size() - 1);
 
 	//Just do some quick testing to get an estimate
 	for (size_t n = 0; n < 1000; ++n)
 	  {
-	    Particle& p1(Sim->particles[*(range1->begin() + id1sampler(Sim->ranGenerator))]);
+	    counterRNG rng = Sim->getSystemRNG(ID, stepCount, n);
+	    std::normal_distribution<> norm_sampler;
+	    std::uniform_real_distribution<> uniform_sampler;
+
+	    Particle& p1(Sim->particles[*(range1->begin() + id1sampler(rng))]);
 	  
-	    size_t p2id = *(range2->begin() + id2sampler(Sim->ranGenerator));
+	    size_t p2id = *(range2->begin() + id2sampler(rng));
 	  
 	    while (p2id == p1.getID())
-	      p2id = *(range2->begin()+id2sampler(Sim->ranGenerator));
+	      p2id = *(range2->begin()+id2sampler(rng));
 	  
 	    Particle& p2(Sim->particles[p2id]);
 	  
@@ -136,11 +156,11 @@ namespace dynamo {
 	  
 	    Vector rij;
 	    for (size_t iDim(0); iDim < NDIM; ++iDim)
-	      rij[iDim] = norm_sampler(Sim->ranGenerator);
+	      rij[iDim] = norm_sampler(rng);
 	
 	    rij *= diameter / rij.nrm();
 	  
-	    Sim->dynamics->DSMCSpheresTest(p1, p2, maxprob, factor, rij);
+	    Sim->dynamics->DSMCSpheresTest(p1, p2, maxprob, factor, rij, uniform_sampler(rng));
 	  }
       }
 
@@ -187,4 +207,20 @@ namespace dynamo {
 	<< range2
 	<< magnet::xml::endtag("System");
   }
+
+  void
+  SysDSMCSpheres::saveCheckpoint(std::ostream& os) const
+  {
+    System::saveCheckpoint(os);
+    checkpoint::write(os, maxprob);
+    checkpoint::write(os, stepCount);
+  }
+
+  void
+  SysDSMCSpheres::loadCheckpoint(std::istream& is)
+  {
+    System::loadCheckpoint(is);
+    checkpoint::read(is, maxprob);
+    checkpoint::read(is, stepCount);
+  }
 }
@@ -32,6 +32,10 @@ namespace dynamo {
 
     virtual void initialise(size_t);
 
+    virtual void saveCheckpoint(std::ostream&) const;
+
+    virtual void loadCheckpoint(std::istream&);
+
     virtual void operator<<(const magnet::xml::Node&);
 
   protected:
@@ -44,6 +48,9 @@ namespace dynamo {
     mutable double maxprob;
     double e;
     double factor;
+    //! \brief The number of DSMC steps performed, used as the
+    //! counter of the random streams.
+    size_t stepCount;
 
     shared_ptr<IDRange> range1;
     shared_ptr<IDRange> range2;
@@ -26,6 +26,7 @@
 #include <dynamo/dynamics/dynamics.hpp>
 #include <dynamo/schedulers/scheduler.hpp>
 #include <dynamo/outputplugins/outputplugin.hpp>
+#include <dynamo/checkpoint.hpp>
 #include <magnet/xmlwriter.hpp>
 #include <magnet/xmlreader.hpp>
 
@@ -77,8 +78,9 @@ namespace dynamo {
 	eventCount = 0;
       }
 
-    dt = getGhostt();
-    const size_t step = std::uniform_int_distribution<size_t>(0, range->size() - 1)(Sim->ranGenerator);
+    counterRNG rng = Sim->getSystemRNG(ID, Sim->eventCount);
+    dt = getGhostt(rng);
+    const size_t step = std::uniform_int_distribution<size_t>(0, range->size() - 1)(rng);
     return Sim->dynamics->randomGaussianEvent(Sim->particles[*(range->begin() + step)], sqrtTemp, dimensions);
   }
 
@@ -86,12 +88,35 @@ namespace dynamo {
   SysAndersen::initialise(size_t nID)
   {
     ID = nID;
-    dt = getGhostt();
+    counterRNG rng = Sim->getSystemRNG(ID, Sim->eventCount);
+    dt = getGhostt(rng);
     sqrtTemp = sqrt(Temp);
     eventCount = 0;
     lastlNColl = 0;
   }
 
+  void
+  SysAndersen::saveCheckpoint(std::ostream& os) const
+  {
+    System::saveCheckpoint(os);
+    //The tuning state is not in the configuration file
+    checkpoint::write(os, meanFreeTime);
+    checkpoint::write(os, uint64_t(eventCount));
+    checkpoint::write(os, uint64_t(lastlNColl));
+  }
+
+  void
+  SysAndersen::loadCheckpoint(std::istream& is)
+  {
+    System::loadCheckpoint(is);
+    checkpoint::read(is, meanFreeTime);
+    uint64_t count;
+    checkpoint::read(is, count);
+    eventCount = count;
+    checkpoint::read(is, count);
+    lastlNColl = count;
+  }
+
   void 
   SysAndersen::operator<<(const magnet::xml::Node& XML)
   {
@@ -134,9 +159,9 @@ namespace dynamo {
   }
 
   double 
-  SysAndersen::getGhostt() const
+  SysAndersen::getGhostt(counterRNG& rng) const
   { 
-    return  - meanFreeTime * std::log(1.0 - std::uniform_real_distribution<>()(Sim->ranGenerator));
+    return  - meanFreeTime * std::log(1.0 - std::uniform_real_distribution<>()(rng));
   }
 
   double 
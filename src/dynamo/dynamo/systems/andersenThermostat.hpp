@@ -32,6 +32,10 @@ namespace dynamo {
 
     virtual void initialise(size_t);
 
+    virtual void saveCheckpoint(std::ostream&) const;
+
+    virtual void loadCheckpoint(std::istream&);
+
     virtual void operator<<(const magnet::xml::Node&);
 
     double getTemperature() const { return Temp; }
@@ -64,7 +68,7 @@ namespace dynamo {
     size_t lastlNColl;
     size_t setFrequency;
 
-    double getGhostt() const;
+    double getGhostt(counterRNG&) const;
   
     shared_ptr<IDRange> range;
   };
@@ -62,9 +62,10 @@ namespace dynamo {
   {
     ++Sim->eventCount;
     ++eventCount;
-    dt = getGhostt();
+    counterRNG rng = Sim->getSystemRNG(ID, Sim->eventCount);
+    dt = getGhostt(rng);
 
-    size_t step = std::uniform_int_distribution<size_t>(0, range->size() - 1)(Sim->ranGenerator);
+    size_t step = std::uniform_int_distribution<size_t>(0, range->size() - 1)(rng);
     Particle& part(Sim->particles[*(range->begin()+step)]);
 
     Sim->dynamics->updateParticle(part);
@@ -90,7 +91,8 @@ namespace dynamo {
     const double factor = sqrtTemp / std::sqrt(mass);
     //Get the new velocity
     std::normal_distribution<> norm_dist;
-    double vel = std::abs(norm_dist(Sim->ranGenerator)) * factor;
+    counterRNG partrng = Sim->getParticleRNG(part.getID());
+    double vel = std::abs(norm_dist(partrng)) * factor;
     part.getVelocity() = avgV * vel;
 
     return eventdata;
@@ -100,7 +102,8 @@ namespace dynamo {
   SysFrancesco::initialise(size_t nID)
   {
     ID = nID;
-    dt = getGhostt();
+    counterRNG rng = Sim->getSystemRNG(ID, Sim->eventCount);
+    dt = getGhostt(rng);
     sqrtTemp = sqrt(Temp);
     eventCount = 0;
     lastlNColl = 0;
@@ -143,9 +146,9 @@ namespace dynamo {
   }
 
   double 
-  SysFrancesco::getGhostt() const
+  SysFrancesco::getGhostt(counterRNG& rng) const
   { 
-    return  - meanFreeTime * std::log(1.0 - std::uniform_real_distribution<>()(Sim->ranGenerator));
+    return  - meanFreeTime * std::log(1.0 - std::uniform_real_distribution<>()(rng));
   }
 
   double 
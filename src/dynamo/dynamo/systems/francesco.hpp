@@ -48,7 +48,7 @@ namespace dynamo {
     size_t eventCount;
     size_t lastlNColl;
 
-    double getGhostt() const;
+    double getGhostt(counterRNG&) const;
   
     shared_ptr<IDRange> range;
   };
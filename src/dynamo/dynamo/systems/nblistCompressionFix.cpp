@@ -73,7 +73,9 @@ namespace dynamo {
 	 << "\nNColl = " << Sim->eventCount
 	 << "\nSys t = " << Sim->systemTime / Sim->units.unitTime() << std::endl;
   
-    nblist.setMaxInteractionRange(nblist.getMaxSupportedInteractionLength() * 1.1);
+    //Only the particles are rebinned, the events already in the FEL
+    //remain valid as the system has not changed
+    nblist.growMaxInteractionRange(nblist.getMaxSupportedInteractionLength() * 1.1);
   
     dt = (nblist.getMaxSupportedInteractionLength()
 	  / initialSupportedRange - 1.0) / growthRate - Sim->systemTime;
@@ -54,8 +54,9 @@ namespace dynamo {
   {
     NEventData SDat;
     for (const shared_ptr<Species>& species : Sim->species)
-      for (const unsigned long& partID : *species->getRange())
-      SDat.L1partChanges.push_back(ParticleEventData(Sim->particles[partID], *species, RECALCULATE));
+      species->getRange()->forEach([&](const size_t partID) {
+	  SDat.L1partChanges.push_back(ParticleEventData(Sim->particles[partID], *species, RECALCULATE));
+	});
     Sim->dynamics->updateAllParticles();
     
     shared_ptr<DynGravity> dynamics = std::dynamic_pointer_cast<DynGravity>(Sim->dynamics);
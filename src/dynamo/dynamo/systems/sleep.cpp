@@ -26,7 +26,9 @@
 #include <dynamo/ranges/include.hpp>
 #include <dynamo/dynamics/gravity.hpp>
 #include <dynamo/schedulers/scheduler.hpp>
+#include <dynamo/interactions/interaction.hpp>
 #include <dynamo/outputplugins/outputplugin.hpp>
+#include <dynamo/checkpoint.hpp>
 #include <magnet/xmlwriter.hpp>
 #include <magnet/xmlreader.hpp>
 
@@ -42,8 +44,11 @@ namespace dynamo {
   SSleep::SSleep(dynamo::Simulation* nSim, std::string nName, IDRange* r1, double sleepV):
     System(nSim),
     _range(r1),
+    _sleepDistance(Sim->units.unitLength() * 0.01),
+    _sleepTime(Sim->units.unitTime() * 0.0001),
     _sleepVelocity(sleepV)
   {
+    dt = std::numeric_limits<float>::infinity();
     sysName = nName;
     type = SLEEP;
   }
@@ -65,6 +70,51 @@ namespace dynamo {
       }
   }
 
+  void
+  SSleep::saveCheckpoint(std::ostream& os) const
+  {
+    System::saveCheckpoint(os);
+    //The last collisions decide when the particles fall asleep, and
+    //a pending state change has not been run yet
+    checkpoint::write(os, uint64_t(_lastData.size()));
+    for (const auto& data : _lastData)
+      {
+	checkpoint::write(os, data.first);
+	checkpoint::write(os, data.second);
+      }
+
+    checkpoint::write(os, uint64_t(stateChange.size()));
+    for (const auto& change : stateChange)
+      {
+	checkpoint::write(os, uint64_t(change.first));
+	checkpoint::write(os, change.second);
+      }
+  }
+
+  void
+  SSleep::loadCheckpoint(std::istream& is)
+  {
+    System::loadCheckpoint(is);
+    uint64_t count;
+    checkpoint::read(is, count);
+    _lastData.resize(count);
+    for (auto& data : _lastData)
+      {
+	checkpoint::read(is, data.first);
+	checkpoint::read(is, data.second);
+      }
+
+    stateChange.clear();
+    checkpoint::read(is, count);
+    for (uint64_t i(0); i < count; ++i)
+      {
+	uint64_t pid;
+	checkpoint::read(is, pid);
+	checkpoint::read(is, stateChange[pid]);
+      }
+    recalculateTime();
+  }
+
   void
   SSleep::operator<<(const magnet::xml::Node& XML)
   {
@@ -215,9 +265,48 @@ namespace dynamo {
       }
   }
 
+  void
+  SSleep::wakeIslands()
+  {
+    std::vector<size_t> stack;
+    for (const auto& p : stateChange)
+      if (((p.second[0] != 0) || (p.second[1] != 0) || (p.second[2] != 0))
+	  && Sim->particles[p.first].testState(Particle::SLEEPING))
+	stack.push_back(p.first);
+
+    const Vector g(static_cast<const DynGravity&>(*Sim->dynamics).getGravityVector());
+
+    while (!stack.empty())
+      {
+	const Particle& part = Sim->particles[stack.back()];
+	stack.pop_back();
+
+	std::unique_ptr<IDRange> ids(Sim->ptrScheduler->getParticleNeighbours(part));
+	for (const size_t id2 : *ids)
+	  {
+	    const Particle& other = Sim->particles[id2];
+	    //Particles with a state change already have been decided
+	    if (!other.testState(Particle::SLEEPING) || !_range->isInRange(other) || stateChange.count(id2))
+	      continue;
+
+	    //Only the particles resting on a woken particle lose their
+	    //support, the particles below it are left asleep
+	    Vector rij = part.getPosition() - other.getPosition();
+	    Sim->BCs->applyBC(rij);
+	    if (((rij | g) > 0) && (rij.nrm() < Sim->getInteraction(part, other)->maxIntDist() + _sleepDistance))
+	      {
+		stateChange[id2] = Vector{1,1,1};
+		stack.push_back(id2);
+	      }
+	  }
+      }
+  }
+
   NEventData
   SSleep::runEvent()
   {
+    wakeIslands();
+
     NEventData SDat;
     typedef std::map<size_t, Vector>::value_type locPair;
     for (const locPair& p : stateChange)
@@ -256,11 +345,13 @@ namespace dynamo {
 	    part.clearState(Particle::DYNAMIC);
 	  case RESLEEP:
 	    part.getVelocity() = Vector{0,0,0};
+	    part.setState(Particle::SLEEPING);
 	    break;
 	  case CORRECT:
 	    part.getVelocity() += stateChange[part.getID()];
 	  case WAKEUP:
 	    part.setState(Particle::DYNAMIC);
+	    part.clearState(Particle::SLEEPING);
 	    break;
 	  default:
 	    M_throw() << "Bad event type!";
@@ -272,6 +363,7 @@ namespace dynamo {
     //Must clear the state before calling the signal, otherwise this
     //will erroneously schedule itself again
     stateChange.clear(); 
+    recalculateTime();
     Sim->_sigParticleUpdate(SDat);
     return SDat;
   }
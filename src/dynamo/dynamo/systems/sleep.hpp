@@ -35,6 +35,10 @@ namespace dynamo {
 
     virtual void initialise(size_t);
 
+    virtual void saveCheckpoint(std::ostream&) const;
+
+    virtual void loadCheckpoint(std::istream&);
+
     virtual void operator<<(const magnet::xml::Node&);
 
   protected:
@@ -46,6 +50,15 @@ namespace dynamo {
 
     bool sleepCondition(const Particle& part, const Vector& g, const Vector& vel = Vector{0,0,0});
 
+    /*! \brief Extends the wake ups in stateChange to the islands of
+        sleeping particles in contact with the woken particles.
+
+      The particles of an island rest on each other, so the sleeping
+      particles above (against gravity) a woken particle are woken
+      with it, and so on up through the island.
+     */
+    void wakeIslands();
+
     shared_ptr<IDRange> _range;
     double _sleepDistance;
     double _sleepTime;
@@ -25,6 +25,7 @@
 #include <dynamo/systems/visualizer.hpp>
 #include <dynamo/systems/sleep.hpp>
 #include <dynamo/particle.hpp>
+#include <dynamo/checkpoint.hpp>
 #include <dynamo/ranges/IDRangeAll.hpp>
 #include <magnet/xmlwriter.hpp>
 #include <magnet/xmlreader.hpp>
@@ -38,6 +39,18 @@ namespace dynamo {
     type = VIRTUAL;
   }
 
+  void
+  System::saveCheckpoint(std::ostream& os) const
+  {
+    checkpoint::write(os, dt);
+  }
+
+  void
+  System::loadCheckpoint(std::istream& is)
+  {
+    checkpoint::read(is, dt);
+  }
+
   magnet::xml::XmlStream& operator<<(magnet::xml::XmlStream& XML, 
 				     const System& g)
   {
@@ -58,6 +58,15 @@ namespace dynamo {
 
     virtual void outputData(magnet::xml::XmlStream&) const {}
 
+    /*! \brief Write the dynamic state of the System (by default its
+        event timer) to a binary checkpoint (see
+        Simulation::writeCheckpoint()).
+     */
+    virtual void saveCheckpoint(std::ostream&) const;
+
+    /*! \brief Restore the state written by saveCheckpoint(). */
+    virtual void loadCheckpoint(std::istream&);
+
   protected:
     virtual void outputXML(magnet::xml::XmlStream&) const = 0;
 
@@ -34,6 +34,11 @@ namespace dynamo {
 
     void increasedt(double);
 
+    //The halt time is set by the current run, not the checkpoint
+    virtual void saveCheckpoint(std::ostream&) const {}
+
+    virtual void loadCheckpoint(std::istream&) {}
+
     virtual void replicaExchange(System& os) {
       auto s = static_cast<SystHalt&>(os);
       std::swap(dt, s.dt);
@@ -260,7 +260,7 @@ namespace dynamo {
 	    ++residue;
 	  }
 
-	ranges.push_back(shared_ptr<IDRange>(new IDRangeRange(startID, ID)));
+	ranges.push_back(shared_ptr<IDRange>(new IDRangeRange(startID, ID - 1)));
 
 	//If we're starting a new chain, skip at least three residue
 	//ID's (so that all special cases for intra-molecule
@@ -221,6 +221,9 @@ namespace dynamo {
       return it->second;
     }
 
+    //! \brief The map between particle IDs and their bead data.
+    const BeadTypeMap& getBeadMap() const { return *_types; }
+
   protected:
     std::shared_ptr<BeadTypeMap> _types;
     std::vector<std::pair<size_t, std::string> > _configData;
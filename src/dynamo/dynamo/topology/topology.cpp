@@ -33,6 +33,48 @@ namespace dynamo {
     ID(nID)
   { }
 
+  void
+  Topology::shareImmutableData(const Topology& other)
+  {
+    if (magnet::xml::toXMLString(*this) == magnet::xml::toXMLString(other))
+      {
+	ranges = other.ranges;
+	_molecules = other._molecules;
+      }
+  }
+
+  void
+  Topology::initialise()
+  {
+    //The arrays may have been shared by another Simulation
+    if (_molecules) return;
+
+    shared_ptr<MoleculeData> data(new MoleculeData);
+    data->particleMolecule.assign(Sim->N(), std::numeric_limits<size_t>::max());
+    data->offsets.reserve(ranges.size() + 1);
+    data->offsets.push_back(0);
+    for (const shared_ptr<IDRange>& range : ranges)
+      {
+	range->forEach([&](const size_t ID) {
+	    if (ID >= Sim->N())
+	      M_throw() << "Particle " << ID << " in the Topology \"" << _name << "\" does not exist";
+	    if (data->particleMolecule[ID] != std::numeric_limits<size_t>::max())
+	      M_throw() << "Particle " << ID << " is in more than one molecule of the Topology \"" << _name << "\"";
+	    data->particleMolecule[ID] = data->offsets.size() - 1;
+	    data->IDs.push_back(ID);
+	  });
+	data->offsets.push_back(data->IDs.size());
+      }
+
+    _molecules = data;
+  }
+
+  bool
+  Topology::isInStructure(const Particle& part) const
+  {
+    return getParticleMolecule(part.getID()) != std::numeric_limits<size_t>::max();
+  }
+
   magnet::xml::XmlStream& operator<<(magnet::xml::XmlStream& XML, const Topology& g)
   {
     g.outputXML(XML);
@@ -19,7 +19,8 @@
 #include <dynamo/base.hpp>
 #include <dynamo/ranges/IDRange.hpp>
 #include <string>
-#include <list>
+#include <vector>
+#include <limits>
 
 namespace magnet { namespace xml { class Node; } }
 namespace xml { class XmlStream; }
@@ -27,18 +28,29 @@ namespace dynamo {
   class Particle;
   class Interaction;
 
+  /*! \brief A set of molecules (each an IDRange of particles).
+
+    The molecule IDRange -s are kept for the configuration file, but
+    when the Topology is initialised they are also flattened into
+    compressed sparse row (CSR) arrays. These give the particles of a
+    molecule as one contiguous array (see getMolecule()) and the
+    molecule of a particle (see getParticleMolecule()) without any
+    virtual calls, and are used by the structural output plugins.
+   */
   class Topology: public dynamo::SimBase_const
   {
   public:  
     virtual ~Topology() {}
 
+    //! Returns true if the particle is in one of the molecules.
     bool isInStructure(const Particle &) const;
   
     const size_t& getID() const { return ID; }
   
     virtual void operator<<(const magnet::xml::Node&);
 
-    virtual void initialise() {}
+    //! Builds the CSR arrays of the molecules.
+    virtual void initialise();
 
     friend magnet::xml::XmlStream& operator<<(magnet::xml::XmlStream&, const Topology&);
   
@@ -50,17 +62,55 @@ namespace dynamo {
     inline void addMolecule(IDRange* ptr)
     { ranges.push_back(shared_ptr<IDRange>(ptr)); }
 
-    inline const std::list<shared_ptr<IDRange> >& getMolecules() const
+    inline const std::vector<shared_ptr<IDRange> >& getMolecules() const
     { return ranges; }
 
     inline size_t getMoleculeCount() const { return ranges.size(); }
 
+    //! The IDs of the particles of a molecule, as a contiguous array.
+    inline IDRange::Block getMolecule(size_t molecule) const
+    {
+      const size_t start = _molecules->offsets[molecule];
+      return IDRange::Block(_molecules->IDs.data() + start, _molecules->offsets[molecule + 1] - start);
+    }
+
+    /*! \brief The index of the molecule containing a particle, or
+        std::numeric_limits<size_t>::max() if it is not in this
+        Topology.
+     */
+    inline size_t getParticleMolecule(size_t particleID) const
+    { return _molecules->particleMolecule[particleID]; }
+
+    /*! \brief Share the immutable data of an identically configured
+        Topology of another Simulation (see
+        Simulation::shareImmutableData()).
+
+      By default, the molecule IDRange -s are shared if the two
+      Topology -s are identical.
+     */
+    virtual void shareImmutableData(const Topology& other);
+
   protected:
     Topology(dynamo::Simulation*, size_t ID);
 
     virtual void outputXML(magnet::xml::XmlStream&) const = 0;
   
-    std::list<shared_ptr<IDRange> > ranges;
+    std::vector<shared_ptr<IDRange> > ranges;
+
+    /*! \brief The molecules flattened into CSR arrays.
+
+      The particles of molecule m are IDs[offsets[m]] to
+      IDs[offsets[m+1] - 1].
+     */
+    struct MoleculeData
+    {
+      std::vector<size_t> offsets;
+      std::vector<size_t> IDs;
+      //! The molecule of each particle.
+      std::vector<size_t> particleMolecule;
+    };
+
+    shared_ptr<const MoleculeData> _molecules;
   
     std::string _name;
   
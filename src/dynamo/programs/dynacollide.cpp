@@ -73,7 +73,7 @@ int main(int argc, char *argv[])
 
       std::mt19937 RNG;
       RNG.seed(std::random_device()());
-      Sim.ranGenerator.seed(std::random_device()());
+      Sim.setRandomSeed(std::random_device()());
       Sim.dynamics = dynamo::shared_ptr<dynamo::Dynamics>(new dynamo::DynNewtonian(&Sim));
       Sim.BCs = dynamo::shared_ptr<dynamo::BoundaryCondition>(new dynamo::BCNone(&Sim));
       Sim.ptrScheduler = dynamo::shared_ptr<dynamo::SNeighbourList>(new dynamo::SNeighbourList(&Sim, new dynamo::FELBoundedPQ<dynamo::PELMinMax<3> >()));
@@ -0,0 +1,275 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*! \file dynaeventlog.cpp
+  \brief Converts, filters and replays binary event logs.
+
+  The binary event logs written by the EventLog output plugin (see
+  dynamo::OPEventLog) can be filtered to a smaller binary log without
+  any other input. If the configuration file the logged run started
+  from is given, the particle trajectories are replayed by streaming
+  the particles between the logged events and applying the logged
+  velocities. This allows the log to be converted to the text format
+  of the Trajectory output plugin, the trajectories of particles to
+  be written out, or the configuration at any event to be
+  regenerated.
+ */
+
+#include <dynamo/simulation.hpp>
+#include <dynamo/outputplugins/eventlog.hpp>
+#include <dynamo/outputplugins/trajectory.hpp>
+#include <dynamo/dynamics/dynamics.hpp>
+#include <dynamo/species/species.hpp>
+#include <dynamo/NparticleEventData.hpp>
+#include <magnet/exception.hpp>
+#include <magnet/stream/formattedostream.hpp>
+#include <boost/program_options.hpp>
+#include <boost/tokenizer.hpp>
+#include <boost/lexical_cast.hpp>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <set>
+#include <vector>
+
+namespace po = boost::program_options;
+using namespace std;
+using namespace dynamo;
+
+namespace {
+  Vector toVector(const double (&vec)[3], const double unit)
+  { return Vector{vec[0], vec[1], vec[2]} * unit; }
+
+  /*! \brief Replays the particle changes of a single logged event.
+
+    The Simulation is streamed up to the time of the event, then the
+    logged velocities are applied. The returned NEventData and Event
+    match those passed to the output plugins in the logged run.
+   */
+  NEventData replayEvent(Simulation& sim, const std::vector<EventLogRecord>& records, Event& event)
+  {
+    const EventLogRecord& first = records.front();
+    const double newTime = first.time * sim.units.unitTime();
+    const double dt = newTime - sim.systemTime;
+    sim.systemTime = newTime;
+    sim.stream(dt);
+    sim.eventCount = first.eventCount;
+
+    event = Event(first.p1, first.dt * sim.units.unitTime(), EventSource(first.source), EEventType(first.type), first.sourceID);
+
+    NEventData data;
+    for (const EventLogRecord& record : records)
+      {
+	if (record.p1 == EventLogRecord::NoParticle)
+	  continue;
+
+	if ((record.p1 >= sim.N()) || ((record.p2 != EventLogRecord::NoParticle) && (record.p2 >= sim.N())))
+	  M_throw() << "The event log contains particle IDs which are not in the configuration";
+
+	Particle& p1 = sim.particles[record.p1];
+	sim.dynamics->updateParticle(p1);
+
+	if (record.p2 == EventLogRecord::NoParticle)
+	  {
+	    data.L1partChanges.push_back(ParticleEventData(p1, *sim.species(p1), EEventType(record.particleType)));
+	    p1.getVelocity() = toVector(record.vel1, sim.units.unitVelocity());
+	  }
+	else
+	  {
+	    Particle& p2 = sim.particles[record.p2];
+	    sim.dynamics->updateParticle(p2);
+	    PairEventData pData(p1, p2, *sim.species(p1), *sim.species(p2), EEventType(record.particleType));
+	    pData.impulse = toVector(record.impulse, sim.units.unitMomentum());
+	    p1.getVelocity() = toVector(record.vel1, sim.units.unitVelocity());
+	    p2.getVelocity() = toVector(record.vel2, sim.units.unitVelocity());
+	    data.L2partChanges.push_back(pData);
+	  }
+      }
+
+    return data;
+  }
+}
+
+int
+main(int argc, char *argv[])
+{
+  std::cout << "dynaeventlog  Copyright (C) 2011  Marcus N Campbell Bannerman\n"
+	    << "This program comes with ABSOLUTELY NO WARRANTY.\n"
+	    << "This is free software, and you are welcome to redistribute it\n"
+	    << "under certain conditions. See the licence you obtained with\n"
+	    << "the code\n";
+
+  try
+    {
+      po::options_description opts("Options");
+      opts.add_options()
+	("help,h", "Produces this message.")
+	("log-file", po::value<std::string>(), "The binary event log to process.")
+	("config,c", po::value<std::string>(), "The configuration file the logged run started from. This is required to replay the trajectories (for --text, --trajectory and --out-config).")
+	("text,t", po::value<std::string>(), "Convert the (selected) events to the text format of the Trajectory plugin, writing them to this file.")
+	("trajectory", po::value<std::string>(), "Write the time, position and velocity of the (selected) particles at each of their events to this file.")
+	("out-config,o", po::value<std::string>(), "Write the replayed configuration at the end of the selected events to this file.")
+	("filter,f", po::value<std::string>(), "Write the selected events to this file as a binary event log.")
+	("first-event", po::value<size_t>()->default_value(0), "The first event count to select.")
+	("last-event", po::value<size_t>()->default_value(std::numeric_limits<size_t>::max()), "The last event count to select (processing stops after this event).")
+	("particles,p", po::value<std::string>(), "Comma separated list of particle IDs. Only events involving these particles are selected.")
+	;
+
+      po::positional_options_description positional;
+      positional.add("log-file", 1);
+
+      po::variables_map vm;
+      po::store(po::command_line_parser(argc, argv).options(opts).positional(positional).run(), vm);
+      po::notify(vm);
+
+      if (vm.count("help") || !vm.count("log-file"))
+	{
+	  cout << "Usage : dynaeventlog <OPTIONS>... <eventlog.bin>\n"
+	       << " Converts, filters and replays the binary event logs of the EventLog output plugin.\n"
+	       << opts;
+	  return 1;
+	}
+
+      const bool replay = vm.count("text") || vm.count("trajectory") || vm.count("out-config");
+      if (replay && !vm.count("config"))
+	M_throw() << "The starting configuration (--config) is required to replay the event log";
+
+      const std::string logFile = vm["log-file"].as<std::string>();
+      std::ifstream log(logFile, std::ios::binary);
+      if (!log)
+	M_throw() << "Could not open the event log \"" << logFile << "\"";
+
+      EventLogHeader header;
+      header.read(log);
+
+      const size_t firstEvent = vm["first-event"].as<size_t>();
+      const size_t lastEvent = vm["last-event"].as<size_t>();
+
+      std::set<uint64_t> particles;
+      if (vm.count("particles"))
+	{
+	  boost::char_separator<char> sep(",");
+	  const std::string list = vm["particles"].as<std::string>();
+	  boost::tokenizer<boost::char_separator<char> > tokens(list, sep);
+	  for (const auto& token : tokens)
+	    particles.insert(boost::lexical_cast<uint64_t>(token));
+	}
+
+      Simulation sim;
+      if (replay)
+	{
+	  sim.loadXMLfile(vm["config"].as<std::string>());
+	  sim.initialise();
+	  sim.systemTime = header.startTime * sim.units.unitTime();
+	  sim.eventCount = header.startEventCount;
+	}
+
+      std::ofstream text, trajectory, filtered;
+      if (vm.count("text"))
+	{
+	  text.open(vm["text"].as<std::string>());
+	  text.precision(4);
+	  text.setf(std::ios::fixed);
+	}
+
+      if (vm.count("trajectory"))
+	{
+	  trajectory.open(vm["trajectory"].as<std::string>());
+	  trajectory << "#Time ID x y z vx vy vz\n";
+	}
+
+      if (vm.count("filter"))
+	{
+	  filtered.open(vm["filter"].as<std::string>(), std::ios::binary);
+	  filtered.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	}
+
+      size_t events(0), selectedEvents(0), records(0);
+      std::vector<EventLogRecord> eventRecords;
+      EventLogRecord record;
+      bool more = true;
+      while (more)
+	{
+	  more = bool(log.read(reinterpret_cast<char*>(&record), sizeof(record)));
+
+	  //Process the collected records once the next event is reached
+	  if (!eventRecords.empty() && (!more || (record.eventCount != eventRecords.front().eventCount)))
+	    {
+	      const EventLogRecord& first = eventRecords.front();
+	      if (first.eventCount > lastEvent)
+		break;
+	      ++events;
+
+	      bool selected = (first.eventCount >= firstEvent);
+	      if (selected && !particles.empty())
+		{
+		  selected = false;
+		  for (const EventLogRecord& r : eventRecords)
+		    selected = selected || particles.count(r.p1) || particles.count(r.p2);
+		}
+	      selectedEvents += selected;
+
+	      if (replay)
+		{
+		  Event event;
+		  const NEventData data = replayEvent(sim, eventRecords, event);
+
+		  if (selected && text.is_open())
+		    OPTrajectory::writeEvent(text, sim, event, data);
+
+		  if (selected && trajectory.is_open())
+		    for (const EventLogRecord& r : eventRecords)
+		      for (const uint64_t ID : {r.p1, r.p2})
+			if ((ID != EventLogRecord::NoParticle) && (particles.empty() || particles.count(ID)))
+			  {
+			    const Particle& part = sim.particles[ID];
+			    const Vector pos = part.getPosition() / sim.units.unitLength();
+			    const Vector vel = part.getVelocity() / sim.units.unitVelocity();
+			    trajectory << sim.systemTime / sim.units.unitTime() << " " << ID
+				       << " " << pos[0] << " " << pos[1] << " " << pos[2]
+				       << " " << vel[0] << " " << vel[1] << " " << vel[2] << "\n";
+			  }
+		}
+
+	      if (selected && filtered.is_open())
+		filtered.write(reinterpret_cast<const char*>(eventRecords.data()), eventRecords.size() * sizeof(EventLogRecord));
+
+	      eventRecords.clear();
+	    }
+
+	  if (more)
+	    {
+	      eventRecords.push_back(record);
+	      ++records;
+	    }
+	}
+
+      if (vm.count("out-config"))
+	sim.writeXMLfile(vm["out-config"].as<std::string>());
+
+      std::cout << "Records=" << records << " Events=" << events << " Selected=" << selectedEvents << std::endl;
+    }
+  catch (std::exception& cep)
+    {
+      std::cout.flush();
+      magnet::stream::FormattedOStream os(std::cerr, "Main(): ");
+      os << cep.what() << std::endl;
+      return 1;
+    }
+
+  return 0;
+}
@@ -0,0 +1,398 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2013 Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*! \file dynamo_bench.cpp
+  \brief A reproducible benchmark of the event loop.
+
+  A set of canonical systems are generated (using the same packer as
+  dynamod) at a range of system sizes, and each is run for a fixed
+  number of events with each of the requested sorters. The event
+  throughput and the peak resident set size of every run are written
+  to an XML file, so that the results of different commits can be
+  compared.
+
+  With the --replay option, the operations performed on the sorter
+  by each system are also recorded, and the recorded stream is
+  replayed into every sorter. This times the sorters in isolation on
+  an identical (and realistic) sequence of operations.
+ */
+
+#include <dynamo/simulation.hpp>
+#include <dynamo/schedulers/scheduler.hpp>
+#include <dynamo/schedulers/sorters/FEL.hpp>
+#include <dynamo/inputplugins/include.hpp>
+#include <magnet/exception.hpp>
+#include <magnet/memUsage.hpp>
+#include <magnet/xmlwriter.hpp>
+#include <magnet/stream/formattedostream.hpp>
+#include <dynamo/eventtypes.hpp>
+#include <boost/program_options.hpp>
+#include <boost/tokenizer.hpp>
+#include <boost/lexical_cast.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+
+namespace po = boost::program_options;
+using namespace std;
+
+namespace {
+  /*! \brief A canonical benchmark system, generated by the packer.
+   */
+  struct BenchSystem
+  {
+    //! The name of the system.
+    const char* name;
+    //! The packer options used to generate the system.
+    std::vector<std::string> packerArgs;
+    //! The number of particles the packer places per lattice site.
+    double particlesPerSite;
+  };
+
+  const std::vector<BenchSystem> benchSystems = {
+    {"HardSpheres", {"--pack-mode", "0"}, 1},
+    {"SquareWells", {"--pack-mode", "1"}, 1},
+    //Equal mole fractions of spheres and 10 bead stiff polymers
+    {"Polymers", {"--pack-mode", "14", "--i2", "10"}, 5.5},
+    {"ShearedLEBC", {"--pack-mode", "4"}, 1},
+    {"GravityBed", {"--pack-mode", "22", "--f1", "0.9"}, 1},
+    {"Stepped", {"--pack-mode", "16"}, 1}
+  };
+
+  /*! \brief The options of the IPPacker (these match those of
+      dynamod).
+   */
+  po::options_description getPackerOptions()
+  {
+    po::options_description opts;
+    opts.add(dynamo::IPPacker::getOptions());
+    opts.add_options()
+      ("b1", "")
+      ("b2", "")
+      ("i1", po::value<size_t>(), "")
+      ("i2", po::value<size_t>(), "")
+      ("i3", po::value<size_t>(), "")
+      ("i4", po::value<size_t>(), "")
+      ("s1", po::value<std::string>(), "")
+      ("s2", po::value<std::string>(), "")
+      ("f1", po::value<double>(), "")
+      ("f2", po::value<double>(), "")
+      ("f3", po::value<double>(), "")
+      ("f4", po::value<double>(), "")
+      ("f5", po::value<double>(), "")
+      ("NCells,C", po::value<unsigned long>()->default_value(7), "")
+      ("xcell,x", po::value<unsigned long>(), "")
+      ("ycell,y", po::value<unsigned long>(), "")
+      ("zcell,z", po::value<unsigned long>(), "")
+      ("rectangular-box", "")
+      ("density,d", po::value<double>()->default_value(0.5), "")
+      ;
+    return opts;
+  }
+
+  /*! \brief Reset the peak resident set size of the process, so
+      that it may be measured for each run (only possible on Linux).
+   */
+  void resetPeakRSS()
+  {
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    if (clear_refs.is_open())
+      clear_refs << "5";
+  }
+
+  /*! \brief The peak resident set size of the process in KB.
+
+    This uses the VmHWM entry of the Linux proc file system, which is
+    reset by resetPeakRSS(). Otherwise it falls back to the maximum of
+    magnet::process_mem_usage() over every call. That is the lifetime
+    peak where getrusage() reports it, and otherwise the largest
+    current resident set size seen when sampled.
+   */
+  double peakRSS()
+  {
+    static double maxSample(0);
+
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+      if (line.compare(0, 6, "VmHWM:") == 0)
+	{
+	  double value(0);
+	  std::istringstream(line.substr(6)) >> value;
+	  return value;
+	}
+
+    maxSample = std::max(maxSample, magnet::process_mem_usage());
+    return maxSample;
+  }
+
+  /*! \brief A FEL which records every operation performed on it,
+      before passing it on to another FEL.
+   */
+  class RecordingFEL: public dynamo::FEL
+  {
+  public:
+    enum Operation: uint8_t { INIT, CLEAR, EMPTY, INVALIDATE, POP, PUSH, RESCALE, STREAM, TOP };
+
+    /*! \brief A recorded operation. The event holds the argument of
+        push(), the ID of init() and invalidate() is stored in
+        _particle1ID and the value of stream() and rescaleTimes() in
+        _dt.
+     */
+    struct Record
+    {
+      dynamo::Event event;
+      Operation op;
+    };
+
+    RecordingFEL(const dynamo::shared_ptr<dynamo::FEL>& fel): _fel(fel) {}
+
+    virtual void clear() { record(CLEAR); _fel->clear(); }
+    virtual bool empty() { record(EMPTY); return _fel->empty(); }
+    virtual void init(const size_t N) { record(INIT, N); _fel->init(N); }
+    virtual void invalidate(const size_t ID) { record(INVALIDATE, ID); _fel->invalidate(ID); }
+    virtual void pop() { record(POP); _fel->pop(); }
+    virtual void push(dynamo::Event event) { _records.push_back(Record{event, PUSH}); _fel->push(event); }
+    virtual void rescaleTimes(const double f) { record(RESCALE, 0, f); _fel->rescaleTimes(f); }
+    virtual void stream(const double dt) { record(STREAM, 0, dt); _fel->stream(dt); }
+    virtual dynamo::Event top() { record(TOP); return _fel->top(); }
+
+    const std::vector<Record>& getRecords() const { return _records; }
+
+    /*! \brief Perform a recorded stream of operations on a FEL.
+
+      \return A checksum of the values returned by the queries (this
+      should match between sorters using the same type of PEL).
+     */
+    static double replay(dynamo::FEL& fel, const std::vector<Record>& records)
+    {
+      double checksum(0);
+      for (const Record& rec : records)
+	switch (rec.op)
+	  {
+	  case INIT: fel.init(rec.event._particle1ID); break;
+	  case CLEAR: fel.clear(); break;
+	  case EMPTY: checksum += fel.empty(); break;
+	  case INVALIDATE: fel.invalidate(rec.event._particle1ID); break;
+	  case POP: fel.pop(); break;
+	  case PUSH: fel.push(rec.event); break;
+	  case RESCALE: fel.rescaleTimes(rec.event._dt); break;
+	  case STREAM: fel.stream(rec.event._dt); break;
+	  case TOP: checksum += fel.top()._dt; break;
+	  }
+      return checksum;
+    }
+
+  private:
+    void record(const Operation op, const size_t ID = 0, const double value = 0)
+    {
+      dynamo::Event event;
+      event._particle1ID = ID;
+      event._dt = value;
+      _records.push_back(Record{event, op});
+    }
+
+    virtual void outputXML(magnet::xml::XmlStream& XML) const { XML << *_fel; }
+
+    dynamo::shared_ptr<dynamo::FEL> _fel;
+    std::vector<Record> _records;
+  };
+
+  /*! \brief Generate a benchmark system of roughly the requested
+      size.
+   */
+  void buildSystem(dynamo::Simulation& sim, const BenchSystem& system, const size_t size, const po::options_description& packerOpts)
+  {
+    //Pick the number of FCC unit cells to give roughly the
+    //requested system size
+    const unsigned long cells = std::max(1l, std::lround(std::cbrt(size / (4 * system.particlesPerSite))));
+    std::vector<std::string> packerArgs = system.packerArgs;
+    packerArgs.push_back("--NCells");
+    packerArgs.push_back(boost::lexical_cast<std::string>(cells));
+
+    po::variables_map packerVM;
+    po::store(po::command_line_parser(packerArgs).options(packerOpts).run(), packerVM);
+    po::notify(packerVM);
+
+    dynamo::IPPacker(packerVM, &sim).initialise();
+    dynamo::InputPlugin(&sim, "Rescaler").zeroMomentum();
+    dynamo::InputPlugin(&sim, "Rescaler").rescaleVels(1.0);
+  }
+
+  template<class T>
+  std::vector<T> parseList(const std::string& list)
+  {
+    std::vector<T> retval;
+    boost::char_separator<char> sep(",");
+    boost::tokenizer<boost::char_separator<char> > tokens(list, sep);
+    for (const auto& token : tokens)
+      retval.push_back(boost::lexical_cast<T>(token));
+    return retval;
+  }
+}
+
+int
+main(int argc, char *argv[])
+{
+  std::cout << "dynamo_bench  Copyright (C) 2013  Marcus N Campbell Bannerman\n"
+	    << "This program comes with ABSOLUTELY NO WARRANTY.\n"
+	    << "This is free software, and you are welcome to redistribute it\n"
+	    << "under certain conditions. See the licence you obtained with\n"
+	    << "the code\n";
+
+  try
+    {
+      std::string systemNames;
+      for (const BenchSystem& system : benchSystems)
+	systemNames += std::string(systemNames.empty() ? "" : ",") + system.name;
+
+      po::options_description opts("Options");
+      opts.add_options()
+	("help,h", "Produces this message.")
+	("systems", po::value<std::string>()->default_value(systemNames), "Comma separated list of the systems to benchmark.")
+	("sizes", po::value<std::string>()->default_value("1000,10000,100000"), "Comma separated list of the (approximate) number of particles in each system. Sizes up to 10000000 are practical.")
+	("sorters", po::value<std::string>()->default_value("BoundedPQMinMax3,BoundedPQHeap,CBT,CBTKey,QuadHeapMinMax3,LadderMinMax3"), "Comma separated list of the sorters (FEL types) to benchmark.")
+	("replay", "Also record the sorter operations of each system (using the first sorter), and time every sorter replaying the recorded stream.")
+	("events,c", po::value<size_t>()->default_value(100000), "Number of events to run each benchmark for.")
+	("random-seed,s", po::value<unsigned int>()->default_value(1), "Seed value for the random number generators.")
+	("out-data-file,o", po::value<std::string>()->default_value("bench.xml"), "The file to write the benchmark results to.")
+	;
+
+      po::variables_map vm;
+      po::store(po::command_line_parser(argc, argv).options(opts).run(), vm);
+      po::notify(vm);
+
+      if (vm.count("help"))
+	{
+	  cout << "Usage : dynamo_bench <OPTIONS>...\n"
+	       << " Runs a set of standard systems for a fixed number of events and reports the event rate and memory usage.\n"
+	       << opts;
+	  return 1;
+	}
+
+      const std::vector<std::string> systems = parseList<std::string>(vm["systems"].as<std::string>());
+      const std::vector<size_t> sizes = parseList<size_t>(vm["sizes"].as<std::string>());
+      const std::vector<std::string> sorters = parseList<std::string>(vm["sorters"].as<std::string>());
+      const size_t events = vm["events"].as<size_t>();
+      const unsigned int seed = vm["random-seed"].as<unsigned int>();
+
+      namespace xml = magnet::xml;
+      xml::XmlStream XML;
+      XML.setFormatXML(true);
+      XML << xml::prolog() << xml::tag("Benchmark")
+	  << xml::attr("Events") << events
+	  << xml::attr("Seed") << seed;
+
+      const po::options_description packerOpts = getPackerOptions();
+
+      for (const std::string& systemName : systems)
+	{
+	  auto system = std::find_if(benchSystems.begin(), benchSystems.end(), [&](const BenchSystem& s) { return systemName == s.name; });
+	  if (system == benchSystems.end())
+	    M_throw() << "Unknown benchmark system \"" << systemName << "\", valid systems are " << systemNames;
+
+	  for (const size_t size : sizes)
+	    for (const std::string& sorter : sorters)
+	      {
+		resetPeakRSS();
+
+		dynamo::Simulation sim;
+		sim.setRandomSeed(seed);
+
+		const auto initStart = std::chrono::steady_clock::now();
+		buildSystem(sim, *system, size, packerOpts);
+		sim.ptrScheduler->setSorter(dynamo::FEL::getClass(sorter));
+		sim.endEventCount = events;
+		sim.initialise();
+		const double initTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - initStart).count();
+
+		const auto runStart = std::chrono::steady_clock::now();
+		while (sim.runSimulationStep(true)) {}
+		const double runTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - runStart).count();
+
+		const double eventRate = sim.eventCount / runTime;
+		const double rss = peakRSS();
+
+		XML << xml::tag("Run")
+		    << xml::attr("System") << system->name
+		    << xml::attr("N") << sim.N()
+		    << xml::attr("Sorter") << sorter
+		    << xml::attr("Events") << sim.eventCount
+		    << xml::attr("InitSeconds") << initTime
+		    << xml::attr("RunSeconds") << runTime
+		    << xml::attr("EventsPerSec") << eventRate
+		    << xml::attr("PeakRSSkB") << rss
+		    << xml::endtag("Run");
+
+		std::cout << system->name << " N=" << sim.N() << " Sorter=" << sorter
+			  << " EventsPerSec=" << eventRate << " PeakRSS=" << rss << "kB" << std::endl;
+	      }
+
+	  if (vm.count("replay") && !sorters.empty())
+	    for (const size_t size : sizes)
+	      {
+		dynamo::Simulation sim;
+		sim.setRandomSeed(seed);
+		buildSystem(sim, *system, size, packerOpts);
+		dynamo::shared_ptr<RecordingFEL> recorder(new RecordingFEL(dynamo::FEL::getClass(sorters.front())));
+		sim.ptrScheduler->setSorter(recorder);
+		sim.endEventCount = events;
+		sim.initialise();
+		while (sim.runSimulationStep(true)) {}
+
+		const std::vector<RecordingFEL::Record>& records = recorder->getRecords();
+		for (const std::string& sorter : sorters)
+		  {
+		    const dynamo::shared_ptr<dynamo::FEL> fel = dynamo::FEL::getClass(sorter);
+		    const auto start = std::chrono::steady_clock::now();
+		    const double checksum = RecordingFEL::replay(*fel, records);
+		    const double runTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		    const double opRate = records.size() / runTime;
+
+		    XML << xml::tag("Replay")
+			<< xml::attr("System") << system->name
+			<< xml::attr("N") << sim.N()
+			<< xml::attr("Sorter") << sorter
+			<< xml::attr("Operations") << records.size()
+			<< xml::attr("Seconds") << runTime
+			<< xml::attr("OperationsPerSec") << opRate
+			<< xml::attr("Checksum") << checksum
+			<< xml::endtag("Replay");
+
+		    std::cout << system->name << " N=" << sim.N() << " Sorter=" << sorter << " Replay"
+			      << " Operations=" << records.size() << " OperationsPerSec=" << opRate
+			      << " Checksum=" << checksum << std::endl;
+		  }
+	      }
+	}
+
+      XML << xml::endtag("Benchmark");
+      XML.write_file(vm["out-data-file"].as<std::string>());
+    }
+  catch (std::exception& cep)
+    {
+      std::cout.flush();
+      magnet::stream::FormattedOStream os(std::cerr, "Main(): ");
+      os << cep.what() << std::endl;
+      return 1;
+    }
+
+  return 0;
+}
@@ -122,7 +122,7 @@ main(int argc, char *argv[])
       po::notify(vm);
 
       if (vm.count("random-seed"))
-	sim.ranGenerator.seed(vm["random-seed"].as<unsigned int>());
+	sim.setRandomSeed(vm["random-seed"].as<unsigned int>());
       
       if (!vm.count("pack-mode") && (vm.count("help") || !vm.count("config-file")))
 	{
@@ -35,7 +35,7 @@ dynamo::Vector getRandVelVec()
 void init(dynamo::Simulation& Sim, const double density)
 {
   RNG.seed(std::random_device()());
-  Sim.ranGenerator.seed(std::random_device()());
+  Sim.setRandomSeed(std::random_device()());
 
   Sim.dynamics = dynamo::shared_ptr<dynamo::Dynamics>(new dynamo::DynNewtonian(&Sim));
   Sim.BCs = dynamo::shared_ptr<dynamo::BoundaryCondition>(new dynamo::BCPeriodic(&Sim));
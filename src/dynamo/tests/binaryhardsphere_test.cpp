@@ -35,7 +35,7 @@ dynamo::Vector getRandVelVec()
 void init(dynamo::Simulation& Sim, const double density)
 {
   RNG.seed(std::random_device()());
-  Sim.ranGenerator.seed(std::random_device()());
+  Sim.setRandomSeed(std::random_device()());
 
   double massFrac = 0.001, sizeRatio = 0.5;
   size_t Na=100;
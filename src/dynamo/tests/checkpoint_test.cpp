@@ -0,0 +1,164 @@
+#define BOOST_TEST_MODULE Checkpoint_test
+#include <boost/test/included/unit_test.hpp>
+#include <dynamo/simulation.hpp>
+#include <dynamo/BC/include.hpp>
+#include <dynamo/ranges/include.hpp>
+#include <dynamo/inputplugins/cells/include.hpp>
+#include <dynamo/species/point.hpp>
+#include <dynamo/dynamics/newtonian.hpp>
+#include <dynamo/schedulers/include.hpp>
+#include <dynamo/schedulers/sorters/boundedPQFEL.hpp>
+#include <dynamo/schedulers/sorters/MinMaxPEL.hpp>
+#include <dynamo/inputplugins/include.hpp>
+#include <dynamo/interactions/hardsphere.hpp>
+#include <dynamo/systems/andersenThermostat.hpp>
+#include <random>
+
+std::mt19937 RNG(1234);
+typedef dynamo::BoundedPQFEL<dynamo::MinMaxPEL<3> > DefaultSorter;
+
+const size_t eventsBefore = 20000;
+const unsigned int seed = 5678;
+
+dynamo::Vector getRandVelVec()
+{
+  //See http://mathworld.wolfram.com/SpherePointPicking.html
+  std::normal_distribution<> normal_dist(0.0, (1.0 / sqrt(double(NDIM))));
+
+  dynamo::Vector tmpVec;
+  for (size_t iDim = 0; iDim < NDIM; iDim++)
+    tmpVec[iDim] = normal_dist(RNG);
+
+  return tmpVec;
+}
+
+void init(dynamo::Simulation& Sim, const double density)
+{
+  Sim.setRandomSeed(seed);
+
+  Sim.dynamics = dynamo::shared_ptr<dynamo::Dynamics>(new dynamo::DynNewtonian(&Sim));
+  Sim.BCs = dynamo::shared_ptr<dynamo::BoundaryCondition>(new dynamo::BCPeriodic(&Sim));
+  Sim.ptrScheduler = dynamo::shared_ptr<dynamo::SNeighbourList>(new dynamo::SNeighbourList(&Sim, new DefaultSorter()));
+
+  std::unique_ptr<dynamo::UCell> packptr(new dynamo::CUFCC(std::array<long, 3>{{5,5,5}}, dynamo::Vector{1,1,1}, new dynamo::UParticle()));
+  packptr->initialise();
+  std::vector<dynamo::Vector> latticeSites(packptr->placeObjects(dynamo::Vector{0,0,0}));
+  Sim.primaryCellSize = dynamo::Vector{1,1,1};
+
+  double particleDiam = std::cbrt(density / latticeSites.size());
+  Sim.interactions.push_back(dynamo::shared_ptr<dynamo::Interaction>(new dynamo::IHardSphere(&Sim, particleDiam, 1.0, new dynamo::IDPairRangeAll(), "Bulk")));
+  Sim.addSpecies(dynamo::shared_ptr<dynamo::Species>(new dynamo::SpPoint(&Sim, new dynamo::IDRangeAll(&Sim), 1.0, "Bulk", 0)));
+  Sim.units.setUnitLength(particleDiam);
+
+  unsigned long nParticles = 0;
+  Sim.particles.reserve(latticeSites.size());
+  for (const dynamo::Vector & position : latticeSites)
+    Sim.particles.push_back(dynamo::Particle(position, getRandVelVec() * Sim.units.unitVelocity(), nParticles++));
+
+  //A tuning thermostat, so that its tuning state must also be
+  //restored from the checkpoint
+  Sim.systems.push_back(dynamo::shared_ptr<dynamo::System>(new dynamo::SysAndersen(&Sim, 0.05 / Sim.N(), 1.0 * Sim.units.unitEnergy(), "Thermostat")));
+
+  Sim.ensemble = dynamo::Ensemble::loadEnsemble(Sim);
+
+  dynamo::InputPlugin(&Sim, "Rescaler").zeroMomentum();
+  dynamo::InputPlugin(&Sim, "Rescaler").rescaleVels(1.0);
+}
+
+void load(dynamo::Simulation& Sim, std::string filename)
+{
+  Sim.loadXMLfile(filename);
+  Sim.setRandomSeed(seed);
+}
+
+void run(dynamo::Simulation& Sim)
+{
+  while (Sim.runSimulationStep()) {}
+}
+
+void checkIdentical(dynamo::Simulation& Sim1, dynamo::Simulation& Sim2)
+{
+  BOOST_CHECK_EQUAL(Sim1.eventCount, Sim2.eventCount);
+  BOOST_CHECK_EQUAL(Sim1.systemTime, Sim2.systemTime);
+
+  Sim1.dynamics->updateAllParticles();
+  Sim2.dynamics->updateAllParticles();
+
+  BOOST_REQUIRE_EQUAL(Sim1.N(), Sim2.N());
+  size_t differences = 0;
+  for (size_t i(0); i < Sim1.N(); ++i)
+    differences += (Sim1.particles[i].getPosition() != Sim2.particles[i].getPosition())
+      || (Sim1.particles[i].getVelocity() != Sim2.particles[i].getVelocity());
+  BOOST_CHECK_EQUAL(differences, 0);
+}
+
+//The events of a rebuilt FEL only differ by rounding errors from
+//those of the original, so the trajectories stay close for a while
+void checkClose(dynamo::Simulation& Sim1, dynamo::Simulation& Sim2)
+{
+  BOOST_CHECK_EQUAL(Sim1.eventCount, Sim2.eventCount);
+  BOOST_CHECK_CLOSE(Sim1.systemTime, Sim2.systemTime, 1e-8);
+
+  Sim1.dynamics->updateAllParticles();
+  Sim2.dynamics->updateAllParticles();
+
+  BOOST_REQUIRE_EQUAL(Sim1.N(), Sim2.N());
+  double maxDeviation = 0;
+  for (size_t i(0); i < Sim1.N(); ++i)
+    {
+      dynamo::Vector rij = Sim1.particles[i].getPosition() - Sim2.particles[i].getPosition();
+      Sim1.BCs->applyBC(rij);
+      maxDeviation = std::max(maxDeviation, rij.nrm() / Sim1.units.unitLength());
+      const dynamo::Vector vij = Sim1.particles[i].getVelocity() - Sim2.particles[i].getVelocity();
+      maxDeviation = std::max(maxDeviation, vij.nrm() / Sim1.units.unitVelocity());
+    }
+  BOOST_CHECK_SMALL(maxDeviation, 1e-8);
+}
+
+void checkpointRestart(bool withFEL, const size_t eventsAfter)
+{
+  {
+    dynamo::Simulation Sim;
+    init(Sim, 0.5);
+    Sim.writeXMLfile("checkpoint_start.xml");
+  }
+
+  //The uninterrupted reference run
+  dynamo::Simulation reference;
+  load(reference, "checkpoint_start.xml");
+  reference.endEventCount = eventsBefore + eventsAfter;
+  reference.initialise();
+  run(reference);
+
+  {
+    dynamo::Simulation Sim;
+    load(Sim, "checkpoint_start.xml");
+    Sim.endEventCount = eventsBefore;
+    Sim.initialise();
+    run(Sim);
+    Sim.writeCheckpoint("checkpoint.bin", withFEL);
+    Sim.writeXMLfile("checkpoint_end.xml");
+  }
+
+  dynamo::Simulation restarted;
+  load(restarted, "checkpoint_end.xml");
+  restarted.loadCheckpoint("checkpoint.bin");
+  restarted.endEventCount = eventsAfter;
+  restarted.initialise();
+  run(restarted);
+
+  if (withFEL)
+    checkIdentical(reference, restarted);
+  else
+    checkClose(reference, restarted);
+}
+
+BOOST_AUTO_TEST_CASE( Restart_With_FEL )
+{
+  checkpointRestart(true, 20000);
+}
+
+BOOST_AUTO_TEST_CASE( Restart_Without_FEL )
+{
+  checkpointRestart(false, 500);
+}
@@ -0,0 +1,157 @@
+#define BOOST_TEST_MODULE Compression_test
+#include <boost/test/included/unit_test.hpp>
+#include <dynamo/simulation.hpp>
+#include <dynamo/BC/include.hpp>
+#include <dynamo/ranges/include.hpp>
+#include <dynamo/inputplugins/cells/include.hpp>
+#include <dynamo/species/point.hpp>
+#include <dynamo/dynamics/newtonian.hpp>
+#include <dynamo/schedulers/include.hpp>
+#include <dynamo/schedulers/sorters/boundedPQFEL.hpp>
+#include <dynamo/schedulers/sorters/MinMaxPEL.hpp>
+#include <dynamo/inputplugins/include.hpp>
+#include <dynamo/inputplugins/compression.hpp>
+#include <dynamo/interactions/hardsphere.hpp>
+#include <dynamo/globals/cells.hpp>
+#include <dynamo/outputplugins/outputplugin.hpp>
+#include <dynamo/NparticleEventData.hpp>
+#include <magnet/xmlreader.hpp>
+#include <fstream>
+#include <random>
+
+std::mt19937 RNG(1234);
+typedef dynamo::BoundedPQFEL<dynamo::MinMaxPEL<3> > DefaultSorter;
+
+//Counts the times the cells grow, and optionally rebuilds the
+//neighbourlist and the FEL each time instead of rebinning
+class TestCells: public dynamo::GCells
+{
+public:
+  TestCells(const magnet::xml::Node& XML, dynamo::Simulation* Sim, bool rebuild):
+    GCells(XML, Sim), _rebuild(rebuild), growths(0) {}
+
+  virtual void growMaxInteractionRange(double range)
+  {
+    ++growths;
+    if (_rebuild)
+      setMaxInteractionRange(range);
+    else
+      GCells::growMaxInteractionRange(range);
+  }
+
+  bool _rebuild;
+  size_t growths;
+};
+
+//Records the particles of every pair event
+class EventRecorder: public dynamo::OutputPlugin
+{
+public:
+  EventRecorder(const dynamo::Simulation* Sim): OutputPlugin(Sim, "EventRecorder") {}
+
+  virtual void initialise() {}
+
+  virtual void eventUpdate(const dynamo::Event&, const dynamo::NEventData& data)
+  {
+    for (const dynamo::PairEventData& pdat : data.L2partChanges)
+      pairs.push_back(std::make_pair(std::min(pdat.particle1_.getParticleID(), pdat.particle2_.getParticleID()),
+				     std::max(pdat.particle1_.getParticleID(), pdat.particle2_.getParticleID())));
+  }
+
+  std::vector<std::pair<size_t, size_t> > pairs;
+};
+
+dynamo::Vector getRandVelVec()
+{
+  //See http://mathworld.wolfram.com/SpherePointPicking.html
+  std::normal_distribution<> normal_dist(0.0, (1.0 / sqrt(double(NDIM))));
+
+  dynamo::Vector tmpVec;
+  for (size_t iDim = 0; iDim < NDIM; iDim++)
+    tmpVec[iDim] = normal_dist(RNG);
+
+  return tmpVec;
+}
+
+void init(dynamo::Simulation& Sim, const double density)
+{
+  RNG.seed(1234);
+  Sim.setRandomSeed(5678);
+
+  Sim.dynamics = dynamo::shared_ptr<dynamo::Dynamics>(new dynamo::DynNewtonian(&Sim));
+  Sim.BCs = dynamo::shared_ptr<dynamo::BoundaryCondition>(new dynamo::BCPeriodic(&Sim));
+  Sim.ptrScheduler = dynamo::shared_ptr<dynamo::SNeighbourList>(new dynamo::SNeighbourList(&Sim, new DefaultSorter()));
+
+  std::unique_ptr<dynamo::UCell> packptr(new dynamo::CUFCC(std::array<long, 3>{{6,6,6}}, dynamo::Vector{1,1,1}, new dynamo::UParticle()));
+  packptr->initialise();
+  std::vector<dynamo::Vector> latticeSites(packptr->placeObjects(dynamo::Vector{0,0,0}));
+  Sim.primaryCellSize = dynamo::Vector{1,1,1};
+
+  double particleDiam = std::cbrt(density / latticeSites.size());
+  Sim.interactions.push_back(dynamo::shared_ptr<dynamo::Interaction>(new dynamo::IHardSphere(&Sim, particleDiam, 1.0, new dynamo::IDPairRangeAll(), "Bulk")));
+  Sim.addSpecies(dynamo::shared_ptr<dynamo::Species>(new dynamo::SpPoint(&Sim, new dynamo::IDRangeAll(&Sim), 1.0, "Bulk", 0)));
+  Sim.units.setUnitLength(particleDiam);
+
+  unsigned long nParticles = 0;
+  Sim.particles.reserve(latticeSites.size());
+  for (const dynamo::Vector & position : latticeSites)
+    Sim.particles.push_back(dynamo::Particle(position, getRandVelVec() * Sim.units.unitVelocity(), nParticles++));
+
+  Sim.ensemble = dynamo::Ensemble::loadEnsemble(Sim);
+
+  dynamo::InputPlugin(&Sim, "Rescaler").zeroMomentum();
+  dynamo::InputPlugin(&Sim, "Rescaler").rescaleVels(1.0);
+}
+
+void compress(dynamo::Simulation& Sim, bool rebuild)
+{
+  init(Sim, 0.1);
+
+  //Narrow cells with an overlink, so that the cells must grow
+  //several times during the compression. The neighbourlist is added
+  //by hand, so the compression fix must be added too.
+  {
+    std::ofstream of("compression_cells.xml");
+    of << "<Global Type=\"Cells\" Name=\"SchedulerNBList\" OverLink=\"2\" CellWidth=\"0.6\"><IDRange Type=\"All\"/></Global>";
+  }
+  magnet::xml::Document doc("compression_cells.xml");
+  Sim.globals.push_back(dynamo::shared_ptr<dynamo::Global>(new TestCells(doc.getNode("Global"), &Sim, rebuild)));
+
+  dynamo::shared_ptr<dynamo::IPCompression> compressPlug(new dynamo::IPCompression(&Sim, 0.1));
+  compressPlug->MakeGrowth();
+  compressPlug->CellSchedulerHack();
+  compressPlug->limitDensity(0.5);
+
+  Sim.outputPlugins.push_back(dynamo::shared_ptr<dynamo::OutputPlugin>(new EventRecorder(&Sim)));
+  Sim.endEventCount = 1000000;
+  Sim.initialise();
+  while (Sim.runSimulationStep(true)) {}
+  compressPlug->RestoreSystem();
+}
+
+BOOST_AUTO_TEST_CASE( Rebinning_Matches_Rebuild )
+{
+  dynamo::Simulation rebinned;
+  compress(rebinned, false);
+  dynamo::Simulation rebuilt;
+  compress(rebuilt, true);
+
+  //The full rebuild also reschedules the compression fix from the
+  //reinitialised FEL, which can grow the cells twice at the same
+  //time, so only the rebinned run is counted
+  BOOST_CHECK(static_cast<const TestCells&>(*rebinned.globals["SchedulerNBList"]).growths > 2);
+
+  BOOST_CHECK_CLOSE(rebinned.getNumberDensity() * rebinned.units.unitVolume(), 0.5, 0.000000001);
+  BOOST_CHECK_MESSAGE(rebinned.checkSystem() <= 1, "After compression, there are more than one invalid states in the final configuration");
+
+  //Both lists must predict every collision, so the two runs perform
+  //the same events and only differ by the rounding of the
+  //recalculated event times
+  const std::vector<std::pair<size_t, size_t> >& rebinnedEvents = rebinned.getOutputPlugin<EventRecorder>()->pairs;
+  const std::vector<std::pair<size_t, size_t> >& rebuiltEvents = rebuilt.getOutputPlugin<EventRecorder>()->pairs;
+  BOOST_REQUIRE_EQUAL(rebinnedEvents.size(), rebuiltEvents.size());
+  size_t firstDifference = 0;
+  while ((firstDifference < rebinnedEvents.size()) && (rebinnedEvents[firstDifference] == rebuiltEvents[firstDifference]))
+    ++firstDifference;
+  BOOST_CHECK_EQUAL(firstDifference, rebinnedEvents.size());
+}
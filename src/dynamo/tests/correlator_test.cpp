@@ -0,0 +1,120 @@
+#define BOOST_TEST_MODULE Correlator_test
+#include <boost/test/included/unit_test.hpp>
+#include <dynamo/simulation.hpp>
+#include <dynamo/BC/include.hpp>
+#include <dynamo/ranges/include.hpp>
+#include <dynamo/inputplugins/cells/include.hpp>
+#include <dynamo/species/point.hpp>
+#include <dynamo/dynamics/newtonian.hpp>
+#include <dynamo/schedulers/include.hpp>
+#include <dynamo/schedulers/sorters/boundedPQFEL.hpp>
+#include <dynamo/schedulers/sorters/MinMaxPEL.hpp>
+#include <dynamo/inputplugins/include.hpp>
+#include <dynamo/interactions/hardsphere.hpp>
+#include <dynamo/outputplugins/tickerproperty/msdcorrelator.hpp>
+#include <dynamo/outputplugins/tickerproperty/vacf.hpp>
+#include <random>
+
+std::mt19937 RNG(1234);
+typedef dynamo::BoundedPQFEL<dynamo::MinMaxPEL<3> > DefaultSorter;
+
+const size_t length = 10;
+
+dynamo::Vector getRandVelVec()
+{
+  //See http://mathworld.wolfram.com/SpherePointPicking.html
+  std::normal_distribution<> normal_dist(0.0, (1.0 / sqrt(double(NDIM))));
+
+  dynamo::Vector tmpVec;
+  for (size_t iDim = 0; iDim < NDIM; iDim++)
+    tmpVec[iDim] = normal_dist(RNG);
+
+  return tmpVec;
+}
+
+void init(dynamo::Simulation& Sim, const double density)
+{
+  Sim.setRandomSeed(5678);
+
+  Sim.dynamics = dynamo::shared_ptr<dynamo::Dynamics>(new dynamo::DynNewtonian(&Sim));
+  Sim.BCs = dynamo::shared_ptr<dynamo::BoundaryCondition>(new dynamo::BCPeriodic(&Sim));
+  Sim.ptrScheduler = dynamo::shared_ptr<dynamo::SNeighbourList>(new dynamo::SNeighbourList(&Sim, new DefaultSorter()));
+
+  std::unique_ptr<dynamo::UCell> packptr(new dynamo::CUFCC(std::array<long, 3>{{7,7,7}}, dynamo::Vector{1,1,1}, new dynamo::UParticle()));
+  packptr->initialise();
+  std::vector<dynamo::Vector> latticeSites(packptr->placeObjects(dynamo::Vector{0,0,0}));
+  Sim.primaryCellSize = dynamo::Vector{1,1,1};
+
+  double particleDiam = std::cbrt(density / latticeSites.size());
+  Sim.interactions.push_back(dynamo::shared_ptr<dynamo::Interaction>(new dynamo::IHardSphere(&Sim, particleDiam, 1.0, new dynamo::IDPairRangeAll(), "Bulk")));
+
+  //Two species of different masses, so that the correlators of
+  //each species differ
+  const size_t Na = latticeSites.size() / 2;
+  Sim.addSpecies(dynamo::shared_ptr<dynamo::Species>(new dynamo::SpPoint(&Sim, new dynamo::IDRangeRange(0, Na - 1), 1.0, "A", 0)));
+  Sim.addSpecies(dynamo::shared_ptr<dynamo::Species>(new dynamo::SpPoint(&Sim, new dynamo::IDRangeRange(Na, latticeSites.size() - 1), 2.0, "B", 0)));
+  Sim.units.setUnitLength(particleDiam);
+
+  unsigned long nParticles = 0;
+  Sim.particles.reserve(latticeSites.size());
+  for (const dynamo::Vector & position : latticeSites)
+    Sim.particles.push_back(dynamo::Particle(position, getRandVelVec() * Sim.units.unitVelocity(), nParticles++));
+
+  Sim.ensemble = dynamo::Ensemble::loadEnsemble(Sim);
+
+  dynamo::InputPlugin(&Sim, "Rescaler").zeroMomentum();
+  dynamo::InputPlugin(&Sim, "Rescaler").rescaleVels(1.0);
+}
+
+void run(dynamo::Simulation& Sim, std::string method)
+{
+  Sim.loadXMLfile("correlator_equil.xml");
+  Sim.setRandomSeed(5678);
+  Sim.addOutputPlugin("MSDCorrelator:Length=10,BlockLength=50,Threads=2,Method=" + method);
+  Sim.addOutputPlugin("VACF:Length=10,BlockLength=50,Threads=2,Method=" + method);
+  Sim.endEventCount = 300000;
+  Sim.initialise();
+  Sim.setTickerPeriod(0.1);
+  while (Sim.runSimulationStep()) {}
+}
+
+BOOST_AUTO_TEST_CASE( FFT_Direct_Agreement )
+{
+  {
+    dynamo::Simulation Sim;
+    init(Sim, 0.5);
+    Sim.endEventCount = 100000;
+    Sim.initialise();
+    while (Sim.runSimulationStep()) {}
+    Sim.writeXMLfile("correlator_equil.xml");
+  }
+
+  //Both methods sample the same trajectory, but from different time
+  //origins, so they only agree to within the statistical error
+  dynamo::Simulation direct;
+  run(direct, "Direct");
+  dynamo::Simulation fft;
+  run(fft, "FFT");
+
+  const dynamo::OPMSDCorrelator& directMSD = *direct.getOutputPlugin<dynamo::OPMSDCorrelator>();
+  const dynamo::OPMSDCorrelator& fftMSD = *fft.getOutputPlugin<dynamo::OPMSDCorrelator>();
+  const dynamo::OPVACF& directVACF = *direct.getOutputPlugin<dynamo::OPVACF>();
+  const dynamo::OPVACF& fftVACF = *fft.getOutputPlugin<dynamo::OPVACF>();
+
+  for (size_t species(0); species < 2; ++species)
+    {
+      BOOST_CHECK_EQUAL(directMSD.getSpeciesResult(species, 0), 0);
+      BOOST_CHECK_SMALL(fftMSD.getSpeciesResult(species, 0), 1e-10);
+
+      for (size_t step(1); step < length; ++step)
+	BOOST_CHECK_CLOSE(directMSD.getSpeciesResult(species, step), fftMSD.getSpeciesResult(species, step), 3.0);
+
+      const double v2 = directVACF.getSpeciesResult(species, 0);
+      for (size_t step(0); step < length; ++step)
+	BOOST_CHECK_SMALL(directVACF.getSpeciesResult(species, step) - fftVACF.getSpeciesResult(species, step), 0.03 * v2);
+    }
+
+  //Equipartition, the lighter species is faster
+  BOOST_CHECK_CLOSE(directVACF.getSpeciesResult(0, 0), 2 * directVACF.getSpeciesResult(1, 0), 3.0);
+  BOOST_CHECK_CLOSE(fftVACF.getSpeciesResult(0, 0), 2 * fftVACF.getSpeciesResult(1, 0), 3.0);
+}
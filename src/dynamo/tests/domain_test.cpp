@@ -0,0 +1,177 @@
+#define BOOST_TEST_MODULE Domain_test
+#include <boost/test/included/unit_test.hpp>
+#include <dynamo/simulation.hpp>
+#include <dynamo/BC/include.hpp>
+#include <dynamo/ranges/include.hpp>
+#include <dynamo/inputplugins/cells/include.hpp>
+#include <dynamo/species/point.hpp>
+#include <dynamo/dynamics/newtonian.hpp>
+#include <dynamo/schedulers/include.hpp>
+#include <dynamo/schedulers/sorters/boundedPQFEL.hpp>
+#include <dynamo/schedulers/sorters/MinMaxPEL.hpp>
+#include <dynamo/inputplugins/include.hpp>
+#include <dynamo/interactions/hardsphere.hpp>
+#include <dynamo/outputplugins/misc.hpp>
+#include <dynamo/outputplugins/msd.hpp>
+#include <dynamo/coordinator/engine/domains.hpp>
+#include <magnet/thread/threadpool.hpp>
+#include <boost/program_options.hpp>
+#include <random>
+
+std::mt19937 RNG(1234);
+typedef dynamo::BoundedPQFEL<dynamo::MinMaxPEL<3> > DefaultSorter;
+
+const unsigned int seed = 5678;
+
+//Exposes the Simulation of the engine
+class TestEngine: public dynamo::EDomainSimulation
+{
+public:
+  TestEngine(const boost::program_options::variables_map& vm, magnet::thread::ThreadPool& tp):
+    EDomainSimulation(vm, tp) {}
+
+  using EDomainSimulation::simulation;
+};
+
+dynamo::Vector getRandVelVec()
+{
+  //See http://mathworld.wolfram.com/SpherePointPicking.html
+  std::normal_distribution<> normal_dist(0.0, (1.0 / sqrt(double(NDIM))));
+
+  dynamo::Vector tmpVec;
+  for (size_t iDim = 0; iDim < NDIM; iDim++)
+    tmpVec[iDim] = normal_dist(RNG);
+
+  return tmpVec;
+}
+
+//The hard sphere fluid of hardsphere_test
+void init(dynamo::Simulation& Sim, const double density)
+{
+  Sim.setRandomSeed(seed);
+
+  Sim.dynamics = dynamo::shared_ptr<dynamo::Dynamics>(new dynamo::DynNewtonian(&Sim));
+  Sim.BCs = dynamo::shared_ptr<dynamo::BoundaryCondition>(new dynamo::BCPeriodic(&Sim));
+  Sim.ptrScheduler = dynamo::shared_ptr<dynamo::SNeighbourList>(new dynamo::SNeighbourList(&Sim, new DefaultSorter()));
+
+  std::unique_ptr<dynamo::UCell> packptr(new dynamo::CUFCC(std::array<long, 3>{{7,7,7}}, dynamo::Vector{1,1,1}, new dynamo::UParticle()));
+  packptr->initialise();
+  std::vector<dynamo::Vector> latticeSites(packptr->placeObjects(dynamo::Vector{0,0,0}));
+  Sim.primaryCellSize = dynamo::Vector{1,1,1};
+
+  double particleDiam = std::cbrt(density / latticeSites.size());
+  Sim.interactions.push_back(dynamo::shared_ptr<dynamo::Interaction>(new dynamo::IHardSphere(&Sim, particleDiam, 1.0, new dynamo::IDPairRangeAll(), "Bulk")));
+  Sim.addSpecies(dynamo::shared_ptr<dynamo::Species>(new dynamo::SpPoint(&Sim, new dynamo::IDRangeAll(&Sim), 1.0, "Bulk", 0)));
+  Sim.units.setUnitLength(particleDiam);
+
+  unsigned long nParticles = 0;
+  Sim.particles.reserve(latticeSites.size());
+  for (const dynamo::Vector & position : latticeSites)
+    Sim.particles.push_back(dynamo::Particle(position, getRandVelVec() * Sim.units.unitVelocity(), nParticles++));
+
+  Sim.ensemble = dynamo::Ensemble::loadEnsemble(Sim);
+
+  dynamo::InputPlugin(&Sim, "Rescaler").zeroMomentum();
+  dynamo::InputPlugin(&Sim, "Rescaler").rescaleVels(1.0);
+}
+
+//Parses the command line of the engine
+void parse(boost::program_options::variables_map& vm, std::vector<std::string> args)
+{
+  boost::program_options::options_description opts;
+  dynamo::Engine::getCommonOptions(opts);
+  dynamo::ESingleSimulation::getOptions(opts);
+  dynamo::EDomainSimulation::getOptions(opts);
+  opts.add_options()
+    ("config-file", boost::program_options::value<std::vector<std::string> >());
+
+  boost::program_options::store(boost::program_options::command_line_parser(args).options(opts).run(), vm);
+  boost::program_options::notify(vm);
+}
+
+BOOST_AUTO_TEST_CASE( Domains_Match_Serial_Run )
+{
+  {
+    dynamo::Simulation Sim;
+    init(Sim, 0.5);
+    Sim.writeXMLfile("domain_start.xml");
+  }
+
+  //Few enough events that the rounding differences of the domains
+  //do not grow into different trajectories
+  const size_t events = 2000;
+  dynamo::Simulation reference;
+  reference.loadXMLfile("domain_start.xml");
+  reference.endEventCount = events;
+  reference.initialise();
+  while (reference.runSimulationStep()) {}
+  reference.dynamics->updateAllParticles();
+
+  for (const std::string sync : {"optimistic", "conservative"})
+    {
+      magnet::thread::ThreadPool pool;
+      pool.setThreadCount(2);
+      boost::program_options::variables_map vm;
+      parse(vm, {"--config-file", "domain_start.xml", "-c", std::to_string(events), "--equilibrate",
+	    "--domains", "3", "--domain-ghost", "1.5", "--domain-sync", sync});
+
+      TestEngine engine(vm, pool);
+      engine.initialisation();
+      engine.runSimulation();
+
+      const dynamo::Simulation& Sim = engine.simulation;
+      BOOST_CHECK(engine.getParallelWindows() > 0);
+      BOOST_CHECK_EQUAL(Sim.eventCount, reference.eventCount);
+      BOOST_CHECK_CLOSE(double(Sim.systemTime), double(reference.systemTime), 1e-8);
+
+      Sim.dynamics->updateAllParticles();
+      BOOST_REQUIRE_EQUAL(Sim.N(), reference.N());
+      double maxDifference = 0;
+      for (size_t i(0); i < Sim.N(); ++i)
+	{
+	  dynamo::Vector difference = Sim.particles[i].getPosition() - reference.particles[i].getPosition();
+	  Sim.BCs->applyBC(difference);
+	  maxDifference = std::max(maxDifference, difference.nrm() / Sim.units.unitLength());
+	  maxDifference = std::max(maxDifference, (Sim.particles[i].getVelocity() - reference.particles[i].getVelocity()).nrm() / Sim.units.unitVelocity());
+	}
+      BOOST_CHECK_SMALL(maxDifference, 1e-8);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( Equilibrium_Simulation )
+{
+  {
+    dynamo::Simulation Sim;
+    init(Sim, 0.5);
+    Sim.endEventCount = 100000;
+    Sim.initialise();
+    while (Sim.runSimulationStep()) {}
+    Sim.writeXMLfile("domain_equil.xml");
+  }
+
+  magnet::thread::ThreadPool pool;
+  pool.setThreadCount(2);
+  boost::program_options::variables_map vm;
+  parse(vm, {"--config-file", "domain_equil.xml", "-c", "400000", "-L", "MSD", "--domains", "3", "--domain-ghost", "1.5"});
+
+  TestEngine engine(vm, pool);
+  engine.initialisation();
+  engine.runSimulation();
+  dynamo::Simulation& Sim = engine.simulation;
+
+  //As in hardsphere_test, taken from Lue 2005 DOI:10.1063/1.1834498
+  const double expectedMFT = 0.13031;
+  const double expectedD = 0.247;
+
+  //Grab the output plugins
+  dynamo::OPMisc& opMisc = *Sim.getOutputPlugin<dynamo::OPMisc>();
+  dynamo::OPMSD& opMSD = *Sim.getOutputPlugin<dynamo::OPMSD>();
+
+  BOOST_CHECK(engine.getParallelWindows() > 0);
+  BOOST_CHECK_EQUAL(Sim.eventCount, 400000);
+  BOOST_CHECK_CLOSE(opMisc.getMFT(), expectedMFT, 1);
+  BOOST_CHECK_CLOSE(opMSD.calcD(*Sim.species[0]->getRange()) / Sim.units.unitDiffusion(), expectedD, 6);
+  BOOST_CHECK_CLOSE(opMisc.getCurrentkT() / Sim.units.unitEnergy(), 1.0, 0.000000001);
+  BOOST_CHECK_SMALL(opMisc.getCurrentMomentum().nrm() / Sim.units.unitMomentum(), 0.0000000001);
+  BOOST_CHECK_MESSAGE(Sim.checkSystem() <= 1, "There are more than two invalid states in the final configuration");
+}
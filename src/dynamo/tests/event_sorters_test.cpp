@@ -80,16 +80,26 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(PEL_standard, T, PEL_types){
 #include <dynamo/schedulers/sorters/referenceFEL.hpp>
 #include <dynamo/schedulers/sorters/CBTFEL.hpp>
 #include <dynamo/schedulers/sorters/boundedPQFEL.hpp>
+#include <dynamo/schedulers/sorters/quadHeapFEL.hpp>
+#include <dynamo/schedulers/sorters/ladderFEL.hpp>
 typedef boost::mpl::list<
   dynamo::ReferenceFEL
   ,dynamo::CBTFEL<dynamo::HeapPEL>
   ,dynamo::CBTFEL<dynamo::MinMaxPEL<2> >
   ,dynamo::CBTFEL<dynamo::MinMaxPEL<5> >
   ,dynamo::CBTFEL<dynamo::MinMaxPEL<30> >
+  ,dynamo::CBTFEL<dynamo::HeapPEL, true>
+  ,dynamo::CBTFEL<dynamo::MinMaxPEL<5>, true>
   ,dynamo::BoundedPQFEL<dynamo::HeapPEL>
   ,dynamo::BoundedPQFEL<dynamo::MinMaxPEL<2> >
   ,dynamo::BoundedPQFEL<dynamo::MinMaxPEL<5> >
   ,dynamo::BoundedPQFEL<dynamo::MinMaxPEL<30> >
+  ,dynamo::QuadHeapFEL<dynamo::HeapPEL>
+  ,dynamo::QuadHeapFEL<dynamo::MinMaxPEL<2> >
+  ,dynamo::QuadHeapFEL<dynamo::MinMaxPEL<5> >
+  ,dynamo::LadderFEL<dynamo::HeapPEL>
+  ,dynamo::LadderFEL<dynamo::MinMaxPEL<2> >
+  ,dynamo::LadderFEL<dynamo::MinMaxPEL<5> >
 			 > FEL_types;
 
 #define validateEvents(e1, e2)						\
@@ -0,0 +1,250 @@
+#define BOOST_TEST_MODULE GranularBed_test
+#include <boost/test/included/unit_test.hpp>
+#include <dynamo/simulation.hpp>
+#include <dynamo/BC/include.hpp>
+#include <dynamo/ranges/include.hpp>
+#include <dynamo/species/point.hpp>
+#include <dynamo/species/fixedCollider.hpp>
+#include <dynamo/dynamics/gravity.hpp>
+#include <dynamo/schedulers/include.hpp>
+#include <dynamo/schedulers/sorters/boundedPQFEL.hpp>
+#include <dynamo/schedulers/sorters/MinMaxPEL.hpp>
+#include <dynamo/interactions/hardsphere.hpp>
+#include <dynamo/globals/cells.hpp>
+#include <dynamo/systems/sleep.hpp>
+#include <magnet/xmlreader.hpp>
+#include <fstream>
+#include <random>
+#include <algorithm>
+
+std::mt19937 RNG(1234);
+typedef dynamo::BoundedPQFEL<dynamo::MinMaxPEL<3> > DefaultSorter;
+
+const size_t events = 20000;
+const unsigned int seed = 5678;
+
+//Exposes the buried particles and counts the neighbours scanned for
+//the awake particles, and optionally disables the burial test to
+//provide a reference
+class TestCells: public dynamo::GCells
+{
+public:
+  TestCells(const magnet::xml::Node& XML, dynamo::Simulation* Sim, bool burial):
+    GCells(XML, Sim), _burial(burial), scans(0), scanned(0) {}
+
+  virtual double getBurialDiameter() const
+  { return _burial ? GCells::getBurialDiameter() : 0; }
+
+  virtual void getExposedParticleNeighbours(const dynamo::Particle& part, std::vector<size_t>& retlist) const
+  {
+    const size_t start = retlist.size();
+    GCells::getExposedParticleNeighbours(part, retlist);
+    ++scans;
+    scanned += retlist.size() - start;
+  }
+
+  size_t buriedCount() const
+  { return std::count(_buried.begin(), _buried.end(), true); }
+
+  using GCells::_buried;
+  bool _burial;
+  mutable size_t scans;
+  mutable size_t scanned;
+};
+
+//Counts the interaction events pushed between two sleeping
+//particles, or with a buried particle
+class CheckedSorter: public DefaultSorter
+{
+public:
+  CheckedSorter(const dynamo::Simulation* Sim, const TestCells* cells):
+    _Sim(Sim), _cells(cells), sleepingPairs(0), buriedPairs(0) {}
+
+  virtual void push(dynamo::Event event)
+  {
+    if ((event._source == dynamo::INTERACTION) && (event._dt != std::numeric_limits<float>::infinity()))
+      {
+	sleepingPairs += _Sim->particles[event._particle1ID].testState(dynamo::Particle::SLEEPING)
+	  && _Sim->particles[event._particle2ID].testState(dynamo::Particle::SLEEPING);
+	buriedPairs += _cells->_buried[event._particle1ID] || _cells->_buried[event._particle2ID];
+      }
+    DefaultSorter::push(event);
+  }
+
+  const dynamo::Simulation* _Sim;
+  const TestCells* _cells;
+  size_t sleepingPairs;
+  size_t buriedPairs;
+};
+
+dynamo::Vector getRandVelVec()
+{
+  //See http://mathworld.wolfram.com/SpherePointPicking.html
+  std::normal_distribution<> normal_dist(0.0, (1.0 / sqrt(double(NDIM))));
+
+  dynamo::Vector tmpVec;
+  for (size_t iDim = 0; iDim < NDIM; iDim++)
+    tmpVec[iDim] = normal_dist(RNG);
+
+  return tmpVec;
+}
+
+//Inelastic spheres poured onto a floor of fixed spheres, which come
+//to rest in a bed of sleeping particles
+void init(dynamo::Simulation& Sim)
+{
+  Sim.setRandomSeed(seed);
+
+  const size_t n = 6;
+  const size_t layers = 3;
+  const double spacing = 1.0 / n;
+  const double particleDiam = 0.99 * spacing;
+  Sim.primaryCellSize = dynamo::Vector{1,1,1};
+  Sim.units.setUnitLength(particleDiam);
+
+  Sim.dynamics = dynamo::shared_ptr<dynamo::Dynamics>(new dynamo::DynGravity(&Sim, dynamo::Vector{-particleDiam, 0, 0}, 0.05 * Sim.units.unitVelocity()));
+  Sim.BCs = dynamo::shared_ptr<dynamo::BoundaryCondition>(new dynamo::BCPeriodicExceptX(&Sim));
+  Sim.ptrScheduler = dynamo::shared_ptr<dynamo::SNeighbourList>(new dynamo::SNeighbourList(&Sim, new DefaultSorter()));
+
+  //The floor, then square layers above it shifted into the hollows of
+  //the layer below
+  for (size_t layer(0); layer <= layers; ++layer)
+    for (size_t i(0); i < n; ++i)
+      for (size_t j(0); j < n; ++j)
+	{
+	  const double shift = 0.5 * spacing * (layer % 2);
+	  const dynamo::Vector position{-0.5 + 0.5 * spacing + 0.8 * spacing * layer, -0.5 + (i + 0.5) * spacing + shift, -0.5 + (j + 0.5) * spacing + shift};
+	  Sim.particles.push_back(dynamo::Particle(position, layer ? 0.1 * getRandVelVec() * Sim.units.unitVelocity() : dynamo::Vector{0,0,0}, Sim.particles.size()));
+	}
+
+  const size_t floor = n * n;
+  Sim.interactions.push_back(dynamo::shared_ptr<dynamo::Interaction>(new dynamo::IHardSphere(&Sim, particleDiam, 0.5, new dynamo::IDPairRangeAll(), "Bulk")));
+  Sim.addSpecies(dynamo::shared_ptr<dynamo::Species>(new dynamo::SpFixedCollider(&Sim, new dynamo::IDRangeRange(0, floor - 1), "Floor", 0)));
+  Sim.addSpecies(dynamo::shared_ptr<dynamo::Species>(new dynamo::SpPoint(&Sim, new dynamo::IDRangeRange(floor, Sim.N() - 1), 1.0, "Bulk", 0)));
+  Sim.systems.push_back(dynamo::shared_ptr<dynamo::System>(new dynamo::SSleep(&Sim, "Sleep", new dynamo::IDRangeRange(floor, Sim.N() - 1), 0.05 * Sim.units.unitVelocity())));
+
+  Sim.ensemble = dynamo::Ensemble::loadEnsemble(Sim);
+}
+
+void load(dynamo::Simulation& Sim, std::string filename)
+{
+  Sim.loadXMLfile(filename);
+  Sim.setRandomSeed(seed);
+}
+
+size_t sleepingCount(const dynamo::Simulation& Sim)
+{
+  size_t count = 0;
+  for (const dynamo::Particle& part : Sim.particles)
+    count += part.testState(dynamo::Particle::SLEEPING);
+  return count;
+}
+
+//Runs until the whole bed is asleep, as there are no events left then
+void run(dynamo::Simulation& Sim)
+{
+  const size_t dynamicCount = Sim.species["Bulk"]->getCount();
+  while ((sleepingCount(Sim) < dynamicCount) && Sim.runSimulationStep()) {}
+}
+
+//Runs the bed with the checked sorter and the test cells
+void runChecked(dynamo::Simulation& Sim, bool burial)
+{
+  load(Sim, "granularbed_start.xml");
+  {
+    std::ofstream of("granularbed_cells.xml");
+    of << "<Global Type=\"Cells\" Name=\"SchedulerNBList\"><IDRange Type=\"All\"/></Global>";
+  }
+  magnet::xml::Document doc("granularbed_cells.xml");
+  TestCells* cells = new TestCells(doc.getNode("Global"), &Sim, burial);
+  Sim.globals.push_back(dynamo::shared_ptr<dynamo::Global>(cells));
+  Sim.ptrScheduler = dynamo::shared_ptr<dynamo::SNeighbourList>(new dynamo::SNeighbourList(&Sim, new CheckedSorter(&Sim, cells)));
+  Sim.endEventCount = std::numeric_limits<size_t>::max();
+  Sim.initialise();
+  run(Sim);
+}
+
+BOOST_AUTO_TEST_CASE( Buried_Particles_Are_Skipped )
+{
+  {
+    dynamo::Simulation Sim;
+    init(Sim);
+    Sim.writeXMLfile("granularbed_start.xml");
+  }
+
+  dynamo::Simulation reference;
+  runChecked(reference, false);
+  dynamo::Simulation Sim;
+  runChecked(Sim, true);
+
+  const TestCells& cells = static_cast<const TestCells&>(*Sim.globals["SchedulerNBList"]);
+  const TestCells& referenceCells = static_cast<const TestCells&>(*reference.globals["SchedulerNBList"]);
+  const CheckedSorter& sorter = static_cast<const CheckedSorter&>(*static_cast<dynamo::SNeighbourList&>(*Sim.ptrScheduler).getSorter());
+  const CheckedSorter& referenceSorter = static_cast<const CheckedSorter&>(*static_cast<dynamo::SNeighbourList&>(*reference.ptrScheduler).getSorter());
+
+  //Both beds settle completely, and the interior of the bed is buried
+  BOOST_CHECK_EQUAL(sleepingCount(reference), Sim.species["Bulk"]->getCount());
+  BOOST_CHECK_EQUAL(sleepingCount(Sim), Sim.species["Bulk"]->getCount());
+  BOOST_CHECK(cells.buriedCount() > 0);
+  BOOST_CHECK_EQUAL(referenceCells.buriedCount(), 0);
+
+  //Sleeping particles never have events with each other, and the
+  //buried particles never have events at all
+  BOOST_CHECK_EQUAL(referenceSorter.sleepingPairs, 0);
+  BOOST_CHECK_EQUAL(sorter.sleepingPairs, 0);
+  BOOST_CHECK_EQUAL(sorter.buriedPairs, 0);
+
+  //Skipping the buried particles does not change the physics, only
+  //the rounding of the chaotic collapse of the bed, so the beds take
+  //a similar number of events to settle. The awake particles scan
+  //fewer neighbours on average.
+  BOOST_CHECK_CLOSE(double(Sim.eventCount), double(reference.eventCount), 25);
+  BOOST_CHECK(cells.scanned * referenceCells.scans < referenceCells.scanned * cells.scans);
+}
+
+BOOST_AUTO_TEST_CASE( Restart_With_Sleeping_Particles )
+{
+  {
+    dynamo::Simulation Sim;
+    init(Sim);
+    Sim.writeXMLfile("granularbed_start.xml");
+  }
+
+  dynamo::Simulation reference;
+  load(reference, "granularbed_start.xml");
+  reference.endEventCount = 2 * events;
+  reference.initialise();
+  run(reference);
+
+  {
+    dynamo::Simulation Sim;
+    load(Sim, "granularbed_start.xml");
+    Sim.endEventCount = events;
+    Sim.initialise();
+    run(Sim);
+    BOOST_CHECK(sleepingCount(Sim) > 0);
+    Sim.writeCheckpoint("granularbed.bin", true);
+    Sim.writeXMLfile("granularbed_end.xml");
+  }
+
+  dynamo::Simulation restarted;
+  load(restarted, "granularbed_end.xml");
+  restarted.loadCheckpoint("granularbed.bin");
+  restarted.endEventCount = events;
+  restarted.initialise();
+  run(restarted);
+
+  BOOST_CHECK_EQUAL(reference.eventCount, restarted.eventCount);
+  BOOST_CHECK_EQUAL(reference.systemTime, restarted.systemTime);
+
+  reference.dynamics->updateAllParticles();
+  restarted.dynamics->updateAllParticles();
+
+  BOOST_REQUIRE_EQUAL(reference.N(), restarted.N());
+  size_t differences = 0;
+  for (size_t i(0); i < reference.N(); ++i)
+    differences += (reference.particles[i].getPosition() != restarted.particles[i].getPosition())
+      || (reference.particles[i].getVelocity() != restarted.particles[i].getVelocity())
+      || (reference.particles[i].testState(dynamo::Particle::SLEEPING) != restarted.particles[i].testState(dynamo::Particle::SLEEPING));
+  BOOST_CHECK_EQUAL(differences, 0);
+}
@@ -35,7 +35,7 @@ dynamo::Vector getRandVelVec()
 void init(dynamo::Simulation& Sim, const double density)
 {
   RNG.seed(std::random_device()());
-  Sim.ranGenerator.seed(std::random_device()());
+  Sim.setRandomSeed(std::random_device()());
 
   double L = std::cbrt(1372 / density);
 
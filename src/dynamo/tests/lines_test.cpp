@@ -36,7 +36,7 @@ dynamo::Vector getRandVelVec()
 void init(dynamo::Simulation& Sim, const double density)
 {
   RNG.seed(std::random_device()());
-  Sim.ranGenerator.seed(std::random_device()());
+  Sim.setRandomSeed(std::random_device()());
 
   const double elasticity = 1.0;
   const size_t N = 1000;
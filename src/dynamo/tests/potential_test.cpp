@@ -0,0 +1,94 @@
+#define BOOST_TEST_MODULE Potential_test
+#include <boost/test/included/unit_test.hpp>
+#include <dynamo/interactions/potentials/potential.hpp>
+#include <dynamo/interactions/potentials/lennard_jones.hpp>
+#include <random>
+
+//The linear search over the steps of the Potential which the
+//StepTable replaces
+size_t referenceStepID(const dynamo::Potential& potential, const double r)
+{
+  size_t retval(0);
+  if (potential.direction())
+    for (; (retval < potential.steps()) && (r > potential[retval].first); ++retval) {}
+  else
+    for (; (retval < potential.steps()) && (r < potential[retval].first); ++retval) {}
+  return retval;
+}
+
+//The step bounds and energies calculated from the Potential's step cache
+std::pair<double, double> referenceStepBounds(const dynamo::Potential& potential, const size_t ID)
+{
+  if (potential.direction())
+    return std::pair<double, double>((ID == 0) ? 0 : potential[ID - 1].first, (ID == potential.steps()) ? std::numeric_limits<float>::infinity() : potential[ID].first);
+  else
+    return std::pair<double, double>((ID == potential.steps()) ? 0 : potential[ID].first, (ID == 0) ? std::numeric_limits<float>::infinity() : potential[ID - 1].first);
+}
+
+double referenceEnergy(const dynamo::Potential& potential, const size_t ID)
+{
+  return (ID == 0) ? 0 : potential[ID - 1].second;
+}
+
+void checkPotential(const dynamo::Potential& potential, const double rmin, const double rmax)
+{
+  std::mt19937 RNG(1234);
+  std::uniform_real_distribution<> r_dist(rmin, rmax);
+
+  size_t mismatches = 0;
+  for (size_t i(0); i < 10000; ++i)
+    {
+      const double r = r_dist(RNG);
+      mismatches += (potential.calculateStepID(r) != referenceStepID(potential, r));
+    }
+  BOOST_CHECK_EQUAL(mismatches, 0);
+
+  //Separations exactly on the discontinuities
+  mismatches = 0;
+  for (size_t ID(0); ID < potential.cached_steps(); ++ID)
+    mismatches += (potential.calculateStepID(potential[ID].first) != referenceStepID(potential, potential[ID].first));
+  BOOST_CHECK_EQUAL(mismatches, 0);
+
+  //The table may have been extended by the step lookups
+  const dynamo::shared_ptr<const dynamo::Potential::StepTable> table = potential.getStepTable();
+  BOOST_CHECK(table->complete() == (table->size() == potential.steps()));
+
+  const size_t lastID = table->complete() ? table->size() : table->size() - 1;
+  for (size_t ID(0); ID <= lastID; ++ID)
+    {
+      BOOST_CHECK(table->getStepBounds(ID) == referenceStepBounds(potential, ID));
+      BOOST_CHECK(table->getStepBounds(ID) == potential.getStepBounds(ID));
+      BOOST_CHECK_EQUAL(table->getEnergy(ID), referenceEnergy(potential, ID));
+      if (ID)
+	BOOST_CHECK_EQUAL(table->getEnergyChange(ID - 1, ID), potential.getEnergyChange(ID - 1, ID));
+    }
+}
+
+BOOST_AUTO_TEST_CASE( Stepped_Right )
+{
+  std::vector<std::pair<double, double> > steps{{1.0, 1.0}, {1.3, -0.5}, {1.1, 0.25}, {2.0, 0.1}};
+  dynamo::PotentialStepped potential(steps, true);
+  checkPotential(potential, 0.5, 2.5);
+}
+
+BOOST_AUTO_TEST_CASE( Stepped_Left )
+{
+  std::vector<std::pair<double, double> > steps{{1.0, 1.0}, {1.3, -0.5}, {1.1, 0.25}, {2.0, 0.1}};
+  dynamo::PotentialStepped potential(steps, false);
+  checkPotential(potential, 0.5, 2.5);
+}
+
+BOOST_AUTO_TEST_CASE( LennardJones_Distance_Stepped )
+{
+  dynamo::PotentialLennardJones potential(1.0, 1.0, 3.0, dynamo::PotentialLennardJones::MIDPOINT, dynamo::PotentialLennardJones::DELTAR, 10);
+  checkPotential(potential, 0.5, 3.5);
+}
+
+BOOST_AUTO_TEST_CASE( LennardJones_Energy_Stepped )
+{
+  //This potential has an unbounded number of steps, so the table is
+  //extended on demand
+  dynamo::PotentialLennardJones potential(1.0, 1.0, 3.0, dynamo::PotentialLennardJones::MIDPOINT, dynamo::PotentialLennardJones::DELTAU, 10);
+  BOOST_CHECK(!potential.getStepTable()->complete());
+  checkPotential(potential, 0.8, 3.5);
+}
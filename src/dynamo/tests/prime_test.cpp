@@ -0,0 +1,105 @@
+#define BOOST_TEST_MODULE PRIME_test
+#include <boost/test/included/unit_test.hpp>
+#include <dynamo/simulation.hpp>
+#include <dynamo/BC/include.hpp>
+#include <dynamo/ranges/include.hpp>
+#include <dynamo/species/point.hpp>
+#include <dynamo/dynamics/newtonian.hpp>
+#include <dynamo/schedulers/include.hpp>
+#include <dynamo/schedulers/sorters/boundedPQFEL.hpp>
+#include <dynamo/schedulers/sorters/MinMaxPEL.hpp>
+#include <dynamo/topology/PRIME.hpp>
+#include <dynamo/interactions/PRIME.hpp>
+#include <magnet/xmlreader.hpp>
+#include <fstream>
+
+typedef dynamo::BoundedPQFEL<dynamo::MinMaxPEL<3> > DefaultSorter;
+
+//Exposes the pair parameter lookups of IPRIME for testing
+struct TestPRIME: public dynamo::IPRIME
+{
+  TestPRIME(const magnet::xml::Node& XML, dynamo::Simulation* Sim): IPRIME(XML, Sim) {}
+
+  using IPRIME::getInteractionParameters;
+  using IPRIME::calcInteractionParameters;
+  using IPRIME::_topology;
+  using IPRIME::_pairTable;
+};
+
+void init(dynamo::Simulation& Sim, const dynamo::Simulation* shareFrom = NULL)
+{
+  //Two chains, which together contain every residue type
+  {
+    std::ofstream of("prime_test.xml");
+    of << "<Test>"
+       << "<Structure Name=\"Protein\" Type=\"PRIME\">"
+       << "<Molecule StartID=\"0\" Sequence=\"ACDEFGHIKLMNPQRSTVWY\"/>"
+       << "<Molecule StartID=\"79\" Sequence=\"GAVGLK\"/>"
+       << "</Structure>"
+       << "<Interaction Type=\"PRIME\" Name=\"Backbone\" Topology=\"Protein\" HBStrength=\"1\">"
+       << "<IDPairRange Type=\"All\"/>"
+       << "</Interaction>"
+       << "</Test>";
+  }
+  const size_t N = 101;
+
+  Sim.dynamics = dynamo::shared_ptr<dynamo::Dynamics>(new dynamo::DynNewtonian(&Sim));
+  Sim.BCs = dynamo::shared_ptr<dynamo::BoundaryCondition>(new dynamo::BCPeriodic(&Sim));
+  Sim.ptrScheduler = dynamo::shared_ptr<dynamo::SNeighbourList>(new dynamo::SNeighbourList(&Sim, new DefaultSorter()));
+  Sim.primaryCellSize = dynamo::Vector{50, 50, 50};
+
+  //Place the beads on a grid, further apart than the longest
+  //interaction, so that no pairs are captured
+  for (size_t i = 0; i < N; ++i)
+    Sim.particles.push_back(dynamo::Particle(dynamo::Vector{10.0 * (i % 5), 10.0 * ((i / 5) % 5), 10.0 * (i / 25)}, dynamo::Vector{0, 0, 0}, Sim.particles.size()));
+
+  magnet::xml::Document doc("prime_test.xml");
+  const magnet::xml::Node root = doc.getNode("Test");
+  Sim.topology.push_back(dynamo::Topology::getClass(root.getNode("Structure"), &Sim, 0));
+  Sim.interactions.push_back(dynamo::shared_ptr<dynamo::Interaction>(new TestPRIME(root.getNode("Interaction"), &Sim)));
+  Sim.addSpecies(dynamo::shared_ptr<dynamo::Species>(new dynamo::SpPoint(&Sim, new dynamo::IDRangeAll(&Sim), 1.0, "Bulk", 0)));
+
+  Sim.ensemble = dynamo::Ensemble::loadEnsemble(Sim);
+  if (shareFrom)
+    Sim.shareImmutableData(*shareFrom);
+  Sim.endEventCount = 0;
+  Sim.initialise();
+}
+
+void checkPairTable(const dynamo::Simulation& Sim)
+{
+  const TestPRIME& prime = static_cast<const TestPRIME&>(*Sim.interactions[0]);
+
+  size_t mismatches = 0;
+  for (size_t ID1(0); ID1 < Sim.N(); ++ID1)
+    for (size_t ID2(0); ID2 < Sim.N(); ++ID2)
+      if (ID1 != ID2)
+	{
+	  const auto reference = prime.calcInteractionParameters(prime._topology->getBeadInfo(ID1), prime._topology->getBeadInfo(ID2));
+	  if (prime.getInteractionParameters(ID1, ID2) != reference)
+	    {
+	      ++mismatches;
+	      BOOST_TEST_MESSAGE("The parameters of the pair " << ID1 << "-" << ID2 << " do not match");
+	    }
+	}
+
+  BOOST_CHECK_EQUAL(mismatches, 0);
+}
+
+BOOST_AUTO_TEST_CASE( Pair_Table_Matches_Calculation )
+{
+  dynamo::Simulation Sim;
+  init(Sim);
+  checkPairTable(Sim);
+}
+
+BOOST_AUTO_TEST_CASE( Shared_Pair_Table_Matches_Calculation )
+{
+  dynamo::Simulation first;
+  init(first);
+  dynamo::Simulation replica;
+  init(replica, &first);
+
+  BOOST_CHECK(static_cast<const TestPRIME&>(*replica.interactions[0])._pairTable == static_cast<const TestPRIME&>(*first.interactions[0])._pairTable);
+  checkPairTable(replica);
+}
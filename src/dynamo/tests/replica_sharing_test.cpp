@@ -0,0 +1,132 @@
+#define BOOST_TEST_MODULE ReplicaSharing_test
+#include <boost/test/included/unit_test.hpp>
+#include <dynamo/simulation.hpp>
+#include <dynamo/BC/include.hpp>
+#include <dynamo/ranges/include.hpp>
+#include <dynamo/inputplugins/cells/include.hpp>
+#include <dynamo/species/point.hpp>
+#include <dynamo/dynamics/newtonian.hpp>
+#include <dynamo/schedulers/include.hpp>
+#include <dynamo/schedulers/sorters/boundedPQFEL.hpp>
+#include <dynamo/schedulers/sorters/MinMaxPEL.hpp>
+#include <dynamo/inputplugins/include.hpp>
+#include <dynamo/interactions/stepped.hpp>
+#include <dynamo/interactions/potentials/potential.hpp>
+#include <random>
+#include <thread>
+
+std::mt19937 RNG(1234);
+typedef dynamo::BoundedPQFEL<dynamo::MinMaxPEL<3> > DefaultSorter;
+
+const size_t events = 50000;
+
+dynamo::Vector getRandVelVec()
+{
+  //See http://mathworld.wolfram.com/SpherePointPicking.html
+  std::normal_distribution<> normal_dist(0.0, (1.0 / sqrt(double(NDIM))));
+
+  dynamo::Vector tmpVec;
+  for (size_t iDim = 0; iDim < NDIM; iDim++)
+    tmpVec[iDim] = normal_dist(RNG);
+
+  return tmpVec;
+}
+
+void init(dynamo::Simulation& Sim, const double density)
+{
+  Sim.setRandomSeed(5678);
+
+  Sim.dynamics = dynamo::shared_ptr<dynamo::Dynamics>(new dynamo::DynNewtonian(&Sim));
+  Sim.BCs = dynamo::shared_ptr<dynamo::BoundaryCondition>(new dynamo::BCPeriodic(&Sim));
+  Sim.ptrScheduler = dynamo::shared_ptr<dynamo::SNeighbourList>(new dynamo::SNeighbourList(&Sim, new DefaultSorter()));
+
+  std::unique_ptr<dynamo::UCell> packptr(new dynamo::CUFCC(std::array<long, 3>{{6,6,6}}, dynamo::Vector{1,1,1}, new dynamo::UParticle()));
+  packptr->initialise();
+  std::vector<dynamo::Vector> latticeSites(packptr->placeObjects(dynamo::Vector{0,0,0}));
+  Sim.primaryCellSize = dynamo::Vector{1,1,1};
+
+  double particleDiam = std::cbrt(density / latticeSites.size());
+  Sim.units.setUnitLength(particleDiam);
+
+  typedef std::pair<double,double> Step;
+  std::vector<Step> steps{Step{1.5, -0.5}, Step{1.2, -1.0}, Step{1.0, 2.0}, Step{0.8, 4.0}};
+  Sim.interactions.push_back(dynamo::shared_ptr<dynamo::Interaction>(new dynamo::IStepped(&Sim, dynamo::shared_ptr<dynamo::Potential>(new dynamo::PotentialStepped(steps, false)), new dynamo::IDPairRangeAll(), "Bulk", particleDiam, 1.0)));
+
+  const size_t Na = latticeSites.size() / 2;
+  Sim.addSpecies(dynamo::shared_ptr<dynamo::Species>(new dynamo::SpPoint(&Sim, new dynamo::IDRangeRange(0, Na - 1), 1.0, "A", 0)));
+  Sim.addSpecies(dynamo::shared_ptr<dynamo::Species>(new dynamo::SpPoint(&Sim, new dynamo::IDRangeRange(Na, latticeSites.size() - 1), 2.0, "B", 0)));
+
+  unsigned long nParticles = 0;
+  Sim.particles.reserve(latticeSites.size());
+  for (const dynamo::Vector & position : latticeSites)
+    Sim.particles.push_back(dynamo::Particle(position, getRandVelVec() * Sim.units.unitVelocity(), nParticles++));
+
+  Sim.ensemble = dynamo::Ensemble::loadEnsemble(Sim);
+
+  dynamo::InputPlugin(&Sim, "Rescaler").zeroMomentum();
+  dynamo::InputPlugin(&Sim, "Rescaler").rescaleVels(1.0);
+}
+
+void load(dynamo::Simulation& Sim)
+{
+  Sim.loadXMLfile("replica_sharing.xml");
+  Sim.setRandomSeed(5678);
+  Sim.endEventCount = events;
+}
+
+void run(dynamo::Simulation& Sim)
+{
+  while (Sim.runSimulationStep(true)) {}
+}
+
+void checkIdentical(dynamo::Simulation& Sim1, dynamo::Simulation& Sim2)
+{
+  BOOST_CHECK_EQUAL(Sim1.eventCount, Sim2.eventCount);
+  BOOST_CHECK_EQUAL(Sim1.systemTime, Sim2.systemTime);
+
+  Sim1.dynamics->updateAllParticles();
+  Sim2.dynamics->updateAllParticles();
+
+  BOOST_REQUIRE_EQUAL(Sim1.N(), Sim2.N());
+  size_t differences = 0;
+  for (size_t i(0); i < Sim1.N(); ++i)
+    differences += (Sim1.particles[i].getPosition() != Sim2.particles[i].getPosition())
+      || (Sim1.particles[i].getVelocity() != Sim2.particles[i].getVelocity());
+  BOOST_CHECK_EQUAL(differences, 0);
+}
+
+BOOST_AUTO_TEST_CASE( Shared_Replicas_Match_Unshared )
+{
+  {
+    dynamo::Simulation Sim;
+    init(Sim, 0.5);
+    Sim.writeXMLfile("replica_sharing.xml");
+  }
+
+  //The reference, which owns all of its data
+  dynamo::Simulation reference;
+  load(reference);
+  reference.initialise();
+  run(reference);
+
+  //A replica which shares the data of the first replica
+  dynamo::Simulation first;
+  load(first);
+  first.initialise();
+  dynamo::Simulation replica;
+  load(replica);
+  replica.shareImmutableData(first);
+  replica.initialise();
+
+  BOOST_CHECK(replica.species[0]->getRange() == first.species[0]->getRange());
+  BOOST_CHECK(replica.species[1]->getRange() == first.species[1]->getRange());
+  BOOST_CHECK(replica.interactions[0]->getRange() == first.interactions[0]->getRange());
+
+  //Run the replicas concurrently, as the replica exchange engine does
+  std::thread thread([&]() { run(first); });
+  run(replica);
+  thread.join();
+
+  checkIdentical(reference, first);
+  checkIdentical(reference, replica);
+}
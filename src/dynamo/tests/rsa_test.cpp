@@ -0,0 +1,67 @@
+#define BOOST_TEST_MODULE RSA_test
+#include <boost/test/included/unit_test.hpp>
+#include <dynamo/simulation.hpp>
+#include <dynamo/inputplugins/cells/include.hpp>
+#include <random>
+#include <memory>
+
+const dynamo::Vector boxDimensions{20, 20, 20};
+
+std::vector<double> getDiameters()
+{
+  //A polydisperse mixture at a packing fraction of 0.25, below the
+  //RSA jamming limit
+  std::mt19937 RNG(12345);
+  std::uniform_real_distribution<> diameter_dist(0.8, 1.2);
+  std::vector<double> diameters;
+  double volume = 0;
+  while (volume < 0.25 * boxDimensions[0] * boxDimensions[1] * boxDimensions[2])
+    {
+      diameters.push_back(diameter_dist(RNG));
+      volume += M_PI * std::pow(diameters.back(), 3) / 6.0;
+    }
+  return diameters;
+}
+
+std::vector<dynamo::Vector> pack(const std::vector<double>& diameters, size_t threads)
+{
+  std::unique_ptr<dynamo::UCell> packptr(new dynamo::CURandomSequentialAddition(diameters, boxDimensions, 42, threads, new dynamo::UParticle()));
+  packptr->initialise();
+  return packptr->placeObjects(dynamo::Vector{0,0,0});
+}
+
+BOOST_AUTO_TEST_CASE( No_Overlaps )
+{
+  const std::vector<double> diameters = getDiameters();
+  const std::vector<dynamo::Vector> positions = pack(diameters, 4);
+  BOOST_REQUIRE_EQUAL(positions.size(), diameters.size());
+
+  size_t overlaps = 0;
+  for (size_t i(0); i < positions.size(); ++i)
+    for (size_t j(i + 1); j < positions.size(); ++j)
+      {
+	dynamo::Vector rij = positions[i] - positions[j];
+	for (size_t iDim(0); iDim < NDIM; ++iDim)
+	  rij[iDim] -= boxDimensions[iDim] * std::round(rij[iDim] / boxDimensions[iDim]);
+	if (rij.nrm() < 0.5 * (diameters[i] + diameters[j]))
+	  ++overlaps;
+      }
+
+  BOOST_CHECK_EQUAL(overlaps, 0);
+}
+
+BOOST_AUTO_TEST_CASE( Thread_Count_Independence )
+{
+  const std::vector<double> diameters = getDiameters();
+  const std::vector<dynamo::Vector> serial = pack(diameters, 1);
+
+  for (size_t threads : {2, 3, 8})
+    {
+      const std::vector<dynamo::Vector> parallel = pack(diameters, threads);
+      BOOST_REQUIRE_EQUAL(parallel.size(), serial.size());
+      size_t differences = 0;
+      for (size_t i(0); i < serial.size(); ++i)
+	differences += (serial[i] != parallel[i]);
+      BOOST_CHECK_MESSAGE(differences == 0, "The packing using " << threads << " threads differs at " << differences << " positions from the serial packing");
+    }
+}
@@ -7,14 +7,19 @@
 #include <dynamo/species/point.hpp>
 #include <dynamo/dynamics/newtonian.hpp>
 #include <dynamo/schedulers/include.hpp>
-#include <dynamo/schedulers/sorters/include.hpp>
+#include <dynamo/schedulers/sorters/CBTFEL.hpp>
+#include <dynamo/schedulers/sorters/boundedPQFEL.hpp>
+#include <dynamo/schedulers/sorters/quadHeapFEL.hpp>
+#include <dynamo/schedulers/sorters/ladderFEL.hpp>
+#include <dynamo/schedulers/sorters/heapPEL.hpp>
+#include <dynamo/schedulers/sorters/MinMaxPEL.hpp>
 #include <dynamo/inputplugins/include.hpp>
 #include <dynamo/interactions/hardsphere.hpp>
 #include <dynamo/outputplugins/misc.hpp>
 #include <random>
 
 std::mt19937 RNG;
-typedef dynamo::FELBoundedPQ<dynamo::PELMinMax<3> > DefaultSorter;
+typedef dynamo::BoundedPQFEL<dynamo::MinMaxPEL<3> > DefaultSorter;
 
 template<class Scheduler, class Sorter>
 void runTest()
@@ -22,12 +27,12 @@ void runTest()
   dynamo::Simulation Sim;
 
   RNG.seed(std::random_device()());
-  Sim.ranGenerator.seed(std::random_device()());
+  Sim.setRandomSeed(std::random_device()());
 
   Sim.dynamics = dynamo::shared_ptr<dynamo::Dynamics>(new dynamo::DynNewtonian(&Sim));
   Sim.BCs = dynamo::shared_ptr<dynamo::BoundaryCondition>(new dynamo::BCPeriodic(&Sim));
   Sim.ptrScheduler = dynamo::shared_ptr<dynamo::Scheduler>(new Scheduler(&Sim, new Sorter()));
-  Sim.primaryCellSize = dynamo::Vector(11,11,11);
+  Sim.primaryCellSize = dynamo::Vector{11,11,11};
   Sim.interactions.push_back(dynamo::shared_ptr<dynamo::Interaction>(new dynamo::IHardSphere(&Sim, 1.0, 1.0, new dynamo::IDPairRangeAll(), "Bulk")));
   Sim.addSpecies(dynamo::shared_ptr<dynamo::Species>(new dynamo::SpPoint(&Sim, new dynamo::IDRangeAll(&Sim), 1.0, "Bulk", 0)));
 
@@ -55,14 +60,25 @@ void runTest()
 
 
 BOOST_AUTO_TEST_CASE( Dumb_Scheduler_CBT_Sorter )
-{ runTest<dynamo::SDumb, dynamo::FELCBT>(); }
+{ runTest<dynamo::SDumb, dynamo::CBTFEL<dynamo::HeapPEL> >(); }
 
 BOOST_AUTO_TEST_CASE( Dumb_Scheduler_BoundedPQ_Sorter )
-{ runTest<dynamo::SDumb, dynamo::FELBoundedPQ<dynamo::PELMinMax<3> > >(); }
+{ runTest<dynamo::SDumb, DefaultSorter >(); }
 
 BOOST_AUTO_TEST_CASE( Neighbourlist_Scheduler_CBT_Sorter )
-{ runTest<dynamo::SNeighbourList,dynamo::FELCBT>(); }
+{ runTest<dynamo::SNeighbourList,dynamo::CBTFEL<dynamo::HeapPEL> >(); }
 
 BOOST_AUTO_TEST_CASE( Neighbourlist_Scheduler_BoundedPQ_Sorter )
-{ runTest<dynamo::SNeighbourList, dynamo::FELBoundedPQ<dynamo::PELMinMax<3> > >(); }
+{ runTest<dynamo::SNeighbourList, DefaultSorter >(); }
 
+BOOST_AUTO_TEST_CASE( Dumb_Scheduler_QuadHeap_Sorter )
+{ runTest<dynamo::SDumb, dynamo::QuadHeapFEL<dynamo::MinMaxPEL<3> > >(); }
+
+BOOST_AUTO_TEST_CASE( Neighbourlist_Scheduler_QuadHeap_Sorter )
+{ runTest<dynamo::SNeighbourList, dynamo::QuadHeapFEL<dynamo::MinMaxPEL<3> > >(); }
+
+BOOST_AUTO_TEST_CASE( Dumb_Scheduler_Ladder_Sorter )
+{ runTest<dynamo::SDumb, dynamo::LadderFEL<dynamo::MinMaxPEL<3> > >(); }
+
+BOOST_AUTO_TEST_CASE( Neighbourlist_Scheduler_Ladder_Sorter )
+{ runTest<dynamo::SNeighbourList, dynamo::LadderFEL<dynamo::MinMaxPEL<3> > >(); }
@@ -0,0 +1,96 @@
+#define BOOST_TEST_MODULE SHCrystal_test
+#include <boost/test/included/unit_test.hpp>
+#include <dynamo/simulation.hpp>
+#include <dynamo/BC/include.hpp>
+#include <dynamo/ranges/include.hpp>
+#include <dynamo/inputplugins/cells/include.hpp>
+#include <dynamo/species/point.hpp>
+#include <dynamo/dynamics/newtonian.hpp>
+#include <dynamo/schedulers/include.hpp>
+#include <dynamo/schedulers/sorters/boundedPQFEL.hpp>
+#include <dynamo/schedulers/sorters/MinMaxPEL.hpp>
+#include <dynamo/interactions/squarewell.hpp>
+#include <dynamo/outputplugins/tickerproperty/SHcrystal.hpp>
+#include <random>
+
+typedef dynamo::BoundedPQFEL<dynamo::MinMaxPEL<3> > DefaultSorter;
+
+//The Steinhardt order parameters of a perfect FCC crystal
+const double FCC_Q4 = 0.190941;
+const double FCC_Q6 = 0.574524;
+const double FCC_W4 = -0.159317;
+const double FCC_W6 = -0.013161;
+
+void init(dynamo::Simulation& Sim, std::string method, double displacement = 0)
+{
+  Sim.dynamics = dynamo::shared_ptr<dynamo::Dynamics>(new dynamo::DynNewtonian(&Sim));
+  Sim.BCs = dynamo::shared_ptr<dynamo::BoundaryCondition>(new dynamo::BCPeriodic(&Sim));
+  Sim.ptrScheduler = dynamo::shared_ptr<dynamo::SNeighbourList>(new dynamo::SNeighbourList(&Sim, new DefaultSorter()));
+
+  std::unique_ptr<dynamo::UCell> packptr(new dynamo::CUFCC(std::array<long, 3>{{5,5,5}}, dynamo::Vector{1,1,1}, new dynamo::UParticle()));
+  packptr->initialise();
+  std::vector<dynamo::Vector> latticeSites(packptr->placeObjects(dynamo::Vector{0,0,0}));
+  Sim.primaryCellSize = dynamo::Vector{1,1,1};
+
+  //The well is wide enough for the neighbour list to cover the
+  //nearest neighbour shell, but the cut-off excludes the second
+  //shell at sqrt(2) nearest neighbour distances.
+  const double nearestNeighbour = 0.2 / std::sqrt(2.0);
+  const double particleDiam = 0.9 * nearestNeighbour;
+  Sim.interactions.push_back(dynamo::shared_ptr<dynamo::Interaction>(new dynamo::ISquareWell(&Sim, particleDiam, 1.5, 1.0, 1.0, new dynamo::IDPairRangeAll(), "Bulk")));
+  Sim.addSpecies(dynamo::shared_ptr<dynamo::Species>(new dynamo::SpPoint(&Sim, new dynamo::IDRangeAll(&Sim), 1.0, "Bulk", 0)));
+  Sim.units.setUnitLength(particleDiam);
+
+  //Optionally displace the particles off the lattice sites
+  std::mt19937 RNG(1234);
+  std::uniform_real_distribution<> displacement_dist(-displacement * nearestNeighbour, displacement * nearestNeighbour);
+  unsigned long nParticles = 0;
+  Sim.particles.reserve(latticeSites.size());
+  for (const dynamo::Vector & position : latticeSites)
+    {
+      dynamo::Vector offset;
+      for (size_t iDim(0); iDim < NDIM; ++iDim)
+	offset[iDim] = displacement_dist(RNG);
+      Sim.particles.push_back(dynamo::Particle(position + offset, dynamo::Vector{0,0,0}, nParticles++));
+    }
+
+  Sim.ensemble = dynamo::Ensemble::loadEnsemble(Sim);
+  Sim.addOutputPlugin("SHCrystal:CutOffR=1.2,MaxL=7,Threads=2,Method=" + method);
+
+  //The order parameters are sampled once on initialisation
+  Sim.endEventCount = 0;
+  Sim.initialise();
+}
+
+BOOST_AUTO_TEST_CASE( FCC_Order_Parameters )
+{
+  for (std::string method : {"Direct", "Recurrence"})
+    {
+      dynamo::Simulation Sim;
+      init(Sim, method);
+      const dynamo::OPSHCrystal& plugin = *Sim.getOutputPlugin<dynamo::OPSHCrystal>();
+
+      BOOST_CHECK_CLOSE(plugin.getQ(4), FCC_Q4, 0.001);
+      BOOST_CHECK_CLOSE(plugin.getQ(6), FCC_Q6, 0.001);
+      BOOST_CHECK_CLOSE(plugin.getW(4).real(), FCC_W4, 0.001);
+      BOOST_CHECK_CLOSE(plugin.getW(6).real(), FCC_W6, 0.005);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( Direct_Recurrence_Agreement )
+{
+  //A disordered crystal, so that none of the order parameters vanish
+  dynamo::Simulation direct;
+  init(direct, "Direct", 0.02);
+  dynamo::Simulation recurrence;
+  init(recurrence, "Recurrence", 0.02);
+
+  const dynamo::OPSHCrystal& directPlugin = *direct.getOutputPlugin<dynamo::OPSHCrystal>();
+  const dynamo::OPSHCrystal& recurrencePlugin = *recurrence.getOutputPlugin<dynamo::OPSHCrystal>();
+
+  for (size_t l(1); l < 7; ++l)
+    {
+      BOOST_CHECK_SMALL(directPlugin.getQ(l) - recurrencePlugin.getQ(l), 1e-8);
+      BOOST_CHECK_SMALL(std::abs(directPlugin.getW(l) - recurrencePlugin.getW(l)), 1e-8);
+    }
+}
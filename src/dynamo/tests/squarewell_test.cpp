@@ -34,7 +34,7 @@ dynamo::Vector getRandVelVec()
 void init(dynamo::Simulation& Sim, double density = 0.5)
 {
   RNG.seed(std::random_device()());
-  Sim.ranGenerator.seed(std::random_device()());
+  Sim.setRandomSeed(std::random_device()());
 
   const double elasticity = 1.0;
   const double lambda = 1.5;
@@ -34,7 +34,7 @@ dynamo::Vector getRandVelVec()
 void init(dynamo::Simulation& Sim)
 {
   RNG.seed(std::random_device()());
-  Sim.ranGenerator.seed(std::random_device()());
+  Sim.setRandomSeed(std::random_device()());
 
   Sim.primaryCellSize = dynamo::Vector{6.1, 10, 10};
 
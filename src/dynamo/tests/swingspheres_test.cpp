@@ -38,7 +38,7 @@ void init(dynamo::Simulation& Sim)
   double bond_elasticity = 0.9;
 
   RNG.seed(std::random_device()());
-  Sim.ranGenerator.seed(std::random_device()());
+  Sim.setRandomSeed(std::random_device()());
 
   Sim.primaryCellSize = dynamo::Vector{60, 60, 60};
 
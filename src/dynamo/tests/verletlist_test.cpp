@@ -0,0 +1,145 @@
+#define BOOST_TEST_MODULE VerletList_test
+#include <boost/test/included/unit_test.hpp>
+#include <dynamo/simulation.hpp>
+#include <dynamo/BC/include.hpp>
+#include <dynamo/ranges/include.hpp>
+#include <dynamo/inputplugins/cells/include.hpp>
+#include <dynamo/species/point.hpp>
+#include <dynamo/dynamics/newtonian.hpp>
+#include <dynamo/schedulers/include.hpp>
+#include <dynamo/schedulers/sorters/boundedPQFEL.hpp>
+#include <dynamo/schedulers/sorters/MinMaxPEL.hpp>
+#include <dynamo/inputplugins/include.hpp>
+#include <dynamo/interactions/hardsphere.hpp>
+#include <dynamo/globals/verletlist.hpp>
+#include <dynamo/outputplugins/outputplugin.hpp>
+#include <dynamo/NparticleEventData.hpp>
+#include <magnet/xmlreader.hpp>
+#include <fstream>
+#include <random>
+
+std::mt19937 RNG(1234);
+typedef dynamo::BoundedPQFEL<dynamo::MinMaxPEL<3> > DefaultSorter;
+
+const size_t events = 5000;
+
+//Records the particles of every pair event. The particles of an
+//event are in the order the pair was found, which depends on the
+//neighbour list.
+class EventRecorder: public dynamo::OutputPlugin
+{
+public:
+  EventRecorder(const dynamo::Simulation* Sim): OutputPlugin(Sim, "EventRecorder") {}
+
+  virtual void initialise() {}
+
+  virtual void eventUpdate(const dynamo::Event&, const dynamo::NEventData& data)
+  {
+    for (const dynamo::PairEventData& pdat : data.L2partChanges)
+      pairs.push_back(std::make_pair(std::min(pdat.particle1_.getParticleID(), pdat.particle2_.getParticleID()),
+				     std::max(pdat.particle1_.getParticleID(), pdat.particle2_.getParticleID())));
+  }
+
+  std::vector<std::pair<size_t, size_t> > pairs;
+};
+
+dynamo::Vector getRandVelVec()
+{
+  //See http://mathworld.wolfram.com/SpherePointPicking.html
+  std::normal_distribution<> normal_dist(0.0, (1.0 / sqrt(double(NDIM))));
+
+  dynamo::Vector tmpVec;
+  for (size_t iDim = 0; iDim < NDIM; iDim++)
+    tmpVec[iDim] = normal_dist(RNG);
+
+  return tmpVec;
+}
+
+void init(dynamo::Simulation& Sim, const double density)
+{
+  Sim.setRandomSeed(5678);
+
+  Sim.dynamics = dynamo::shared_ptr<dynamo::Dynamics>(new dynamo::DynNewtonian(&Sim));
+  Sim.BCs = dynamo::shared_ptr<dynamo::BoundaryCondition>(new dynamo::BCPeriodic(&Sim));
+  Sim.ptrScheduler = dynamo::shared_ptr<dynamo::SNeighbourList>(new dynamo::SNeighbourList(&Sim, new DefaultSorter()));
+
+  std::unique_ptr<dynamo::UCell> packptr(new dynamo::CUFCC(std::array<long, 3>{{7,7,7}}, dynamo::Vector{1,1,1}, new dynamo::UParticle()));
+  packptr->initialise();
+  std::vector<dynamo::Vector> latticeSites(packptr->placeObjects(dynamo::Vector{0,0,0}));
+  Sim.primaryCellSize = dynamo::Vector{1,1,1};
+
+  double particleDiam = std::cbrt(density / latticeSites.size());
+  Sim.interactions.push_back(dynamo::shared_ptr<dynamo::Interaction>(new dynamo::IHardSphere(&Sim, particleDiam, 1.0, new dynamo::IDPairRangeAll(), "Bulk")));
+  Sim.addSpecies(dynamo::shared_ptr<dynamo::Species>(new dynamo::SpPoint(&Sim, new dynamo::IDRangeAll(&Sim), 1.0, "Bulk", 0)));
+  Sim.units.setUnitLength(particleDiam);
+
+  unsigned long nParticles = 0;
+  Sim.particles.reserve(latticeSites.size());
+  for (const dynamo::Vector & position : latticeSites)
+    Sim.particles.push_back(dynamo::Particle(position, getRandVelVec() * Sim.units.unitVelocity(), nParticles++));
+
+  Sim.ensemble = dynamo::Ensemble::loadEnsemble(Sim);
+
+  dynamo::InputPlugin(&Sim, "Rescaler").zeroMomentum();
+  dynamo::InputPlugin(&Sim, "Rescaler").rescaleVels(1.0);
+}
+
+void run(dynamo::Simulation& Sim, bool verlet)
+{
+  Sim.loadXMLfile("verletlist_start.xml");
+  Sim.setRandomSeed(5678);
+
+  if (verlet)
+    {
+      {
+	std::ofstream of("verletlist_global.xml");
+	of << "<Global Type=\"VerletList\" Name=\"SchedulerNBList\" NeighbourhoodRange=\"1\"><IDRange Type=\"All\"/></Global>";
+      }
+      magnet::xml::Document doc("verletlist_global.xml");
+      Sim.globals.push_back(dynamo::Global::getClass(doc.getNode("Global"), &Sim));
+    }
+
+  Sim.outputPlugins.push_back(dynamo::shared_ptr<dynamo::OutputPlugin>(new EventRecorder(&Sim)));
+  Sim.endEventCount = events;
+  Sim.initialise();
+  while (Sim.runSimulationStep(true)) {}
+  Sim.dynamics->updateAllParticles();
+}
+
+BOOST_AUTO_TEST_CASE( Matches_Cells )
+{
+  {
+    dynamo::Simulation Sim;
+    init(Sim, 0.9);
+    Sim.endEventCount = 20000;
+    Sim.initialise();
+    while (Sim.runSimulationStep(true)) {}
+    Sim.writeXMLfile("verletlist_start.xml");
+  }
+
+  dynamo::Simulation cells;
+  run(cells, false);
+  dynamo::Simulation verlet;
+  run(verlet, true);
+  BOOST_REQUIRE(std::dynamic_pointer_cast<dynamo::GVerletList>(verlet.globals["SchedulerNBList"]));
+
+  //The neighbour lists only change the order in which the particles
+  //are streamed, so the trajectories only differ by rounding errors
+  const std::vector<std::pair<size_t, size_t> >& cellEvents = cells.getOutputPlugin<EventRecorder>()->pairs;
+  const std::vector<std::pair<size_t, size_t> >& verletEvents = verlet.getOutputPlugin<EventRecorder>()->pairs;
+  BOOST_REQUIRE_EQUAL(cellEvents.size(), verletEvents.size());
+  size_t firstDifference = 0;
+  while ((firstDifference < cellEvents.size()) && (cellEvents[firstDifference] == verletEvents[firstDifference]))
+    ++firstDifference;
+  BOOST_CHECK_EQUAL(firstDifference, cellEvents.size());
+
+  BOOST_CHECK_CLOSE(cells.systemTime, verlet.systemTime, 1e-8);
+  double maxDeviation = 0;
+  for (size_t i(0); i < cells.N(); ++i)
+    {
+      dynamo::Vector rij = cells.particles[i].getPosition() - verlet.particles[i].getPosition();
+      cells.BCs->applyBC(rij);
+      maxDeviation = std::max(maxDeviation, rij.nrm() / cells.units.unitLength());
+    }
+  BOOST_CHECK_SMALL(maxDeviation, 1e-8);
+}
@@ -0,0 +1,130 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <magnet/exception.hpp>
+#include <complex>
+#include <vector>
+#include <cmath>
+
+namespace magnet {
+  namespace math {
+    /*! \brief Returns the smallest power of two which is greater
+        than or equal to x.
+     */
+    inline size_t nextPow2(size_t x)
+    {
+      size_t p(1);
+      while (p < x) p <<= 1;
+      return p;
+    }
+
+    /*! \brief An in-place, radix-2 Fast Fourier Transform of a fixed
+        size.
+
+      The bit-reversal permutation and twiddle factors are calculated
+      once in the constructor, so a single FFT object can be used to
+      transform many arrays of the same size (e.g., one per particle
+      when calculating correlation functions). The transform() member
+      is const, so one FFT object can be shared between threads.
+
+      The forward transform is \f$X_k=\sum_j x_j
+      e^{-2\pi\,i\,j\,k/N}\f$ and the inverse transform includes the
+      \f$1/N\f$ normalisation.
+     */
+    class FFT
+    {
+    public:
+      typedef std::complex<double> complex;
+
+      /*! \brief Constructor.
+	\param size The length of the transforms, which must be a
+	power of two.
+       */
+      FFT(const size_t size = 1):
+	_size(size),
+	_bitReverse(size),
+	_twiddles(size / 2)
+      {
+	if (!size || (size & (size - 1)))
+	  M_throw() << "The FFT size (" << size << ") must be a power of two";
+
+	size_t bits(0);
+	while ((size_t(1) << bits) < size) ++bits;
+
+	for (size_t i(0); i < size; ++i)
+	  {
+	    size_t rev(0);
+	    for (size_t b(0); b < bits; ++b)
+	      rev |= ((i >> b) & 1) << (bits - 1 - b);
+	    _bitReverse[i] = rev;
+	  }
+
+	for (size_t i(0); i < size / 2; ++i)
+	  _twiddles[i] = std::polar(1.0, -2.0 * M_PI * double(i) / double(size));
+      }
+
+      //! \brief The length of the transforms.
+      size_t size() const { return _size; }
+
+      /*! \brief Performs the transform in-place.
+	\param data An array of size() values.
+	\param inverse If true, the (normalised) inverse transform is
+	performed.
+       */
+      void transform(complex* data, const bool inverse = false) const
+      {
+	for (size_t i(0); i < _size; ++i)
+	  if (i < _bitReverse[i])
+	    std::swap(data[i], data[_bitReverse[i]]);
+
+	for (size_t len(2); len <= _size; len <<= 1)
+	  {
+	    const size_t half = len / 2;
+	    const size_t stride = _size / len;
+	    for (size_t start(0); start < _size; start += len)
+	      for (size_t j(0); j < half; ++j)
+		{
+		  const complex w = inverse ? std::conj(_twiddles[j * stride]) : _twiddles[j * stride];
+		  const complex t = w * data[start + j + half];
+		  data[start + j + half] = data[start + j] - t;
+		  data[start + j] += t;
+		}
+	  }
+
+	if (inverse)
+	  {
+	    const double norm = 1.0 / double(_size);
+	    for (size_t i(0); i < _size; ++i)
+	      data[i] *= norm;
+	  }
+      }
+
+      void transform(std::vector<complex>& data, const bool inverse = false) const
+      {
+	if (data.size() != _size)
+	  M_throw() << "Data of length " << data.size() << " passed to an FFT of size " << _size;
+	transform(data.data(), inverse);
+      }
+
+    private:
+      size_t _size;
+      std::vector<size_t> _bitReverse;
+      std::vector<complex> _twiddles;
+    };
+  }
+}
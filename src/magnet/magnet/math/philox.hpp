@@ -0,0 +1,105 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include <limits>
+
+namespace magnet {
+  namespace math {
+    /*! \brief A counter-based random number engine (Philox4x32-10).
+
+      This is the Philox generator of Salmon et al. "Parallel random
+      numbers: as easy as 1, 2, 3" (SC11). Unlike a conventional
+      engine (e.g., std::mt19937) it carries no sequential state. The
+      output is a pure function of a 64 bit key and a 128 bit counter,
+      so any number of independent streams can be generated in any
+      order (or on any thread) and still give identical results.
+
+      Here the counter is split into a 32 bit stream ID, a 64 bit
+      event counter and a 32 bit block index. The block index is
+      incremented internally as the engine is drawn from, so a single
+      (key, stream, counter) triple provides \f$2^{34}\f$ random
+      numbers. This class satisfies the UniformRandomBitGenerator
+      concept and may be used directly with the std::*_distribution
+      classes.
+
+      \code
+      Philox4x32 rng(seed, particleID, eventCount);
+      double r = std::normal_distribution<>()(rng);
+      \endcode
+     */
+    class Philox4x32
+    {
+    public:
+      typedef uint32_t result_type;
+      typedef std::array<uint32_t, 4> ctr_type;
+      typedef std::array<uint32_t, 2> key_type;
+
+      static constexpr result_type min() { return 0; }
+      static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+      /*! \brief Construct a generator for a particular stream.
+
+	\param key The key of the generator (typically the seed).
+	\param stream The stream of the generator (e.g., a particle ID).
+	\param counter The counter of the stream (e.g., an event count).
+       */
+      Philox4x32(uint64_t key, uint32_t stream, uint64_t counter):
+	_key{{uint32_t(key), uint32_t(key >> 32)}},
+	_ctr{{0, stream, uint32_t(counter), uint32_t(counter >> 32)}},
+	_idx(4)
+      {}
+
+      result_type operator()() {
+	if (_idx == 4) {
+	  _buffer = apply(_ctr, _key);
+	  ++_ctr[0];
+	  _idx = 0;
+	}
+	return _buffer[_idx++];
+      }
+
+      void discard(unsigned long long z) {
+	for (; z; --z) operator()();
+      }
+
+      /*! \brief The raw Philox4x32-10 bijection of a counter under a key.
+       */
+      static ctr_type apply(ctr_type ctr, key_type key) {
+	for (size_t r(0); r < 10; ++r) {
+	  if (r) {
+	    key[0] += 0x9E3779B9;
+	    key[1] += 0xBB67AE85;
+	  }
+	  const uint64_t p0 = uint64_t(0xD2511F53) * ctr[0];
+	  const uint64_t p1 = uint64_t(0xCD9E8D57) * ctr[2];
+	  ctr = ctr_type{{uint32_t(p1 >> 32) ^ ctr[1] ^ key[0], uint32_t(p1),
+		uint32_t(p0 >> 32) ^ ctr[3] ^ key[1], uint32_t(p0)}};
+	}
+	return ctr;
+      }
+
+    private:
+      key_type _key;
+      ctr_type _ctr;
+      ctr_type _buffer;
+      size_t _idx;
+    };
+  }
+}
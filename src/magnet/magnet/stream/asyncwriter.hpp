@@ -0,0 +1,162 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <magnet/exception.hpp>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace magnet {
+  namespace stream {
+    /*! \brief A buffered binary file writer which performs the file
+      writes on a background thread.
+
+      Data is appended to an in-memory buffer, and once the buffer is
+      full it is handed to a writer thread while a second buffer is
+      filled. The calling thread only blocks if it fills a buffer
+      before the previous one has been written, so the memory use is
+      bounded by two buffers.
+     */
+    class AsyncFileWriter
+    {
+    public:
+      /*! \brief Constructor.
+
+	\param bufferSize The size (in bytes) at which a buffer is
+	handed to the writer thread.
+       */
+      AsyncFileWriter(size_t bufferSize = 1 << 20):
+	_bufferSize(bufferSize),
+	_pending(false),
+	_stop(false),
+	_error(false)
+      {}
+
+      ~AsyncFileWriter() {
+	try { close(); } catch (...) {}
+      }
+
+      //! \brief Opens (and truncates) a file and starts the writer thread.
+      void open(const std::string& filename) {
+	close();
+	_file.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!_file)
+	  M_throw() << "Failed to open " << filename << " for writing.";
+	_filename = filename;
+	_pending = false;
+	_stop = false;
+	_error = false;
+	_buffer.clear();
+	_buffer.reserve(_bufferSize);
+	_thread = std::thread(&AsyncFileWriter::run, this);
+      }
+
+      //! \brief Returns true if the file is open.
+      bool is_open() const { return _thread.joinable(); }
+
+      //! \brief Appends data to the buffer.
+      void write(const void* data, const size_t size) {
+	const char* ptr = static_cast<const char*>(data);
+	_buffer.insert(_buffer.end(), ptr, ptr + size);
+	if (_buffer.size() >= _bufferSize)
+	  submit();
+      }
+
+      /*! \brief Writes all buffered data to the file, and waits until
+	it is written.
+       */
+      void flush() {
+	if (!is_open()) return;
+	submit();
+	std::unique_lock<std::mutex> lock(_mutex);
+	_condition.wait(lock, [this] { return !_pending; });
+	_file.flush();
+	checkError();
+      }
+
+      //! \brief Writes all buffered data and closes the file.
+      void close() {
+	if (!is_open()) return;
+	submit();
+	{
+	  std::lock_guard<std::mutex> lock(_mutex);
+	  _stop = true;
+	}
+	_condition.notify_all();
+	_thread.join();
+	_file.close();
+	checkError();
+      }
+
+    private:
+      //! \brief Hands the current buffer to the writer thread.
+      void submit() {
+	std::unique_lock<std::mutex> lock(_mutex);
+	_condition.wait(lock, [this] { return !_pending; });
+	checkError();
+	std::swap(_buffer, _writeBuffer);
+	_buffer.clear();
+	_pending = true;
+	lock.unlock();
+	_condition.notify_all();
+      }
+
+      //! \brief The main loop of the writer thread.
+      void run() {
+	std::unique_lock<std::mutex> lock(_mutex);
+	for (;;)
+	  {
+	    _condition.wait(lock, [this] { return _pending || _stop; });
+	    if (_pending)
+	      {
+		lock.unlock();
+		_file.write(_writeBuffer.data(), _writeBuffer.size());
+		lock.lock();
+		_error = _error || !_file;
+		_pending = false;
+		_condition.notify_all();
+	      }
+	    else
+	      return;
+	  }
+      }
+
+      void checkError() {
+	if (_error)
+	  M_throw() << "Failed while writing to " << _filename << ".";
+      }
+
+      std::ofstream _file;
+      std::string _filename;
+      std::thread _thread;
+      std::mutex _mutex;
+      std::condition_variable _condition;
+      //! The buffer being filled by the calling thread.
+      std::vector<char> _buffer;
+      //! The buffer being written by the writer thread.
+      std::vector<char> _writeBuffer;
+      size_t _bufferSize;
+      bool _pending;
+      bool _stop;
+      bool _error;
+    };
+  }
+}
@@ -18,6 +18,10 @@
 #pragma once
 #include <iostream>
 #include <chrono>
+#include <cstdint>
+#if defined(__x86_64__) || defined(__i386__)
+# include <x86intrin.h>
+#endif
 
 namespace magnet {
   /*! \brief A class to aid in timing the execution of commands.
@@ -62,4 +66,22 @@ namespace magnet {
     size_t _count = 0;
     std::string _text;
   };
+
+  /*! \brief A very cheap, monotonically increasing tick counter.
+
+    On x86 processors this reads the time stamp counter directly,
+    which costs only a few tens of cycles and is suitable for
+    instrumenting tight loops. On other architectures it falls back to
+    the nanosecond count of std::chrono::steady_clock. The tick rate
+    is not known in advance, so tick counts must be calibrated against
+    a wall clock (e.g., the Timer class) over a long interval to
+    obtain a duration.
+  */
+  inline uint64_t cputicks() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+  }
 }
@@ -144,6 +144,9 @@ namespace magnet {
       //! \brief Returns the underlying output stream.
       inline std::ostream& getUnderlyingStream() { return s; }
 
+      //! \brief Returns the XML written so far as a string.
+      inline std::string str() const { return s.str(); }
+
       /*! \brief Enables or disables automatic formatting of the
         outputted XML.
        */
@@ -250,5 +253,19 @@ namespace magnet {
     inline const XmlStream::Controller chardata() {
       return XmlStream::Controller(XmlStream::Controller::CharData);
     }
+
+    /*! \brief Returns the XML representation of an object as a
+      string.
+
+      The object is written inside a tag named \p tag_name, so objects
+      which only write attributes may also be converted. This is useful
+      to test if two objects have an identical configuration.
+     */
+    template<class T>
+    inline std::string toXMLString(const T& obj, const std::string& tag_name = "Object") {
+      XmlStream XML;
+      XML << tag(tag_name) << obj << endtag(tag_name);
+      return XML.str();
+    }
   }
 }
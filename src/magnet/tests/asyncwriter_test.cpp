@@ -0,0 +1,38 @@
+#define BOOST_TEST_MODULE AsyncFileWriter_test
+#include <boost/test/included/unit_test.hpp>
+#include <magnet/stream/asyncwriter.hpp>
+#include <fstream>
+#include <iterator>
+#include <cstdio>
+
+BOOST_AUTO_TEST_CASE( AsyncFileWriter_contents )
+{
+  const std::string filename = "asyncwriter_test.bin";
+  std::vector<char> expected;
+  {
+    //Use a tiny buffer to force many hand-offs to the writer thread
+    magnet::stream::AsyncFileWriter writer(64);
+    writer.open(filename);
+    for (size_t i(0); i < 10000; ++i)
+      {
+	const uint32_t value = i * 2654435761u;
+	writer.write(&value, sizeof(value));
+	const char* ptr = reinterpret_cast<const char*>(&value);
+	expected.insert(expected.end(), ptr, ptr + sizeof(value));
+
+	//Check a flush in the middle of writing leaves everything on disk
+	if (i == 5000)
+	  {
+	    writer.flush();
+	    std::ifstream is(filename, std::ios::binary);
+	    std::vector<char> data((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+	    BOOST_CHECK(data == expected);
+	  }
+      }
+  }
+
+  std::ifstream is(filename, std::ios::binary);
+  std::vector<char> data((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+  BOOST_CHECK(data == expected);
+  std::remove(filename.c_str());
+}
@@ -0,0 +1,79 @@
+#define BOOST_TEST_MODULE FFT_test
+#include <boost/test/included/unit_test.hpp>
+#include <magnet/math/fft.hpp>
+#include <random>
+
+using namespace magnet::math;
+
+BOOST_AUTO_TEST_CASE( FFT_nextPow2 )
+{
+  BOOST_CHECK_EQUAL(nextPow2(0), 1u);
+  BOOST_CHECK_EQUAL(nextPow2(1), 1u);
+  BOOST_CHECK_EQUAL(nextPow2(5), 8u);
+  BOOST_CHECK_EQUAL(nextPow2(64), 64u);
+  BOOST_CHECK_EQUAL(nextPow2(65), 128u);
+  BOOST_CHECK_THROW(FFT(12), magnet::exception);
+}
+
+BOOST_AUTO_TEST_CASE( FFT_vs_DFT )
+{
+  std::mt19937 RNG(12);
+  std::uniform_real_distribution<double> dist(-1, 1);
+
+  for (size_t N : {1, 2, 4, 32, 256})
+    {
+      std::vector<FFT::complex> data(N);
+      for (auto& val : data)
+	val = FFT::complex(dist(RNG), dist(RNG));
+      const std::vector<FFT::complex> original = data;
+
+      FFT fft(N);
+      fft.transform(data);
+
+      //Compare against a direct discrete Fourier transform
+      for (size_t k(0); k < N; ++k)
+	{
+	  FFT::complex sum(0, 0);
+	  for (size_t j(0); j < N; ++j)
+	    sum += original[j] * std::polar(1.0, -2.0 * M_PI * double(j * k) / double(N));
+	  BOOST_CHECK_SMALL(std::abs(sum - data[k]), 1e-10);
+	}
+
+      //The inverse transform must recover the original data
+      fft.transform(data, true);
+      for (size_t j(0); j < N; ++j)
+	BOOST_CHECK_SMALL(std::abs(data[j] - original[j]), 1e-12);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( FFT_autocorrelation )
+{
+  //The Wiener-Khinchin theorem with zero padding gives the linear
+  //(non-circular) autocorrelation of a series
+  std::mt19937 RNG(3);
+  std::uniform_real_distribution<double> dist(-1, 1);
+
+  const size_t T = 100;
+  std::vector<double> series(T);
+  for (double& val : series)
+    val = dist(RNG);
+
+  FFT fft(nextPow2(2 * T));
+  std::vector<FFT::complex> data(fft.size(), FFT::complex(0, 0));
+  for (size_t i(0); i < T; ++i)
+    data[i] = series[i];
+
+  fft.transform(data);
+  for (auto& val : data)
+    val = std::norm(val);
+  fft.transform(data, true);
+
+  for (size_t m(0); m < T; ++m)
+    {
+      double sum(0);
+      for (size_t k(0); k + m < T; ++k)
+	sum += series[k] * series[k + m];
+      BOOST_CHECK_SMALL(data[m].real() - sum, 1e-10);
+      BOOST_CHECK_SMALL(data[m].imag(), 1e-10);
+    }
+}
@@ -0,0 +1,73 @@
+#define BOOST_TEST_MODULE Philox_test
+#include <boost/test/included/unit_test.hpp>
+#include <magnet/math/philox.hpp>
+#include <random>
+
+using namespace magnet::math;
+
+BOOST_AUTO_TEST_CASE( Philox_known_answers )
+{
+  //Known answer tests from the Random123 distribution
+  {
+    Philox4x32::ctr_type out = Philox4x32::apply(Philox4x32::ctr_type{{0, 0, 0, 0}}, Philox4x32::key_type{{0, 0}});
+    BOOST_CHECK_EQUAL(out[0], 0x6627e8d5u);
+    BOOST_CHECK_EQUAL(out[1], 0xe169c58du);
+    BOOST_CHECK_EQUAL(out[2], 0xbc57ac4cu);
+    BOOST_CHECK_EQUAL(out[3], 0x9b00dbd8u);
+  }
+
+  {
+    Philox4x32::ctr_type out = Philox4x32::apply(Philox4x32::ctr_type{{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}}, Philox4x32::key_type{{0xffffffff, 0xffffffff}});
+    BOOST_CHECK_EQUAL(out[0], 0x408f276du);
+    BOOST_CHECK_EQUAL(out[1], 0x41c83b0eu);
+    BOOST_CHECK_EQUAL(out[2], 0xa20bc7c6u);
+    BOOST_CHECK_EQUAL(out[3], 0x6d5451fdu);
+  }
+
+  {
+    Philox4x32::ctr_type out = Philox4x32::apply(Philox4x32::ctr_type{{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}}, Philox4x32::key_type{{0xa4093822, 0x299f31d0}});
+    BOOST_CHECK_EQUAL(out[0], 0xd16cfe09u);
+    BOOST_CHECK_EQUAL(out[1], 0x94fdccebu);
+    BOOST_CHECK_EQUAL(out[2], 0x5001e420u);
+    BOOST_CHECK_EQUAL(out[3], 0x24126ea1u);
+  }
+}
+
+BOOST_AUTO_TEST_CASE( Philox_streams )
+{
+  //Generators with the same key/stream/counter are identical, no
+  //matter what order they are created/used in.
+  Philox4x32 rng1(12345, 7, 100);
+  Philox4x32 rngOther(12345, 8, 100);
+  rngOther();
+  Philox4x32 rng2(12345, 7, 100);
+  for (size_t i(0); i < 100; ++i)
+    BOOST_CHECK_EQUAL(rng1(), rng2());
+
+  //Different streams and counters give different sequences
+  Philox4x32 rng3(12345, 7, 100), rng4(12345, 8, 100), rng5(12345, 7, 101);
+  size_t matches = 0;
+  for (size_t i(0); i < 100; ++i)
+    {
+      const uint32_t a = rng3(), b = rng4(), c = rng5();
+      matches += (a == b) + (a == c);
+    }
+  BOOST_CHECK(matches == 0);
+}
+
+BOOST_AUTO_TEST_CASE( Philox_distribution )
+{
+  //Check that it produces a reasonable uniform distribution through
+  //the standard library adaptors.
+  const size_t N = 100000;
+  double sum = 0, sum2 = 0;
+  for (size_t i(0); i < N; ++i)
+    {
+      Philox4x32 rng(42, i, 0);
+      const double val = std::uniform_real_distribution<>()(rng);
+      sum += val;
+      sum2 += val * val;
+    }
+  BOOST_CHECK_CLOSE(sum / N, 0.5, 1);
+  BOOST_CHECK_CLOSE(sum2 / N - (sum / N) * (sum / N), 1.0 / 12.0, 2);
+}